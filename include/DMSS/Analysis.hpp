@@ -16,6 +16,10 @@
 #include <TGraphAsymmErrors.h>
 #include <TPaveText.h>
 
+#include <array>
+#include <functional>
+#include <memory>
+
 // CONFIND
 #include <Confind/ContourFinder.hpp>
 
@@ -24,6 +28,11 @@
 
 #include "DMSS/Model.hpp"
 #include "DMSS/SatBundle.hpp"
+#include "DMSS/Checkpoint.hpp"
+#include "DMSS/GridTable.hpp"
+#include "DMSS/Shard.hpp"
+#include "DMSS/FitSeed.hpp"
+#include "DMSS/FitCache.hpp"
 
 //==============================================================
 class Analysis : public Prog
@@ -37,9 +46,15 @@ class Analysis : public Prog
     // Copy constructor
     Analysis(const Analysis&) ;
 
+    // Move constructor
+    Analysis(Analysis&&) noexcept ;
+
     // Assignment operator
     Analysis& operator=(const Analysis&) ;
 
+    // Move assignment operator
+    Analysis& operator=(Analysis&&) noexcept ;
+
     // Destructor
     ~Analysis() ;
 
@@ -59,6 +74,11 @@ class Analysis : public Prog
     /// Sets the bin periods
     void SetBinPeriod(const size_t& sat_idx, const std::vector<int>&) ;
 
+    /// Sets the time bin edges (in days) of each energy bin, which
+    ///  replace its period (see 'Satellite::ExposureEdges' &
+    ///  'Satellite::InfoEdges')
+    void SetBinEdges(const size_t& sat_idx, const std::vector<std::vector<double>>&) ;
+
     /// Sets the energy cut
     void SetECut(double) ;
 
@@ -67,6 +87,18 @@ class Analysis : public Prog
 
     /// Sets the plot mode
     void SetPlotMode(const PlotMode&) ;
+
+    /// Records the finished fits & scans into a checkpoint file,
+    ///  and skips the ones recorded there before, if 'resume' is true
+    void SetCheckpoint(const Zaki::String::Directory&, const bool resume=false) ;
+
+    /// Runs only a part of 'DoBoost' & 'PlotParamSpaceThresh': shard 'index'
+    ///  of 'count', with the grid of each contour plane split into 'tiles' 
+    ///  (default: 'count') tiles. Replaces the checkpoint with the shard's own.
+    void SetShard(const size_t& index, const size_t& count, const size_t& tiles=0) ;
+
+    /// Combines the results of the 'count' shards, and makes the contours
+    void SetShardMerge(const size_t& count, const size_t& tiles=0) ;
     // ....................................
 
     // ....................................
@@ -86,6 +118,52 @@ class Analysis : public Prog
 
     /// Gets the boosted limit fit results
     double GetBoostLimit() const ;
+
+    /// Expected limit of a bin: the median, and the ±1σ, ±2σ bands
+    struct ExpectedLimit
+    {
+      double e_bin ;
+      int bin_period ;
+      /// -2σ, -1σ, median, +1σ, +2σ
+      std::array<double, 5> band ;
+    };
+
+    /// Gets the expected (Asimov) threshold limits
+    std::vector<ExpectedLimit> GetExpectedLimits() const ;
+
+    /// CLs limit of a bin, and its profile-likelihood limit
+    struct CLsResult
+    {
+      double e_bin ;
+      int bin_period ;
+      double limit, wilks_limit ;
+      size_t n_toys ;
+    };
+
+    /// Gets the CLs threshold limits
+    std::vector<CLsResult> GetCLsLimits() const ;
+
+    /// Number of the toys per hypothesis of the CLs limits, at
+    ///  first and at most (near the crossing)
+    void SetCLsToys(const size_t& n_min, const size_t& n_max) ;
+
+    /// Base seed of the CLs toys (each bin's toys also depend on
+    ///  the satellite and the bin)
+    void SetCLsSeed(const uint64_t&) ;
+
+    /// Scales the background hypothesis of the Asimov dataset
+    ///  (1: the background-only fit of the data)
+    void SetAsimovBgScale(const double&) ;
+
+    /// The likelihood scans find the 95% limits with the 1-D
+    ///  profile-likelihood solver, instead of contouring the
+    ///  (mu, bg) grid (no likelihood plots are made)
+    void SetFastLimits(const bool) ;
+
+    /// The threshold (boosted) fits of 'len' neighbouring bins
+    ///  (masses) are chained: each fit starts from the previous
+    ///  one's minimum (1: every fit starts from the defaults)
+    void SetFitChain(const size_t& len) ;
     // ....................................
 
     // ....................................
@@ -112,6 +190,7 @@ class Analysis : public Prog
     
     /// If the limits are already found and you just want to plot the 
     /// contours in the model's parameter space, set the bypass flag to true
+    /// (the grid values stored in '<sat>/Grids' are also reused)
     void PlotParamSpaceThresh(const size_t& sat_idx, const bool bypass=false) ;
     void PlotParamSpaceBoost(const size_t& sat_idx, const bool bypass=false) ;
 
@@ -124,13 +203,39 @@ class Analysis : public Prog
     /// Fits an individual bin
     void FitBin(Bin, const size_t&) ;
 
+    /// Finds the expected threshold limits, without toys: each bin
+    ///  is fitted once to its Asimov dataset (the median counts of 
+    ///  the background hypothesis), and the bands follow from the
+    ///  asymptotic formulae. The bins are the same as 'FitThreshold'.
+    void FitThreshAsimov(const size_t& sat_idx, std::vector<size_t>* = nullptr) ;
+
+    /// Finds the CLs threshold limits from toys of the profile-
+    ///  likelihood ratio (see 'CLsLimit'), with the bins of
+    ///  'FitThreshold'. The bins run in parallel, and so do the
+    ///  toys of each bin.
+    void FitThreshCLs(const size_t& sat_idx, std::vector<size_t>* = nullptr) ;
+
+    /// Chooses the bin period of each energy bin, among the
+    ///  'candidates', by the best expected (Asimov) limit, and sets
+    ///  them. The periods whose asymptotic error on mu is above
+    ///  'prune_ratio' times the best one are dominated, and aren't
+    ///  fitted. The other (bin, period) pairs are fitted in parallel.
+    ///  Any variable-width time bins are dropped.
+    std::vector<int> OptimizeBinPeriods(const size_t& sat_idx,
+                                        const std::vector<int>& candidates,
+                                        const double& prune_ratio=1.5) ;
+
+    /// Scans the likelihood of all the satellite's bins in parallel
+    ///  (results are in the bin order)
+    std::vector<std::vector<double>> ScanParThreshAll(const size_t& sat_idx) ;
+
     /// Performs the boosted limit fit
     void FitBoosted(Zaki::Math::Range<double>);
 
     /// Creates the histograms of fitting each bin (called from 'FitBin')
     double Histgen(const size_t&, 
-                   ROOT::Minuit2::MinosError, 
-                   ROOT::Minuit2::MinosError, Bin, TH1F);
+                   MinosResult, 
+                   MinosResult, Bin, TH1F);
 
     // Do analysis
     /// Performs the threshold analysis (Minuit)
@@ -153,6 +258,13 @@ class Analysis : public Prog
 
     /// Performs the boosted analysis
     void DoBoost(Zaki::Math::Grid2D* = nullptr)  ; // Boosted
+
+    /// The result tables (and grid planes) that a step, e.g.
+    ///  "FitThreshAsimov", writes for the model; a shard only
+    ///  writes its marker (the plots & contours aren't included)
+    std::vector<Zaki::String::Directory> ResultFiles(const std::string& step,
+                                                     const size_t& sat_idx,
+                                                     const Model&) ;
     
     /// Function for plotting contours
     /// Not to be confused with the same method in 'Model'.
@@ -176,7 +288,6 @@ class Analysis : public Prog
     bool assign_op_called  = false ;
 
     PlotMode plot_mode = PlotMode::Ldec_Gann ;
-    TH1F sig_shape_hist         ;
     std::vector<Bin> focus_bins ;
 
     /// The confidence level for contour plots:
@@ -186,7 +297,19 @@ class Analysis : public Prog
     std::vector<double> thresh_limits_true ;
     std::vector<double> e_bins    ;
     std::vector<int> focus_bin_periods  ;
-    std::vector<ROOT::Minuit2::MinosError> boost_fit_results ;
+
+    /// Expected (Asimov) threshold limits
+    std::vector<ExpectedLimit> expected_limits ;
+    double asimov_bg_scale = 1 ;
+
+    bool fast_limits = false ;
+    size_t fit_chain = 1 ;
+
+    /// CLs threshold limits
+    std::vector<CLsResult> cls_limits ;
+    size_t cls_toys_min = 500, cls_toys_max = 8000 ;
+    uint64_t cls_seed = 0 ;
+    std::vector<MinosResult> boost_fit_results ;
     double boost_fit_val ; 
     double e_cut_val = 50 ; // 50 GeV
 
@@ -195,7 +318,165 @@ class Analysis : public Prog
 
     std::shared_ptr<Model> modelPtr = nullptr ;
 
+    /// Finished units of work (shared by the copies)
+    std::shared_ptr<Checkpoint> checkpoint = nullptr ;
+
     void ResetContainers() ;
+
+    /// The key of a unit of work in the checkpoint file
+    std::string UnitKey(const std::string& unit) ;
+
+    // ....................................
+    //   Sharded campaigns
+    // ....................................
+    Shard shard ;
+
+    /// Grid values of the current contour plane, imported 
+    ///  from the shards' tiles or the grid store (used instead
+    ///  of the model)
+    std::shared_ptr<GridTable> grid_table = nullptr ;
+
+    /// Directory of the shard files
+    Zaki::String::Directory ShardDir() const ;
+
+    /// Exits if any shard hasn't finished the campaign
+    void CheckShards(const std::string& campaign) const ;
+
+    /// Marks the campaign as finished by this shard
+    void FinishShard(const std::string& campaign) const ;
+
+    /// Returns if a unit is left to another shard, 
+    ///  exits if none of the shards did it (when merging)
+    bool ShardSkips(const size_t& unit, const std::string& key) const ;
+
+    /// Evaluates this shard's tiles of a contour plane, 
+    ///  or imports all of them when merging
+    void ShardPlane(const std::string& plane, const size_t& unit,
+                    const Zaki::Math::Grid2D&, double (Analysis::*)(double, double)) ;
+
+    /// Evaluates a contour plane and stores its values in
+    ///  '<dir>/Grids', or reads them back if 'reuse' is true,
+    ///  so the contours can be found again at any level
+    void StorePlane(const std::string& dir, const std::string& plane,
+                    const Zaki::Math::Grid2D&, double (Analysis::*)(double, double),
+                    const bool reuse) ;
+    // ....................................
+
+    // ....................................
+    //   Parallel per-bin driver
+    // ....................................
+    /// A time-binned energy bin with its fixed signal shape
+    struct ThreshTask
+    {
+      size_t pos ;          // position in the input list
+      size_t b_idx, t_idx ;
+      Bin bin ;
+      TH1F sig_shape ;
+    };
+
+    /// Minos results of a threshold fit
+    struct ThreshFit
+    {
+      MinosResult e0, e1 ;
+      std::string summary ;
+
+      /// The minimum, to start the next bin's fit from
+      FitSeed seed ;
+    };
+
+    /// Time-bins the (b_idx, t_idx) pairs in windows (serially, since
+    ///  it changes the satellite's state), runs 'work' on each window
+    ///  in parallel, then runs 'finish' on each task in order.
+    ///  The tasks of a chain ('chain_len' consecutive tasks) 
+    ///  run 'work' in order.
+    void RunThreshTasks(const size_t& sat_idx,
+                        const std::vector<std::pair<size_t, size_t>>& idx,
+                        const std::function<void(ThreshTask&)>& work,
+                        const std::function<void(ThreshTask&)>& finish,
+                        const size_t& chain_len=1) ;
+
+    /// Fits a single bin (thread-safe, no members are changed),
+    ///  starting from the seed's minimum if there is one
+    ThreshFit FitBinMinos(const Bin&, const TH1F&, const FitSeed* = nullptr) const ;
+
+    /// Adds the inputs of a bin's likelihood to the key of a fit
+    static void AddFitInputs(FitCache::Key&, const Bin&, const TH1F&) ;
+
+    /// Fits the Asimov dataset of a single bin (thread-safe)
+    ExpectedLimit FitBinAsimov(const Bin&, const TH1F&) const ;
+
+    /// The CLs limit of a single bin (thread-safe)
+    CLsResult FitBinCLs(const Bin&, const TH1F&, const uint64_t& seed) const ;
+
+    /// Plots and stores the result of a threshold fit
+    void StoreBinFit(const size_t& sat_idx, const Bin&, const TH1F&,
+                     const ThreshFit&) ;
+
+    /// Scans the likelihood of a single time-binned bin
+    std::vector<double> ScanBinThresh(const ThreshTask&, const size_t& sat_idx) ;
+
+    // ....................................
+    //   Parallel DM mass sweep
+    // ....................................
+    /// A time-binned energy bin with its signal shape
+    ///  (these don't depend on the DM mass)
+    struct BoostBin
+    {
+      size_t sat_j, b_idx ;
+      int period ;
+      Bin bin ;
+      TH1F sig_shape ;
+    };
+
+    /// The time-binned bins of a set of satellites
+    struct BoostSet
+    {
+      std::vector<BoostBin> bins ;
+      double mean_scale_factor = 0 ;
+      double mean_exposure = 0 ;
+    };
+
+    /// Results of a boosted fit for a single DM mass
+    struct BoostFit
+    {
+      std::vector<Bin> bins ;
+      std::vector<int> periods ;
+      std::vector<MinosResult> results ;
+      double val = 0 ;
+      std::string summary ;
+
+      /// The minimum, to start the next mass's fit from
+      FitSeed seed ;
+
+      /// Only 'val' is set for the fits resumed from a checkpoint
+      bool resumed = false ;
+    };
+
+    /// Creates the directory for the boosted fit results
+    bool MakeBoostFitDir() ;
+
+    /// Time-bins the bins of the input satellites 
+    ///  (all of them if empty)
+    BoostSet PrepBoostSet(std::vector<size_t> sat_set = {}) ;
+
+    /// Runs 'work' for every DM mass in the model's mass set
+    ///  in parallel, each mass with its own copy of the model
+    ///  (the masses of a chain of 'chain_len' run in order)
+    void SweepDMMass(const std::function<void(size_t, Model&)>& work,
+                     const size_t& chain_len=1) ;
+
+    /// Boosted fit for the model's DM mass 
+    ///  (thread-safe, no members are changed),
+    ///  starting from the seed's minimum if there is one
+    BoostFit FitBoostedMass(const BoostSet&, Model&, 
+                            const Zaki::Math::Range<double>&,
+                            const FitSeed* = nullptr) const ;
+
+    /// Stores the result of a boosted fit
+    void StoreBoostFit(BoostFit&&) ;
+
+    /// Scans the likelihood of the boosted case for the model's DM mass
+    std::vector<double> ScanBoostMass(const BoostSet&, Model&, const size_t& sat_idx) ;
 };
 
 //==============================================================
@@ -0,0 +1,99 @@
+#ifndef DMSS_AsyncLog_H
+#define DMSS_AsyncLog_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <Zaki/Util/Logger.hpp>
+
+//==============================================================
+// Compile-time minimum level:
+//  0: errors only, 1: + warnings, 2: + info, 3: + notes
+//  Calls below this level compile to nothing (the message
+//  expression isn't even evaluated).
+#ifndef DMSS_LOG_MIN_LEVEL
+  #define DMSS_LOG_MIN_LEVEL 3
+#endif
+
+// Per call-site rate limit: at most this many messages per second
+//  (errors aren't limited)
+#ifndef DMSS_LOG_RATE_LIMIT
+  #define DMSS_LOG_RATE_LIMIT 10
+#endif
+
+//==============================================================
+/// Rate-limiting state of a single logging call site
+struct LogCallSite
+{
+  std::atomic<int64_t>  window_start = 0 ;
+  std::atomic<uint32_t> window_count = 0 ;
+  std::atomic<uint32_t> suppressed   = 0 ;
+
+  /// Returns if a message may be logged now; the number of
+  ///  messages suppressed since the last allowed one is
+  ///  returned through the argument.
+  bool Allow(uint32_t& dropped) ;
+};
+
+//==============================================================
+/// Asynchronous logging backend.
+///  Every thread pushes entries into its own single-producer
+///  ring buffer (no locks); a background thread drains them
+///  into Zaki's LogManager. Errors are flushed right away,
+///  since they are usually followed by an exit, and they are
+///  written directly if their queue is full.
+class AsyncLog
+{
+  //--------------------------------------------------------------
+  public:
+    /// Queues a message
+    static void Push(Zaki::Util::LogLevel, std::string&& msg, int line,
+                     const char* func, const char* file) ;
+
+    /// Blocks until every queued message is written
+    static void Flush() ;
+
+    /// printf-style formatting helper for log messages
+    static std::string Format(const char* fmt, ...)
+#if defined(__GNUC__)
+      __attribute__((format(printf, 1, 2)))
+#endif
+      ;
+
+    /// Messages dropped because a queue was full
+    ///  (they are reported as a warning when the queues are drained)
+    static size_t Dropped() ;
+
+  //--------------------------------------------------------------
+  private:
+    AsyncLog() = delete ;
+};
+
+//==============================================================
+//                     Logging macros
+#define DMSS_LOG_HIDDEN(MSG, LEVEL, LVL_NUM)                              \
+  do {                                                                    \
+    if constexpr ((LVL_NUM) <= DMSS_LOG_MIN_LEVEL)                        \
+    {                                                                     \
+      static LogCallSite dmss_log_site ;                                  \
+      uint32_t dmss_log_dropped = 0 ;                                     \
+      if ((LVL_NUM) == 0 || dmss_log_site.Allow(dmss_log_dropped))        \
+      {                                                                   \
+        std::string dmss_log_msg(MSG) ;                                   \
+        if (dmss_log_dropped)                                             \
+          dmss_log_msg += " [" + std::to_string(dmss_log_dropped)         \
+                          + " similar message(s) suppressed]" ;           \
+        AsyncLog::Push(LEVEL, std::move(dmss_log_msg), __LINE__,          \
+                       __func__, __FILENAME__) ;                          \
+      }                                                                   \
+    }                                                                     \
+  } while (0)
+
+#define DMSS_LOG_ERROR(MSG)   DMSS_LOG_HIDDEN(MSG, Zaki::Util::LogLevel::Error, 0)
+#define DMSS_LOG_WARNING(MSG) DMSS_LOG_HIDDEN(MSG, Zaki::Util::LogLevel::Warning, 1)
+#define DMSS_LOG_INFO(MSG)    DMSS_LOG_HIDDEN(MSG, Zaki::Util::LogLevel::Info, 2)
+#define DMSS_LOG_NOTE(MSG)    DMSS_LOG_HIDDEN(MSG, Zaki::Util::LogLevel::Verbose, 3)
+
+//==============================================================
+#endif /*DMSS_AsyncLog_H*/
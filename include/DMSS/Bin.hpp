@@ -1,6 +1,8 @@
 #ifndef DMSS_Bin_H
 #define DMSS_Bin_H
 
+#include <memory>
+
 // Root
 #include <TH1F.h>
 
@@ -33,7 +35,17 @@ class Bin : public Prog
         const Zaki::Math::Quantity& in_n_count,
         const Flux& in_flux) ;
     
+    /// Copy constructor (deep-copies the time-binned histogram)
     Bin(const Bin& other) ;
+
+    /// Move constructor (takes over the time-binned histogram)
+    Bin(Bin&& other) noexcept ;
+
+    /// Copy assignment
+    Bin& operator=(const Bin& other) ;
+
+    /// Move assignment
+    Bin& operator=(Bin&& other) noexcept ;
     
     ~Bin() ;
 
@@ -54,15 +66,23 @@ class Bin : public Prog
     Zaki::Math::Range<double> GetERange() const;
     Zaki::Math::Quantity GetECenter() const;
     Zaki::Math::Quantity GetNCount() const;
-    std::vector<Zaki::Math::Quantity> GetTBinObsSet() const;
+    const std::vector<Zaki::Math::Quantity>& GetTBinObsSet() const;
     // std::vector<double> GetTBinObsSetErr() const;
-    TH1F GetTBinHist() const;
+    const TH1F& GetTBinHist() const;
     size_t GetTBinChops() const;
     //............................................
 
     // Dividing one bin into more bins
     TH1F divide(size_t) ;
 
+    /// Divides the bin into time bins with the given edges (in
+    ///  days), the counts are proportional to their widths
+    TH1F divide(const std::vector<double>& edges) ;
+
+    /// Widths of a histogram's bins relative to their mean
+    ///  (all 1 for equal widths)
+    static std::vector<double> RelWidths(const TH1&) ;
+
     //............................................
     // Plotters
     //............................................
@@ -91,8 +111,12 @@ class Bin : public Prog
     bool divided_bin_flag = false ;
 
     std::vector<Zaki::Math::Quantity> t_bin_obs_set ;
-    TH1F t_bin_hist ;
+    /// Owned on the heap so that moving a bin is a pointer swap
+    std::unique_ptr<TH1F> t_bin_hist ;
     size_t t_bin_chops = 0; 
+
+    /// Deep-copies the time-binned histogram of another bin
+    void CopyTBinHist(const Bin&) ;
 };
 
 //==============================================================
@@ -0,0 +1,102 @@
+#ifndef DMSS_CLsLimit_H
+#define DMSS_CLsLimit_H
+
+#include <cstdint>
+#include <vector>
+
+#include "DMSS/PoissonFitter.hpp"
+
+//==============================================================
+/// CLs upper limit on the signal strength of a bin's time series
+///  (the counts n_j are Poisson with the means mu*s_j + bg*w_j,
+///  as in 'PoissonFitter'), from
+///  toys of the one-sided profile-likelihood ratio
+///
+///   q_mu = -2LogL(mu, bg(mu)) + 2LogL(mu_hat, bg_hat)  (0 if mu_hat > mu)
+///
+///  CLs(mu) = P(q_mu >= q_obs | mu) / P(q_mu >= q_obs | 0), where the
+///  toys of a hypothesis have the background that fits the data at
+///  its mu. The toys run in parallel (each with its own random
+///  stream), and their counts & fits are cached:
+///   - the background-only toys serve every mu,
+///   - the toys of a mu also serve the neighbouring mu's, weighted
+///     by the likelihood ratio of the two hypotheses, as long as
+///     their effective number is large enough.
+///  The toys are only added near the crossing: at each mu they are
+///  doubled (up to the maximum) while CLs is within 2 sigma of 1-CL.
+class CLsLimit
+{
+  //--------------------------------------------------------------
+  public:
+    /// A point of the scan
+    struct Point
+    {
+      double mu = 0 ;
+      double cls = 0, cls_err = 0 ;
+
+      /// Number of the (effective) toys of each hypothesis
+      double n_sb = 0, n_b = 0 ;
+    };
+
+    CLsLimit(const std::vector<double>& counts, const std::vector<double>& sig,
+             const uint64_t& seed, const std::vector<double>& width = {}) ;
+
+    /// Number of the toys of each hypothesis, at first and at most
+    void SetToys(const size_t& n_min, const size_t& n_max) ;
+
+    /// Relative precision of the limit
+    void SetTolerance(const double&) ;
+
+    /// CLs at 'mu', with (at least) 'n_toys' toys of each hypothesis
+    Point Eval(const double& mu, const size_t& n_toys) ;
+
+    /// The mu where CLs = 1 - cl (NaN if the data can't be fitted)
+    double Limit(const double& cl) ;
+
+    /// The points evaluated so far (in order)
+    const std::vector<Point>& GetScan() const ;
+
+    /// Number of the toys generated so far
+    size_t NToys() const ;
+
+  //--------------------------------------------------------------
+  private:
+    /// Toys generated at (mu, bg): their counts (toy-major), and
+    ///  their fits (mu_hat is NaN if a fit failed)
+    struct Ensemble
+    {
+      double mu = 0, bg = 0 ;
+      uint64_t stream = 0 ;
+      std::vector<double> counts, mu_hat, min_val ;
+
+      size_t Size() const { return mu_hat.size() ; }
+    };
+
+    std::vector<double> counts, sig, width ;
+    uint64_t seed ;
+    size_t n_min = 500, n_max = 8000 ;
+    double tol = 0.01 ;
+
+    /// The fit of the data
+    PoissonFitter obs_fitter ;
+    PoissonFitter::Result obs_fit ;
+
+    Ensemble b_toys ;
+    std::vector<Ensemble> sb_toys ;
+    std::vector<Point> scan ;
+
+    /// Generates & fits the toys of an ensemble up to 'n' (in parallel)
+    void Extend(Ensemble&, const size_t& n) ;
+
+    /// q_mu of the data, and of the toys of an ensemble (in parallel)
+    double TestStat(const double& mu) const ;
+    std::vector<double> TestStat(const Ensemble&, const double& mu) const ;
+
+    /// The log-likelihood-ratio weights of an ensemble's toys for
+    ///  the hypothesis (mu, bg), returns their effective number
+    double Weights(const Ensemble&, const double& mu, const double& bg,
+                   std::vector<double>& w) const ;
+};
+
+//==============================================================
+#endif /*DMSS_CLsLimit_H*/
@@ -0,0 +1,69 @@
+#ifndef DMSS_Checkpoint_H
+#define DMSS_Checkpoint_H
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DMSS/Prog.hpp"
+
+//==============================================================
+/// On-disk record of the finished units of work (one fit, one
+///  likelihood scan, ...) of a long run, so that a resumed run
+///  can skip them. Every unit is a line:
+///
+///   <key> \t <value_1> <value_2> ...
+///
+/// appended and synced as soon as the unit is done, so a crash
+///  loses at most the unit that was being written (a torn last
+///  line is dropped when resuming).
+class Checkpoint : public Prog
+{
+  //--------------------------------------------------------------
+  public:
+
+    /// Opens the checkpoint file, if 'resume' is false
+    ///  the previous records are discarded.
+    Checkpoint(const Zaki::String::Directory& f_name, const bool resume) ;
+
+    // Destructor
+    ~Checkpoint() ;
+
+    Checkpoint(const Checkpoint&) = delete ;
+    Checkpoint& operator=(const Checkpoint&) = delete ;
+
+    /// Returns if the unit is done, and its values
+    bool Find(const std::string& key, std::vector<double>& vals) const ;
+
+    /// Records a finished unit (thread-safe)
+    void Save(const std::string& key, const std::vector<double>& vals) ;
+
+    /// Number of the finished units
+    size_t Size() const ;
+
+    /// Adds the records of another checkpoint file (e.g. written
+    ///  by another process), returns false if it can't be read
+    bool Import(const Zaki::String::Directory&) ;
+
+  //--------------------------------------------------------------
+  private:
+
+    Zaki::String::Directory file ;
+    FILE* out = nullptr ;
+
+    typedef std::unordered_map<std::string, std::vector<double>> UnitMap ;
+
+    mutable std::mutex mtx ;
+    UnitMap units ;
+
+    /// Reads the records of a file, returns false if it can't be read
+    bool Load(const Zaki::String::Directory&, UnitMap&) ;
+
+    /// Writes a record line (not synced)
+    void Write(const std::string& key, const std::vector<double>& vals) ;
+};
+
+//==============================================================
+#endif /*DMSS_Checkpoint_H*/
@@ -22,6 +22,7 @@ class Data : public Prog
   //............................................
     // Adding an individual bin
     void AddBin(const Bin&) ;
+    void AddBin(Bin&&) ;
     void AddBin(const Zaki::Math::Range<double>& in_e_range,
                 const Zaki::Math::Quantity& in_e_center,
                 const Zaki::Math::Quantity& in_n_count,
@@ -30,6 +31,9 @@ class Data : public Prog
     // Adding a set of bins from file
     void Input(const Zaki::String::Directory&) ;
 
+    // Reserving space for 'n' bins
+    void Reserve(size_t) ;
+
     // Setting the states
     void SetStates(const std::vector<DMSolarSignal::Particle>&) ;
   //............................................
@@ -37,7 +41,7 @@ class Data : public Prog
   //............................................
   // Getters
   //............................................
-    std::vector<Bin> GetBins() const ;
+    const std::vector<Bin>& GetBins() const ;
     std::vector<DMSolarSignal::Particle> GetStates() const ;
 
     // Printing the data set info
@@ -48,6 +52,7 @@ class Data : public Prog
 
     void Plot(const Zaki::String::Directory&) const ;
     Bin& operator[](size_t) ;
+    const Bin& operator[](size_t) const ;
     size_t size() const ;
 
     void ScaleData(const double& ) ;
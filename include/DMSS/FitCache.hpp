@@ -0,0 +1,102 @@
+#ifndef DMSS_FitCache_H
+#define DMSS_FitCache_H
+
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DMSS/Prog.hpp"
+
+//==============================================================
+/// Process-wide cache of the fit results, keyed by a hash of
+///  everything that determines a fit (the observed counts, the
+///  signal shapes, the options). The recently used results are
+///  kept in memory (LRU), and if a file is opened, all of them
+///  are also kept on disk, so the identical fits of the later
+///  runs are lookups as well. The records are lines:
+///
+///   <key> \t <n> <value_1> ... <value_n>
+///
+/// and only their offsets are kept in memory. The file can also
+///  be set with 'DMSS_FIT_CACHE'.
+class FitCache
+{
+  //--------------------------------------------------------------
+  public:
+    /// Content hash of the inputs of a fit
+    class Key
+    {
+      public:
+        /// 'kind' names the fit (e.g. "thresh_minos")
+        Key(const std::string& kind) ;
+
+        Key& Add(const double&) ;
+        Key& Add(const std::vector<double>&) ;
+        Key& Add(const std::string&) ;
+
+        /// The kind, and the 128-bit hash in hex
+        std::string Str() const ;
+
+      private:
+        std::string kind ;
+        uint64_t h1, h2 ;
+        void AddWord(const uint64_t&) ;
+    };
+
+    /// The shared cache (created on first use)
+    static FitCache& Get() ;
+
+    /// Number of the results kept in memory
+    void SetCapacity(const size_t&) ;
+
+    /// Keeps the results in a file too (and reads the previous ones)
+    void Open(const Zaki::String::Directory&) ;
+
+    /// Returns if the fit is cached, and its values (thread-safe)
+    bool Find(const std::string& key, std::vector<double>& vals) ;
+
+    /// Caches the values of a fit (thread-safe)
+    void Save(const std::string& key, const std::vector<double>& vals) ;
+
+    /// Number of the lookups that were found (missed)
+    size_t Hits() const ;
+    size_t Misses() const ;
+
+    FitCache(const FitCache&) = delete ;
+    FitCache& operator=(const FitCache&) = delete ;
+
+  //--------------------------------------------------------------
+  private:
+    FitCache() ;
+    ~FitCache() ;
+
+    typedef std::list<std::pair<std::string, std::vector<double>>> LRUList ;
+
+    mutable std::mutex mtx ;   // guards everything below
+    size_t capacity = 4096 ;
+    size_t hits = 0, misses = 0 ;
+
+    /// The most recent results first, and where they are in the list
+    LRUList lru ;
+    std::unordered_map<std::string, LRUList::iterator> lru_idx ;
+
+    /// The on-disk tier: the offsets of the records in the file
+    Zaki::String::Directory file = "" ;
+    FILE* in = nullptr ;
+    FILE* out = nullptr ;
+    std::unordered_map<std::string, long> offsets ;
+
+    /// Puts a result at the front of the list, dropping the oldest
+    void Touch(const std::string& key, const std::vector<double>& vals) ;
+
+    /// Reads a record line at 'offset', false if it's torn
+    bool ReadRecord(const long& offset, std::string& key,
+                    std::vector<double>& vals) ;
+};
+
+//==============================================================
+#endif /*DMSS_FitCache_H*/
@@ -0,0 +1,140 @@
+#ifndef DMSS_FitSeed_H
+#define DMSS_FitSeed_H
+
+#include <functional>
+#include <ostream>
+#include <vector>
+
+//  Minuit2
+#include <Minuit2/FCNBase.h>
+#include <Minuit2/FunctionMinimum.h>
+#include <Minuit2/MinosError.h>
+#include <Minuit2/MnUserCovariance.h>
+#include <Minuit2/MnUserParameters.h>
+#include <Minuit2/MnUserParameterState.h>
+
+//==============================================================
+/// The minimum of a fit (the parameters, their errors and the
+///  covariance), used as the starting point of a neighbouring
+///  fit, so Migrad starts next to the answer.
+class FitSeed
+{
+  //--------------------------------------------------------------
+  public:
+    /// An empty seed (the fits start from their defaults)
+    FitSeed() ;
+
+    /// The seed of a fit's minimum (empty if it's invalid)
+    FitSeed(const ROOT::Minuit2::FunctionMinimum&) ;
+
+    /// The seed of a minimum found without Minuit: the parameters'
+    ///  names & values, and their covariance (the lower triangle,
+    ///  row by row, as 'MnUserCovariance'), if known
+    FitSeed(const std::vector<std::string>& names, const std::vector<double>& vals,
+            const std::vector<double>& cov = {}) ;
+
+    /// If the seed has a state
+    bool Valid() const ;
+
+    /// The Minuit state of the minimum
+    const ROOT::Minuit2::MnUserParameterState& GetState() const ;
+
+    /// The starting state of a fit with the default parameters
+    ///  'upar': the parameters with the same name take the seed's
+    ///  values & errors (within the limits), and if all of them
+    ///  match, the seed's covariance is also used.
+    ROOT::Minuit2::MnUserParameterState Start(const ROOT::Minuit2::MnUserParameters& upar) const ;
+
+    /// Migrad from the seed (if there is one), or from 'upar'.
+    ///  A seeded fit that fails is started again from 'upar'.
+    static ROOT::Minuit2::FunctionMinimum Migrad(const ROOT::Minuit2::FCNBase&,
+                                                 const ROOT::Minuit2::MnUserParameters& upar,
+                                                 const FitSeed* seed,
+                                                 const unsigned int& strategy,
+                                                 const unsigned int& max_calls=0) ;
+
+    /// Appends the values & the covariance to 'vals' (the names
+    ///  aren't kept)
+    void Pack(std::vector<double>& vals) const ;
+
+    /// Reads a seed of the parameters 'names' from 'vals', starting
+    ///  at 'pos' (which is moved past it), false if there isn't one
+    bool Unpack(const std::vector<double>& vals, size_t& pos,
+                const std::vector<std::string>& names) ;
+
+  //--------------------------------------------------------------
+  private:
+    ROOT::Minuit2::MnUserParameterState state ;
+    bool valid = false ;
+};
+
+//==============================================================
+/// A Minos error as plain values, so the result of a fit 
+///  can be cached (same accessors as 'MinosError')
+class MinosResult
+{
+  //--------------------------------------------------------------
+  public:
+    MinosResult() ;
+    MinosResult(const ROOT::Minuit2::MinosError&) ;
+
+    /// From the minimum, and the distances to the crossings
+    MinosResult(const double& min, const double& lower, const double& upper,
+                const bool valid, const unsigned int& nfcn) ;
+
+    double Min() const ;
+    double Lower() const ;
+    double Upper() const ;
+    bool IsValid() const ;
+    unsigned int NFcn() const ;
+
+    /// Appends the values to 'vals'
+    void Pack(std::vector<double>& vals) const ;
+
+    /// Reads the values from 'vals', starting at 'pos'
+    ///  (which is moved past them), false if there aren't enough
+    bool Unpack(const std::vector<double>& vals, size_t& pos) ;
+
+  //--------------------------------------------------------------
+  private:
+    double min = 0, lower = 0, upper = 0 ;
+    bool valid = false ;
+    unsigned int nfcn = 0 ;
+};
+
+std::ostream& operator<<(std::ostream&, const MinosResult&) ;
+
+//==============================================================
+/// Chains the fits along a sweep (bins, periods, masses): the
+///  items are split into chains of 'len' consecutive items, and
+///  each item is seeded by the previous item of its chain. The
+///  chains run in parallel, and they don't depend on the thread
+///  count, so neither do the results.
+class FitChain
+{
+  //--------------------------------------------------------------
+  public:
+    FitChain(const size_t& n, const size_t& len) ;
+
+    /// Number of the items in a chain
+    size_t Length() const ;
+
+    /// The seed of item 'i' (nullptr at the start of a chain,
+    ///  or if the previous fit failed or didn't run)
+    const FitSeed* Prev(const size_t& i) const ;
+
+    /// Stores the seed of item 'i'
+    void Set(const size_t& i, const FitSeed&) ;
+
+    /// Runs fit(0), ..., fit(n-1): the chains in parallel,
+    ///  and the items of each chain in order
+    void Run(const std::function<void(size_t)>& fit) ;
+
+  //--------------------------------------------------------------
+  private:
+    size_t len ;
+    std::vector<FitSeed> seeds ;
+};
+
+//==============================================================
+#endif /*DMSS_FitSeed_H*/
@@ -0,0 +1,74 @@
+#ifndef DMSS_FluxLoader_H
+#define DMSS_FluxLoader_H
+
+#include <vector>
+#include <string_view>
+
+#include <Zaki/String/Directory.hpp>
+
+//==============================================================
+/// One row of a binned flux table:
+///   Emin, Emax, Ec, Ec_err, N, N_err, flux, stat, sys
+struct FluxRow
+{
+  double e_min, e_max ;
+  double e_c, e_c_err ;
+  double n, n_err ;
+  double flux, stat_err, sys_err ;
+};
+
+//==============================================================
+/// Read-only memory mapping of a file (RAII)
+class MappedFile
+{
+  //--------------------------------------------------------------
+  public:
+    MappedFile(const Zaki::String::Directory&) ;
+    ~MappedFile() ;
+
+    MappedFile(const MappedFile&) = delete ;
+    MappedFile& operator=(const MappedFile&) = delete ;
+
+    /// Returns if the file has been mapped successfully
+    bool IsOpen() const ;
+
+    /// The mapped content
+    std::string_view View() const ;
+
+  //--------------------------------------------------------------
+  private:
+    const char* data = nullptr ;
+    size_t      len  = 0 ;
+    bool        open_flag = false ;
+};
+
+//==============================================================
+/// Zero-copy loader for the 9-column binned flux tables
+class FluxLoader
+{
+  //--------------------------------------------------------------
+  public:
+    /// Number of columns expected in each row
+    static constexpr size_t NCols = 9 ;
+
+    FluxLoader(const Zaki::String::Directory&) ;
+
+    /// Parses the file, validating the schema;
+    ///  reports the row/column of the first bad field and exits.
+    const std::vector<FluxRow>& Load() ;
+
+  //--------------------------------------------------------------
+  private:
+    Zaki::String::Directory file_name ;
+    std::vector<FluxRow> rows ;
+
+    /// Parses a single field, accepting U+2212 as a minus sign
+    bool ParseField(std::string_view, double&) const ;
+
+    /// Reports a schema error and exits
+    [[noreturn]] void Fail(size_t row, size_t col, const char* msg,
+                           std::string_view field) const ;
+};
+
+//==============================================================
+#endif /*DMSS_FluxLoader_H*/
@@ -0,0 +1,81 @@
+#ifndef DMSS_GridTable_H
+#define DMSS_GridTable_H
+
+#include <functional>
+#include <vector>
+
+#include <Zaki/Math/Math_Core.hpp>
+
+#include "DMSS/Prog.hpp"
+
+//==============================================================
+/// Values of a contour function on the points of a 2-D grid.
+///  The grid is split into tiles (bands of the x points), which
+///  can be evaluated by different processes and exported into
+///  their own files. Once all the tiles are imported, 'Eval'
+///  looks the values up, so CONFIND can find the contours
+///  without evaluating the function again.
+///  A whole grid (tile 0 of 1) is also kept on disk, so the
+///  contours can be found again at any level, without the model.
+class GridTable : public Prog
+{
+  //--------------------------------------------------------------
+  public:
+
+    // Constructor
+    GridTable(const Zaki::Math::Grid2D&) ;
+
+    // Destructor
+    ~GridTable() ;
+
+    /// Evaluates the function on tile 'k' of 'n' (in parallel)
+    void Fill(const size_t& k, const size_t& n,
+              const std::function<double(double, double)>& func) ;
+
+    /// Exports tile 'k' of 'n' into a binary file
+    void ExportTile(const size_t& k, const size_t& n,
+                    const Zaki::String::Directory&) const ;
+
+    /// Imports tile 'k' of 'n', returns false if the file
+    ///  doesn't exist or belongs to a different grid
+    bool ImportTile(const size_t& k, const size_t& n,
+                    const Zaki::String::Directory&) ;
+
+    /// Exports (imports) all the values, with the grid & the label
+    void Export(const Zaki::String::Directory&) const ;
+    bool Import(const Zaki::String::Directory&) ;
+
+    /// Description of the values (e.g. model, plane, mass, bin)
+    void SetLabel(const std::string&) ;
+    std::string GetLabel() const ;
+
+    /// Returns if all the tiles are filled
+    bool Complete() const ;
+
+    /// The value at a grid point, or the bilinear interpolation
+    ///  of the surrounding grid points
+    double Eval(double x, double y) const ;
+
+  //--------------------------------------------------------------
+  private:
+
+    Zaki::Math::Grid2D grid ;
+    std::string label = "" ;
+
+    /// The grid points
+    std::vector<double> x_pts, y_pts ;
+
+    /// Values (x-major), and if each x point is filled
+    std::vector<double> vals ;
+    std::vector<char> filled ;
+
+    /// The x points of tile 'k' of 'n'
+    Zaki::Math::Range<size_t> TileRange(const size_t& k, const size_t& n) const ;
+
+    /// Index of the grid point below 'v', and the fraction
+    ///  of the way to the next point
+    static size_t Locate(const std::vector<double>& pts, const double& v, double& frac) ;
+};
+
+//==============================================================
+#endif /*DMSS_GridTable_H*/
@@ -6,15 +6,28 @@
 
 #include "DMSS/Bin.hpp"
 #include "DMSS/Prog.hpp"
+#include "DMSS/FitSeed.hpp"
 
 //==============================================================
 // namespace DMSS
 // {
 //==============================================================
+/// The combined multi-bin likelihood of 'LogLikeli' (a signal
+///  strength mu, and a background bg_i per bin) minimized as the
+///  root of the score equations
+///
+///   sum_ij s_ij (n_ij/r_ij - 1) = 0 ,  sum_j w_ij (n_ij/r_ij - 1) = 0 ,
+///
+///  with r_ij = mu*s_ij + bg_i*w_ij (w_ij the relative widths of
+///  the time bins), by GSL's 'hybridsj' solver with
+///  the analytic Jacobian. The parameters are solved for in their
+///  logs, so the rates stay positive. mu = 0 is checked first:
+///  the minimum is at the limit if -2LogL increases with mu there.
+///  The API follows the Minuit fits ('Minimize' as Migrad, and
+///  'Minos' for the errors). An invalid minimum (e.g. a background
+///  at zero) should be fitted by Minuit instead.
 class LikeLi_Eq : public Prog
 {
-  
-  double root_guess[2] = {-10, -5} ;
   //--------------------------------------------------------------
   public:
 
@@ -24,24 +37,100 @@ class LikeLi_Eq : public Prog
     /// Destructor
     ~LikeLi_Eq() {} ;
 
-    int SolveEq() ;
-    int SolveEqJacob() ;
+    /// Adds a bin (its counts & signal shape, in order)
+    void AddObsCounts(const Bin&) ;
+    void AddObsSet(const std::vector<Zaki::Math::Quantity>&) ;
+    void AddSigShape(const TH1F&) ;
+
+    /// The rise of -2LogL that defines the errors
+    void SetErrorDef(const double&) ;
+    double ErrorDef() const ;
+
+    /// Maximum number of the solver iterations (per solve)
+    void SetMaxIter(const size_t&) ;
+
+    /// Prints the solver iterations
+    void SetVerbose(const bool) ;
+
+    /// -2LogL of {mu, bg_0, bg_1, ...}
+    double operator()(const std::vector<double>& par) const ;
+
+    /// Finds the minimum, returns if it's valid
+    bool Minimize() ;
+
+    /// If the minimum is valid
+    bool IsValid() const ;
 
+    /// The parameters at the minimum {mu, bg_0, bg_1, ...}
+    const std::vector<double>& Params() const ;
+
+    /// -2LogL at the minimum
+    double Fval() const ;
+
+    /// Number of the solver iterations (all the solves)
+    size_t NIter() const ;
+
+    /// Largest score equation at the root of the last solve
+    double Residual() const ;
+
+    /// GSL status of the last solve
+    int Status() const ;
+
+    /// Where -2LogL, profiled over the other parameters, rises
+    ///  by the 'ErrorDef' around the minimum (as 'MnMinos')
+    MinosResult Minos(const size_t& i) ;
+
+    /// The score equations (of the free parameters' logs)
     int Eq(const gsl_vector* x, gsl_vector* f) ;
     int Jacob(const gsl_vector* x, gsl_matrix* J) ;
     int EqFdf(const gsl_vector* x, gsl_vector* f, gsl_matrix* J) ;
 
-    void AddObsCounts(const Bin&) ;
-    void AddSigShape(const TH1F&) ;
-
-    void PrintState(const size_t& iter, gsl_multiroot_fsolver * s) ;
-    void PrintState(const size_t& iter, gsl_multiroot_fdfsolver * s) ;
-
+  //--------------------------------------------------------------
   private:
     double theErrorDef = 1 ;
-    std::vector<std::vector<Zaki::Math::Quantity> > obs_set ;
-    std::vector<TH1F> sig_shape_hist ;
+    size_t max_iter = 200 ;
+    bool verbose = false ;
+
+    std::vector<std::vector<double> > obs_set ;
+    std::vector<std::vector<double> > sig_set ;
+    std::vector<std::vector<double> > width_set ;
+
+    /// The counts of each bin, and of all, and the widths of each bin
+    std::vector<double> n_bin, w_bin ;
+    double n_tot = 0 ;
+
+    /// The minimum
+    bool valid = false ;
+    std::vector<double> min_par ;
+    double min_val = 0 ;
 
+    /// Diagnostics
+    size_t n_iter = 0 ;
+    double residual = 0 ;
+    int status = GSL_CONTINUE ;
+
+    /// The parameters of the solve, and which are free
+    std::vector<double> work ;
+    std::vector<size_t> free_idx ;
+
+    /// The derivatives of LogL at 'par': the gradient, and the
+    ///  Hessian {mu-mu, mu-bg_i, bg_i-bg_i} (the bg's don't mix),
+    ///  false if a non-zero count has no rate
+    bool Score(const std::vector<double>& par, std::vector<double>& grad,
+               double& h_mm, std::vector<double>& h_mb,
+               std::vector<double>& h_bb) const ;
+
+    /// Sets 'work' from the free parameters' logs
+    void SetWork(const gsl_vector* x) ;
+
+    /// Minimizes over the parameters other than 'fixed' (from
+    ///  'par', which is set to the minimum), false if it fails
+    bool Profile(std::vector<double>& par, const size_t& fixed) ;
+
+    /// Solves the score equations of 'free_idx' from 'work'
+    bool Solve() ;
+
+    void PrintState(const size_t& iter, gsl_multiroot_fdfsolver * s) ;
 };
 
 //==============================================================
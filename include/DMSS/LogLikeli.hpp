@@ -4,6 +4,7 @@
 #include <Minuit2/FCNBase.h>
 
 #include "DMSS/Bin.hpp"
+#include "DMSS/AsyncLog.hpp"
 
 //==============================================================
 namespace ROOT {
@@ -30,10 +31,25 @@ class LogLikeli : public FCNBase, public Prog
             nd_ignore_idx(other.nd_ignore_idx),
             nd_best_fit(other.nd_best_fit)
             {
-                for (auto h: other.sig_shape_hist) {
-                    sig_shape_hist.emplace_back( *(static_cast<TH1F*>(h.Clone())) ) ;
+                sig_shape_hist.reserve(other.sig_shape_hist.size()) ;
+                for (auto&& h: other.sig_shape_hist) {
+                    AddSigShape(*h) ;
                 }
             }
+
+    /// Move constructor
+    LogLikeli(LogLikeli&& other) noexcept
+        : Prog("LogLikeli", true),
+            fix_bg(other.fix_bg), 
+            var_bg(other.var_bg),
+            theErrorDef(other.theErrorDef),
+            obs_set(std::move(other.obs_set)), 
+            sig_shape_hist(std::move(other.sig_shape_hist)),
+            bg_shape(std::move(other.bg_shape)),
+            nd_bg_set(std::move(other.nd_bg_set)),
+            nd_ignore_idx(other.nd_ignore_idx),
+            nd_best_fit(std::move(other.nd_best_fit))
+            {}
     
     virtual double operator()(const std::vector<double>& par) const override ;
     
@@ -44,13 +60,13 @@ class LogLikeli : public FCNBase, public Prog
     void SetErrorDef (double def) override
     {  
       theErrorDef = def; 
-      char tmp[100] ;
-      sprintf(tmp, "%.3f", def) ;
-      Z_LOG_INFO("The error definition is set to: " + std::string(tmp) + ".") ;
+      DMSS_LOG_INFO(AsyncLog::Format("The error definition is set to: %.3f.", def)) ;
     }
     
     void AddObsCounts(const Bin&) ;
     void AddObsSet (const std::vector<Zaki::Math::Quantity>& in_obs_set) ;
+    /// Replaces the first observed set (e.g. between toys)
+    void SetObsSet (const std::vector<Zaki::Math::Quantity>& in_obs_set) ;
     
     void AddSigShape(const TH1F&) ;
     void SetNDBgSet(const size_t ignore_idx, const std::vector<double>&) ;
@@ -58,6 +74,14 @@ class LogLikeli : public FCNBase, public Prog
 
     double Q(double, const std::vector<double>&) const;
 
+    /// Chi-squared quantile (cached, since it's slow to compute)
+    static double ChiSqQuantile(const double& cl, const int& ndf) ;
+
+    /// Upper limit on mu (>= 0) where -2LogL, profiled over the
+    ///  backgrounds, rises by 'q' above its minimum. Safeguarded
+    ///  Newton steps with analytic derivatives (thread-safe).
+    double UpperLimit(const double& q) const ;
+
     /// -2LogL = 5.99146 Equation
     double MuEquation(double x) ;
     double MuEquationDer(double x) ;
@@ -71,11 +95,25 @@ class LogLikeli : public FCNBase, public Prog
   private:
     double theErrorDef = 1 ;
     std::vector<std::vector<Zaki::Math::Quantity> > obs_set ;
-    std::vector<TH1F> sig_shape_hist ;
+    /// Signal shapes, owned on the heap so growth only moves pointers
+    std::vector<std::unique_ptr<TH1F>> sig_shape_hist ;
+
+    /// The background of a time bin scales with its relative width
+    ///  (all 1 for equal widths)
+    std::vector<std::vector<double>> bg_shape ;
 
     std::vector<double> nd_bg_set ;
     size_t nd_ignore_idx  ;
     std::vector<double> nd_best_fit ;
+
+    /// Background of set 'i' that minimizes -2LogL at 'mu'
+    ///  (the previous one, 'bg', is the first guess)
+    double ProfileBg(const size_t& i, const double& mu, const double& bg) const ;
+
+    /// Profiled -2LogL at 'mu', with its first & second derivatives,
+    ///  the profiled backgrounds are updated in 'bg'
+    double Profile(const double& mu, std::vector<double>& bg, 
+                   double& d1, double& d2) const ;
 };
 
   }  // namespace Minuit2
@@ -0,0 +1,46 @@
+#ifndef DMSS_ObjTracker_H
+#define DMSS_ObjTracker_H
+
+#include <cstddef>
+#include <string>
+
+#include <Zaki/String/Directory.hpp>
+
+//==============================================================
+/// Object lifetime tracker for Prog-derived objects.
+///  Live objects are kept in hash maps sharded by address, so
+///  registering and removing an object is O(1) and only takes
+///  the lock of its own shard. Totals are aggregated on demand.
+class ObjTracker
+{
+  //--------------------------------------------------------------
+  public:
+    /// Number of shards (power of two)
+    static constexpr size_t NumShards = 64 ;
+
+    /// Registers a constructed object
+    static void Construct(const void*, const std::string&) ;
+
+    /// Unregisters a destroyed object
+    static void Destruct(const void*) ;
+
+    /// Sets the file that Report() also writes to
+    static void SetFile(const Zaki::String::Directory&) ;
+
+    /// Number of live tracked objects
+    static size_t LiveCount() ;
+
+    /// Prints the live objects per class name, and the number of
+    ///  destructions that didn't match any construction
+    static void Report() ;
+
+  //--------------------------------------------------------------
+  private:
+    ObjTracker() = delete ;
+
+    /// Returns a small integer id for a class name
+    static unsigned NameId(const std::string&) ;
+};
+
+//==============================================================
+#endif /*DMSS_ObjTracker_H*/
@@ -0,0 +1,57 @@
+#ifndef DMSS_PlotQueue_H
+#define DMSS_PlotQueue_H
+
+#include <functional>
+#include <mutex>
+
+//==============================================================
+/// Plots are described during the computation (a closure that
+///  holds copies of the data and the style, and draws them), and
+///  rendered according to the mode:
+///
+///   Immediate  : right away, on the calling thread (default)
+///   Deferred   : when 'Flush' is called (e.g. after a run)
+///   Background : by a single rendering thread, concurrently
+///                with the computation
+///   Headless   : never
+///
+///  The mode can also be set by 'DMSS_PLOT_MODE' (immediate,
+///  deferred, background, headless). All the rendering is
+///  serialized, so ROOT's graphics state is never shared.
+class PlotQueue
+{
+  //--------------------------------------------------------------
+  public:
+    enum class Mode
+    {
+      Immediate = 0, Deferred, Background, Headless
+    };
+
+    /// Sets the mode (the plots queued before are rendered first)
+    static void SetMode(const Mode&) ;
+
+    static Mode GetMode() ;
+
+    /// Returns if the plots are skipped, so there's no need
+    ///  to prepare their data either
+    static bool Headless() ;
+
+    /// Queues a plot (it may be rendered on another thread)
+    static void Push(std::function<void()>&& render) ;
+
+    /// Renders the queued plots, and blocks until they're done
+    ///  (also called by the 'Analysis' destructor; the plots
+    ///  still queued at exit are dropped)
+    static void Flush() ;
+
+    /// Lock for the ROOT graphics done outside of the queue
+    ///  (don't 'Push' while holding it)
+    static std::unique_lock<std::mutex> Lock() ;
+
+  //--------------------------------------------------------------
+  private:
+    PlotQueue() = delete ;
+};
+
+//==============================================================
+#endif /*DMSS_PlotQueue_H*/
@@ -0,0 +1,90 @@
+#ifndef DMSS_PoissonFitter_H
+#define DMSS_PoissonFitter_H
+
+#include <array>
+#include <functional>
+#include <vector>
+
+#include "DMSS/FitSeed.hpp"
+
+//==============================================================
+/// Dedicated fitter of a bin's time series: the counts n_j are
+///  Poisson with the means  mu*s_j + bg*w_j  (w_j: the width of
+///  the time bin relative to the mean, 1 for equal widths), and
+///
+///   -2LogL = -2 sum (n_j ln(mu*s_j + bg*w_j) - mu*s_j - bg*w_j)
+///
+///  is convex, with an analytic gradient & Hessian. The minimum
+///  (mu >= 0) is found by projected Newton steps (halved until
+///  -2LogL decreases), and the intervals are the roots of the
+///  profiles, so a fit takes microseconds (thread-safe).
+///  The fit is invalid on pathological inputs (e.g. no counts,
+///  or a flat signal, where mu & bg can't be told apart), and
+///  then Minuit should be used instead.
+class PoissonFitter
+{
+  //--------------------------------------------------------------
+  public:
+    /// Results of a fit
+    struct Result
+    {
+      bool valid = false ;
+      double mu = 0, bg = 0 ;
+
+      /// -2LogL at the minimum
+      double min_val = 0 ;
+
+      /// Covariance (for a unit rise of -2LogL): {mu-mu, mu-bg, bg-bg}
+      std::array<double, 3> cov = {0, 0, 0} ;
+
+      /// Where the profiles rise by 'q' (as Minos errors)
+      MinosResult mu_err, bg_err ;
+
+      /// Number of the likelihood evaluations
+      unsigned int n_calls = 0 ;
+    };
+
+    /// The counts, the signal & the relative widths of the time
+    ///  bins (equal widths, if none)
+    PoissonFitter(const std::vector<double>& counts, const std::vector<double>& sig,
+                  const std::vector<double>& width = {}) ;
+
+    /// Finds the minimum, and the intervals where -2LogL,
+    ///  profiled over the other parameter, rises by 'q'
+    Result Fit(const double& q) const ;
+
+    /// Finds the minimum only (no intervals)
+    Result Minimum() const ;
+
+    /// -2LogL at 'mu', profiled over the background (which is
+    ///  also returned in 'bg', if given)
+    double Profile(const double& mu, double* bg=nullptr) const ;
+
+    /// -2LogL, its gradient & Hessian {mm, mb, bb}, or false if
+    ///  a mean of a non-zero count isn't positive
+    bool Eval(const double& mu, const double& bg, double& val,
+              std::array<double, 2>& grad, std::array<double, 3>& hess) const ;
+
+    /// Root of an increasing function f(x, df) in [lo, hi] from
+    ///  'x': Newton steps inside the bracket, otherwise bisection
+    static double Solve(const std::function<double(double, double&)>& f,
+                        double lo, double hi, double x) ;
+
+  //--------------------------------------------------------------
+  private:
+    std::vector<double> counts, sig, width ;
+    double n_tot = 0, s_tot = 0, w_tot = 0 ;
+
+    /// The largest signal per unit width
+    double s_max = 0 ;
+
+    /// Background that minimizes -2LogL at 'mu'
+    ///  (the evaluations are added to 'calls')
+    double ProfileBg(const double& mu, unsigned int& calls) const ;
+
+    /// mu (>= 0) that minimizes -2LogL at 'bg'
+    double ProfileMu(const double& bg, unsigned int& calls) const ;
+};
+
+//==============================================================
+#endif /*DMSS_PoissonFitter_H*/
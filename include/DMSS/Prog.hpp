@@ -13,6 +13,10 @@
 
 #define DMSS_PROG_DEBUG_MODE 1
 
+// 1: Prog objects are allocated from 'ProgPool'
+// 0: Prog objects go through Zaki's MemManager (exhaustive tracking)
+#define DMSS_PROG_POOL 1
+
 //==============================================================
 class Prog
 {
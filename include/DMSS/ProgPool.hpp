@@ -0,0 +1,75 @@
+#ifndef DMSS_ProgPool_H
+#define DMSS_ProgPool_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Compile-time default for sampled allocation tracking:
+//  0 disables it, N tracks one in every N allocations.
+#ifndef DMSS_PROG_POOL_SAMPLE_RATE
+  #define DMSS_PROG_POOL_SAMPLE_RATE 0
+#endif
+
+//==============================================================
+/// Size-class pool backing Prog::operator new/delete.
+///  Small blocks are served from thread-local free lists with
+///  no locking; the per-class central lists are only touched
+///  when a thread cache needs a refill or gets too long.
+///  Blocks larger than 'MaxPooled' go straight to malloc.
+class ProgPool
+{
+  //--------------------------------------------------------------
+  public:
+    /// Size-class granularity (bytes)
+    static constexpr size_t Granularity = 16 ;
+    
+    /// Largest block (including its header) kept in the pool
+    static constexpr size_t MaxPooled   = 2048 ;
+
+    /// Number of size classes
+    static constexpr size_t NumClasses  = MaxPooled / Granularity ;
+
+    /// Allocates 'sz' bytes
+    static void* Allocate(size_t sz) ;
+
+    /// Returns a block allocated by Allocate()
+    static void Deallocate(void*) ;
+
+    /// Sets the sampling rate for allocation tracking
+    ///  (0 disables it, N tracks one in every N allocations)
+    static void SetSampleRate(uint32_t) ;
+
+    /// Prints the pool usage and the sampled live allocations
+    static void Report() ;
+
+  //--------------------------------------------------------------
+  private:
+    ProgPool() = delete ;
+
+    /// Allocations are prefixed by this header (keeps 16-byte alignment)
+    struct alignas(16) Header
+    {
+      uint32_t cls ;      // size class, or 'NumClasses' for malloc
+      uint32_t sampled ;  // 1 if registered with the sampler
+      size_t   size ;     // requested size
+    };
+
+    struct FreeNode { FreeNode* next ; } ;
+
+    /// Returns the size class for a total block size
+    static size_t ClassOf(size_t total) ;
+
+    /// Refills the calling thread's cache for class 'c'
+    static FreeNode* Refill(size_t c) ;
+
+    /// Moves half of the thread cache of class 'c' to the central list
+    static void Drain(size_t c, size_t keep) ;
+
+    static void SampleNew(void*, size_t) ;
+    static void SampleDelete(void*) ;
+
+    friend struct ProgPoolThreadGuard ;
+};
+
+//==============================================================
+#endif /*DMSS_ProgPool_H*/
@@ -0,0 +1,91 @@
+#ifndef DMSS_RunConfig_H
+#define DMSS_RunConfig_H
+
+#include <string>
+#include <vector>
+
+#include "DMSS/Prog.hpp"
+
+//==============================================================
+/// Run configuration file, in an INI-like format:
+///
+///   # comment
+///   [run]
+///   e_cut = 50
+///
+///   [satellite AMS]
+///   bin_period = 10 10 15 30
+///
+/// Section headers are '[type]' or '[type label]', and
+///  the values are kept as strings until they are asked for.
+class RunConfig : public Prog
+{
+  //--------------------------------------------------------------
+  public:
+
+    /// A section of the configuration file
+    struct Section
+    {
+      std::string type ;
+      std::string label ;
+      size_t line = 0 ;
+
+      /// Keys in the order they appear in the file
+      std::vector<std::pair<std::string, std::string>> keys ;
+
+      /// Returns if the key is set
+      bool Has(const std::string&) const ;
+
+      /// Returns the value of a (required) key
+      std::string Get(const std::string&) const ;
+
+      /// Returns the value of a key, or the default if it isn't set
+      std::string Get(const std::string&, const std::string&) const ;
+
+      double GetDouble(const std::string&) const ;
+      double GetDouble(const std::string&, const double) const ;
+
+      /// Space (or comma) separated list of numbers
+      std::vector<double> GetDoubles(const std::string&) const ;
+      std::vector<int> GetInts(const std::string&) const ;
+
+      /// Space (or comma) separated list of words
+      std::vector<std::string> GetWords(const std::string&) const ;
+
+      /// All the keys and values in a single line
+      ///  (changes whenever any value changes)
+      std::string Signature() const ;
+
+      /// Only the listed keys (that are set) in a single line
+      std::string Signature(const std::vector<std::string>& only) const ;
+    };
+
+    // Constructor
+    RunConfig() ;
+
+    // Destructor
+    ~RunConfig() ;
+
+    /// Parses the configuration file
+    void Parse(const Zaki::String::Directory&) ;
+
+    /// Returns the sections in the order they appear in the file
+    const std::vector<Section>& GetSections() const ;
+
+    /// Returns the sections of a type
+    std::vector<const Section*> GetSections(const std::string& type) const ;
+
+    /// Returns the (only) section of a type, exits if it doesn't exist
+    const Section& GetSection(const std::string& type) const ;
+
+  //--------------------------------------------------------------
+  private:
+
+    /// The configuration file
+    Zaki::String::Directory file = "" ;
+
+    std::vector<Section> sections ;
+};
+
+//==============================================================
+#endif /*DMSS_RunConfig_H*/
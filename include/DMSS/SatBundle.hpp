@@ -11,6 +11,9 @@ class SatBundle : public Prog
   std::shared_ptr<Satellite> m_SatPtr;
   std::vector<int> m_BinPeriods  ;
 
+  /// Time bin edges (in days) replacing the periods (if not empty)
+  std::vector<std::vector<double>> m_BinEdges ;
+
   //--------------------------------------------------------------
   public:
   /// Default Constructor
@@ -34,15 +37,25 @@ class SatBundle : public Prog
 
   /// Copy Constructor
   SatBundle(const SatBundle& other) 
-  : Prog("SatBundle", true), m_BinPeriods(other.m_BinPeriods)
+  : Prog("SatBundle", true), m_BinPeriods(other.m_BinPeriods),
+    m_BinEdges(other.m_BinEdges)
   {
     if(other.m_SatPtr)
       m_SatPtr = other.m_SatPtr->Clone() ;
   }
 
+  /// Move Constructor (takes over the satellite, no cloning)
+  SatBundle(SatBundle&& other) noexcept
+  : Prog("SatBundle", true), m_SatPtr(std::move(other.m_SatPtr)),
+    m_BinPeriods(std::move(other.m_BinPeriods)),
+    m_BinEdges(std::move(other.m_BinEdges)) {}
+
   /// Assignment Operator
   SatBundle& operator=(const SatBundle&) ;
 
+  /// Move Assignment Operator
+  SatBundle& operator=(SatBundle&&) noexcept ;
+
   /// Arrow '->' Operator
   std::shared_ptr<Satellite> operator->() 
   {
@@ -51,12 +64,19 @@ class SatBundle : public Prog
 
   void SetBinPeriod(const std::vector<int>&) ;
 
+  /// Sets the time bin edges of each bin, which replace its period
+  ///  (an empty set keeps the period)
+  void SetBinEdges(const std::vector<std::vector<double>>&) ;
+
   /// Gets the satellite pointer
   std::shared_ptr<Satellite> GetSatellite() ;
 
   /// Gets the bin periods
   std::vector<int> GetBinPeriod() const ;
 
+  /// Gets the time bin edges
+  std::vector<std::vector<double>> GetBinEdges() const ;
+
   /// Gets the timed i-th energy bin with the j-th time binning 
   Bin GetTimeBin(const size_t& e_i, const size_t& t_j) ;
 };
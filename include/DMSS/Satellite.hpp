@@ -109,9 +109,32 @@ class Satellite : public Prog
     
     void TimeBin(int bin_period) ;
 
+    /// Time bins with arbitrary edges (in days from the start)
+    void TimeBin(const std::vector<double>& edges) ;
+
+    /// The exposure between t_0 & t_1 (in days from the start),
+    ///  from the cumulative sum (linear within a day)
+    double Exposure(const double& t_0, const double& t_1) const ;
+
+    /// Edges (whole days) of 'n_bins' bins with equal exposures,
+    ///  i.e. equal expected signals
+    std::vector<double> ExposureEdges(const size_t& n_bins) const ;
+
+    /// The fewest edges (whole days) that keep the information on
+    ///  the signal strength within a fraction 'max_loss' of the
+    ///  daily bins' (Bayesian blocks on the exposure)
+    std::vector<double> InfoEdges(const double& max_loss) const ;
+
     /// Evaluates the exposure to the Sun given initial & final dates
     void EvaluateExposure(const Zaki::Physics::Date&, const Zaki::Physics::Date&) ;
 
+    /// Same as 'EvaluateExposure', but the daily exposure is kept in
+    ///  a store file (per orbit), and only the days missing from it
+    ///  are evaluated and added (e.g. when the time range grows,
+    ///  at either end)
+    void ExtendExposure(const Zaki::Physics::Date&, const Zaki::Physics::Date&,
+                        const Zaki::String::Directory& store) ;
+
     /// Exports the exposure into a file
     void ExportExposure(const Zaki::String::Directory&, 
           const Zaki::File::FileMode& = Zaki::File::FileMode::Write) ;
@@ -160,7 +183,7 @@ class Satellite : public Prog
     TH1F GetSigShape(double energy)   const ;
 
     /// returns the satellite's data
-    Data GetData()                    const ;
+    const Data& GetData()             const ;
 
     /// see SetKappa()
     double GetMultiplicity(const std::vector<DMSolarSignal::Particle>&) const ;
@@ -271,6 +294,26 @@ class Satellite : public Prog
 
     std::vector<double> exposure_set ;
 
+    /// Integrates the exposure of the days [first, last) after t_0
+    std::vector<double> DailyExposure(const double& t_0, const size_t& first, 
+                                      const size_t& last) ;
+
+    /// Fills the exposure histogram with the daily exposure 
+    ///  over 'span' days (rounded up, as in 'EvaluateExposure'),
+    ///  and returns the total
+    double FillExposure(const std::vector<double>&, const double& span) ;
+
+    /// The cumulative exposure over the days (exp_sum[d] is the
+    ///  exposure before day d)
+    std::vector<double> exp_sum ;
+
+    /// Sets 'exp_sum' from the exposure histogram
+    void SumExposure() ;
+
+    /// Describes the orbit & the field of view (the daily exposure
+    ///  doesn't depend on anything else)
+    std::string OrbitSignature() const ;
+
     /// Exposure histogram (deep cloned via the 'Clone()' method.)
     TH1F exp_hist ;
 
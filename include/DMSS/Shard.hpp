@@ -0,0 +1,36 @@
+#ifndef DMSS_Shard_H
+#define DMSS_Shard_H
+
+#include <string>
+
+//==============================================================
+/// Splits a campaign between several processes (or batch jobs
+///  on a shared filesystem). The units of work (fits, scans and
+///  grid tiles) are numbered, and shard 'index' of 'count' does
+///  the units with 'unit % count == index'. The shards only
+///  communicate through their files, which a merge run combines.
+struct Shard
+{
+  size_t index = 0 ;
+  size_t count = 1 ;
+
+  /// Number of tiles in the grid of each contour plane
+  size_t tiles = 1 ;
+
+  /// Combines the results of the shards
+  bool merge = false ;
+
+  /// Returns if only a part of the campaign runs here
+  bool Partial() const { return count > 1 && !merge ; }
+
+  /// Returns if the unit is left to another shard
+  bool Skips(const size_t& unit) const
+  { return Partial() && unit % count != index ; }
+
+  /// e.g. "2_of_8"
+  std::string Tag() const
+  { return std::to_string(index) + "_of_" + std::to_string(count) ; }
+};
+
+//==============================================================
+#endif /*DMSS_Shard_H*/
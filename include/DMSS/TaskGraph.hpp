@@ -0,0 +1,82 @@
+#ifndef DMSS_TaskGraph_H
+#define DMSS_TaskGraph_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "DMSS/Prog.hpp"
+
+//==============================================================
+/// Dependency graph of run steps.
+///  Steps run as soon as their dependencies are done, and the
+///  independent ones run concurrently on the 'TaskPool'.
+///  A step that produces files is skipped if its stamp (kept in
+///  the work directory) shows it already ran with the same
+///  signature, and nothing it depends on changed since.
+class TaskGraph : public Prog
+{
+  //--------------------------------------------------------------
+  public:
+
+    /// A step of the run
+    struct Node
+    {
+      std::string name ;
+
+      /// Names of the steps that should run first
+      std::vector<std::string> deps ;
+
+      /// Files the step reads
+      std::vector<Zaki::String::Directory> inputs ;
+
+      /// Files the step writes
+      std::vector<Zaki::String::Directory> outputs ;
+
+      /// The settings the outputs depend on
+      std::string signature ;
+
+      /// If true, the step only changes objects in memory, so it
+      ///  always runs when a step that depends on it runs
+      bool transient = false ;
+
+      std::function<void()> action ;
+    };
+
+    // Constructor
+    TaskGraph() ;
+
+    // Destructor
+    ~TaskGraph() ;
+
+    /// Adds a step
+    void Add(Node&&) ;
+
+    /// Runs the steps that aren't up to date
+    void Run() ;
+
+    /// Appended to the names of the stamp files, so that the
+    ///  processes sharing the work directory (e.g. shards)
+    ///  keep their own stamps
+    void SetStampSuffix(const std::string&) ;
+
+  //--------------------------------------------------------------
+  private:
+
+    std::vector<Node> nodes ;
+
+    std::string stamp_suffix = "" ;
+
+    /// The stamp file of a step
+    Zaki::String::Directory StampFile(const Node&) const ;
+
+    /// Returns if the step's outputs are up to date
+    bool UpToDate(const size_t&, const std::vector<std::vector<size_t>>&) const ;
+
+    /// Sorts the steps so that the dependencies come first
+    ///  (exits on missing dependencies & cycles)
+    std::vector<size_t> Sort(std::vector<std::vector<size_t>>&) const ;
+};
+
+//==============================================================
+#endif /*DMSS_TaskGraph_H*/
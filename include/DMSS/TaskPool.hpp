@@ -0,0 +1,82 @@
+#ifndef DMSS_TaskPool_H
+#define DMSS_TaskPool_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//==============================================================
+/// Process-wide work-stealing scheduler.
+///  Every worker has its own task deque: it takes its own tasks
+///  from the back, and steals from the front of the others' when
+///  it runs out. Tasks from non-worker threads go into a shared
+///  deque that all the workers steal from.
+///  'ParallelFor' blocks until all iterations are done, and the
+///  calling thread helps out, so it can be nested safely.
+///  The pool is sized from the cores available to the process
+///  (the affinity mask), or from 'DMSS_NUM_THREADS' if it is set.
+class TaskPool
+{
+  //--------------------------------------------------------------
+  public:
+    /// The shared pool (created on first use)
+    static TaskPool& Get() ;
+
+    /// Number of cores available to the process
+    static size_t CoreCount() ;
+
+    /// Number of threads that work on a parallel loop
+    ///  (workers + the calling thread)
+    size_t Size() const ;
+
+    /// Runs f(0), ..., f(n-1) in parallel
+    void ParallelFor(size_t n, const std::function<void(size_t)>& f) ;
+
+    TaskPool(const TaskPool&) = delete ;
+    TaskPool& operator=(const TaskPool&) = delete ;
+
+  //--------------------------------------------------------------
+  private:
+    using Task = std::function<void()> ;
+
+    struct Queue
+    {
+      std::mutex mtx ;
+      std::deque<Task> tasks ;
+    };
+
+    TaskPool(size_t n_workers) ;
+    ~TaskPool() ;
+
+    /// The worker's main loop
+    void WorkerLoop(size_t idx) ;
+
+    /// The deque of the calling thread
+    size_t QueueIdx() const ;
+
+    /// Queues a task on the calling thread's deque
+    void Push(Task&&) ;
+
+    /// Takes a task from the own deque, or steals one
+    bool TryPop(size_t self, Task&) ;
+
+    /// Runs one queued task if there is any
+    bool RunOne() ;
+
+    /// Deques of the workers, and the shared one at the end
+    std::vector<std::unique_ptr<Queue>> queues ;
+    std::vector<std::thread> workers ;
+
+    std::atomic<size_t> pending = 0 ;
+    std::mutex sleep_mtx ;
+    std::condition_variable cv ;
+    bool stop = false ;
+};
+
+//==============================================================
+#endif /*DMSS_TaskPool_H*/
@@ -0,0 +1,108 @@
+#ifndef DMSS_ToyMC_H
+#define DMSS_ToyMC_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "DMSS/Prog.hpp"
+
+//==============================================================
+/// Counter-based random stream: the i-th number of stream 's'
+///  is a hash of (seed, s, i), so a toy always gets the same
+///  numbers, no matter which thread runs it, or in what order.
+class ToyRNG
+{
+  //--------------------------------------------------------------
+  public:
+    typedef uint64_t result_type ;
+
+    ToyRNG(const uint64_t& seed, const uint64_t& stream) ;
+
+    static constexpr result_type min() { return 0 ; }
+    static constexpr result_type max() { return UINT64_MAX ; }
+
+    /// The next number of the stream
+    result_type operator()() ;
+
+    /// Uniform in (0, 1)
+    double Uniform() ;
+
+    /// Poisson distributed with the given mean
+    uint64_t Poisson(const double& mean) ;
+
+  //--------------------------------------------------------------
+  private:
+    uint64_t key ;
+    uint64_t counter = 0 ;
+};
+
+//==============================================================
+/// Summary of a statistic over the toys
+struct ToyStat
+{
+  /// Number of the toys with a valid (not NaN) value
+  size_t n = 0 ;
+  size_t n_failed = 0 ;
+
+  double mean = 0, std_dev = 0 ;
+  double min = 0, max = 0 ;
+
+  /// Quantiles at -2, -1, 0, +1, +2 sigma (median in the middle)
+  std::array<double, 5> band = {0, 0, 0, 0, 0} ;
+};
+
+//==============================================================
+/// Runs pseudo-experiments in parallel. Every toy has its own
+///  random stream (seeded by the toy number), and fills a set
+///  of statistics (e.g. the limit for each binning). Only the
+///  statistics are kept, and they are summarized in the toy
+///  order, so the results don't depend on the thread count.
+class ToyMC : public Prog
+{
+  //--------------------------------------------------------------
+  public:
+    /// Runs one toy: fills the statistics from the random stream
+    typedef std::function<void(ToyRNG&, std::vector<double>&)> Toy ;
+
+    // Constructor
+    ToyMC(const uint64_t& seed, const std::vector<std::string>& stat_names) ;
+
+    // Destructor
+    ~ToyMC() ;
+
+    /// Runs toys [first, first + n_toys) in parallel. 'make_toy'
+    ///  is called once per chunk of toys, so the toy can keep its
+    ///  workspace (histograms, likelihoods, ...) between the toys.
+    void Run(const size_t& n_toys, const std::function<Toy()>& make_toy,
+             const size_t& first=0) ;
+
+    /// Number of the toys that have run
+    size_t Size() const ;
+
+    /// Values of a statistic (one per toy, NaN if the toy failed)
+    std::vector<double> GetValues(const size_t& stat_idx) const ;
+
+    /// Summary of a statistic
+    ToyStat GetStat(const size_t& stat_idx) const ;
+
+    /// Exports the summary of every statistic (one per line)
+    void ExportSummary(const Zaki::String::Directory&) const ;
+
+    /// Exports the statistics of every toy (one per line)
+    void ExportToys(const Zaki::String::Directory&) const ;
+
+  //--------------------------------------------------------------
+  private:
+    uint64_t seed ;
+    std::vector<std::string> stat_names ;
+
+    /// Statistics of the toys (toy-major), and the toy numbers
+    std::vector<double> vals ;
+    std::vector<size_t> toy_ids ;
+};
+
+//==============================================================
+#endif /*DMSS_ToyMC_H*/
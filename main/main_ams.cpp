@@ -8,9 +8,9 @@
 */
 
 #include <Zaki/File/VecSaver.hpp>
-#include <Zaki/Util/ObjObserver.hpp>
 
 // Local headers
+#include "DMSS/ObjTracker.hpp"
 #include "DMSS/AMS.hpp"
 #include "DMSS/Analysis.hpp"
 #include "DMSS/GenericModel.hpp"
@@ -40,7 +40,7 @@ int main() {
   Instrumentor::BeginSession("Main", dir +"/results/AMS"+folder_name+"/AMS_Profile.json");
 #endif
 
-  ObjManager::SetFile(dir.ParentDir() +"/results/AMS"+folder_name+"/Objs_ams.txt") ;
+  ObjTracker::SetFile(dir.ParentDir() +"/results/AMS"+folder_name+"/Objs_ams.txt") ;
   LogManager::SetLogLevels(LogLevel::Info, LogLevel::Verbose) ;
   LogManager::SetLogFile(dir.ParentDir() +"/results/AMS"+folder_name+"/log_AMS_analysis.txt") ;
   // LogManager::SetBlackWhite(true) ;
@@ -110,7 +110,8 @@ int main() {
     // ....................................................
     // Exposure
 #if EVAL_EXP
-    ams->EvaluateExposure(start, end);
+    // Only the days missing from the store are evaluated
+    ams->ExtendExposure(start, end, "AMS_Exposure_Store.dat");
     ams->ExportExposure("AMS_Exposure" + time_stamp + ".dat", Zaki::File::FileMode::Write) ;
     return 0 ;
 #else
@@ -159,6 +160,9 @@ int main() {
   //  a1.FitThreshold() ;
   // a1.PlotThresh("Limits") ;
 
+  // Expected limits & bands (Asimov), e.g. for the projections
+  // a1.FitThreshAsimov(0) ;
+
   //........ Generic Model .............
   std::shared_ptr<GenericModel> genMod = std::make_shared<GenericModel>() ;
   a1.SetModel(genMod) ;
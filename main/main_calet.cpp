@@ -9,9 +9,9 @@
 
 
 #include <Zaki/File/VecSaver.hpp>
-#include <Zaki/Util/ObjObserver.hpp>
 
 // Local headers
+#include "DMSS/ObjTracker.hpp"
 #include "DMSS/CALET.hpp"
 #include "DMSS/Analysis.hpp"
 #include "DMSS/GenericModel.hpp"
@@ -35,7 +35,7 @@ int main() {
 
   Zaki::String::Directory dir(__FILE__) ;
 
-  ObjManager::SetFile(dir.ParentDir() +"/results/CALET"+folder_name+"/Objs_calet.txt") ;
+  ObjTracker::SetFile(dir.ParentDir() +"/results/CALET"+folder_name+"/Objs_calet.txt") ;
 
 #if DO_PROFILING
   Instrumentor::BeginSession("CALET",  dir +"/results/CALET"+folder_name+"/CALET_Profile.json");        // Begin session 
@@ -97,7 +97,8 @@ int main() {
   // Exposure 
 
 #if EVAL_EXP
-  calet->EvaluateExposure(start, end);
+  // Only the days missing from the store are evaluated
+  calet->ExtendExposure(start, end, "CALET_Exposure_Store.dat");
   calet->ExportExposure("CALET_Exp" + time_stamp + ".dat", Zaki::File::FileMode::Write) ;
 #else
   calet->ImportExposure("CALET_Exp" + time_stamp + ".dat") ;
@@ -8,9 +8,9 @@
 */
 
 #include <Zaki/File/VecSaver.hpp>
-#include <Zaki/Util/ObjObserver.hpp>
 
 // Local headers
+#include "DMSS/ObjTracker.hpp"
 #include "DMSS/AMS.hpp"
 #include "DMSS/DAMPE.hpp"
 #include "DMSS/CALET.hpp"
@@ -29,7 +29,7 @@ int main() {
   using namespace Zaki::Util ;
 
   Zaki::String::Directory dir(__FILE__) ;
-  ObjManager::SetFile(dir.ParentDir() +"/results/Combined/Objs_combined.txt") ;
+  ObjTracker::SetFile(dir.ParentDir() +"/results/Combined/Objs_combined.txt") ;
   
 #if DO_PROFILING
   Instrumentor::BeginSession("Main", dir +"/results/Combined/Combined_Profile.json");
@@ -8,9 +8,9 @@
 */
 
 #include <Zaki/File/VecSaver.hpp>
-#include <Zaki/Util/ObjObserver.hpp>
 
 // Local headers
+#include "DMSS/ObjTracker.hpp"
 #include "DMSS/DAMPE.hpp"
 #include "DMSS/Analysis.hpp"
 #include "DMSS/GenericModel.hpp"
@@ -33,7 +33,7 @@ int main() {
 #endif
 
   Zaki::String::Directory dir(__FILE__) ;
-  ObjManager::SetFile(dir.ParentDir() +"/results/DAMPE"+folder_name+"/Objs_dampe.txt") ;
+  ObjTracker::SetFile(dir.ParentDir() +"/results/DAMPE"+folder_name+"/Objs_dampe.txt") ;
 
 #if DO_PROFILING
   Instrumentor::BeginSession("DAMPE",  dir +"/results/DAMPE"+folder_name+"/DAMPE_Profile.json");        // Begin session 
@@ -84,7 +84,8 @@ int main() {
 
 
 #if EVAL_EXP
-  dampe->EvaluateExposure(start, end);
+  // Only the days missing from the store are evaluated
+  dampe->ExtendExposure(start, end, "DAMPE_Exposure_Store.dat");
   dampe->ExportExposure("DAMPE_Exposure" + time_stamp + ".dat", Zaki::File::FileMode::Write) ;
 #else
   dampe->ImportExposure("DAMPE_Exposure" + time_stamp + ".dat") ;
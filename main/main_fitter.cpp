@@ -8,6 +8,7 @@
 // Local headers
 #include "DMSS/Fitter.hpp"
 #include "DMSS/AMS.hpp"
+#include "DMSS/PlotQueue.hpp"
 
 
 //************//
@@ -44,7 +45,7 @@ int main() {
   
   for(size_t i=0 ; i < ams->GetData().size() ; i++)
   {
-    Bin b = ams->GetData().GetBins()[i] ;
+    Bin b = ams->GetData()[i] ;
 
     ams->TimeBin(time_bins[i]);
 
@@ -68,5 +69,8 @@ int main() {
 //  std::cout << "ams->GetNumScaling() / ams->GetExpNorm()= " << ams->GetNumScaling() / ams->GetExpNorm() << "\n" ;
   // std::cout << "mu_old * ams->GetNumScaling() / ams->GetExpNorm()= " << 12.60*ams->GetNumScaling() / ams->GetExpNorm() << "\n" ;
 
+  // The fit plots queued during the run
+  PlotQueue::Flush() ;
+
   return 0;
 }
@@ -0,0 +1,381 @@
+/*
+
+  Runs an analysis described by a configuration file, e.g.:
+
+    ./main_run ../main/run_ams.cfg
+
+  The steps (exposure, time-binning, model analyses) form a
+  dependency graph: independent steps run concurrently, and
+  steps whose outputs are up to date are skipped, so changing
+  the bin periods doesn't re-evaluate the exposure.
+
+  A campaign can be split between several processes (or batch
+  jobs on a shared filesystem), which are combined by a merge
+  run once all of them are done:
+
+    ./main_run ../main/run_ams.cfg shard 0/4
+    ...
+    ./main_run ../main/run_ams.cfg shard 3/4
+    ./main_run ../main/run_ams.cfg merge 4
+
+  Only 'DoBoost' and 'PlotParamSpaceThresh' are split, the
+  other steps run in every shard. The shards import the
+  exposure, so it should be evaluated before they start.
+
+*/
+
+#include <mutex>
+
+// Local headers
+#include "DMSS/ObjTracker.hpp"
+#include "DMSS/AMS.hpp"
+#include "DMSS/DAMPE.hpp"
+#include "DMSS/CALET.hpp"
+#include "DMSS/Analysis.hpp"
+#include "DMSS/GenericModel.hpp"
+#include "DMSS/DarkPhoton.hpp"
+#include "DMSS/RunConfig.hpp"
+#include "DMSS/TaskGraph.hpp"
+#include "DMSS/PlotQueue.hpp"
+#include "DMSS/FitCache.hpp"
+
+//--------------------------------------------------------------
+std::shared_ptr<Satellite> MakeSatellite(const std::string& type)
+{
+  if (type == "AMS")   return std::make_shared<AMS>() ;
+  if (type == "CALET") return std::make_shared<CALET>() ;
+  if (type == "DAMPE") return std::make_shared<DAMPE>() ;
+
+  Z_LOG_ERROR("Unknown satellite '" + type + "' (options: AMS, CALET, DAMPE).") ;
+  exit(EXIT_FAILURE) ;
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<Model> MakeModel(const std::string& type)
+{
+  if (type == "generic")     return std::make_shared<GenericModel>() ;
+  if (type == "dark_photon") return std::make_shared<DarkPhoton>() ;
+
+  Z_LOG_ERROR("Unknown model '" + type + "' (options: generic, dark_photon).") ;
+  exit(EXIT_FAILURE) ;
+}
+
+//--------------------------------------------------------------
+PlotMode MakePlotMode(const std::string& mode)
+{
+  if (mode == "Ldec_Gann") return PlotMode::Ldec_Gann ;
+  if (mode == "Mdm_Gann")  return PlotMode::Mdm_Gann ;
+  if (mode == "Ldec_Mdm")  return PlotMode::Ldec_Mdm ;
+
+  Z_LOG_ERROR("Unknown plot mode '" + mode + "' (options: Ldec_Gann, Mdm_Gann, Ldec_Mdm).") ;
+  exit(EXIT_FAILURE) ;
+}
+
+//--------------------------------------------------------------
+PlotQueue::Mode MakePlotQueueMode(const std::string& mode)
+{
+  if (mode == "immediate")  return PlotQueue::Mode::Immediate ;
+  if (mode == "deferred")   return PlotQueue::Mode::Deferred ;
+  if (mode == "background") return PlotQueue::Mode::Background ;
+  if (mode == "headless")   return PlotQueue::Mode::Headless ;
+
+  Z_LOG_ERROR("Unknown plots '" + mode + "' (options: immediate, deferred, background, headless).") ;
+  exit(EXIT_FAILURE) ;
+}
+
+//--------------------------------------------------------------
+/// "2011-05-19" -> Date
+Zaki::Physics::Date MakeDate(const std::string& in)
+{
+  int yr, mo, day ;
+  if (sscanf(in.c_str(), "%d-%d-%d", &yr, &mo, &day) != 3)
+  {
+    Z_LOG_ERROR("Date '" + in + "' should be in the 'YYYY-MM-DD' form.") ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  return {yr, mo, day, {0, 0, 0}} ;
+}
+
+//************//
+//    MAIN
+//************//
+int main(int argc, char** argv) {
+
+  using namespace Zaki::Util ;
+
+  // ............ Shard mode ............
+  size_t shard_idx = 0, shard_count = 1 ;
+  bool shard_merge = false ;
+  bool args_ok = argc == 2 ;
+  if (argc == 4 && std::string(argv[2]) == "shard")
+    args_ok = sscanf(argv[3], "%zu/%zu", &shard_idx, &shard_count) == 2 
+              && shard_idx < shard_count ;
+  else if (argc == 4 && std::string(argv[2]) == "merge")
+  {
+    shard_merge = true ;
+    args_ok = sscanf(argv[3], "%zu", &shard_count) == 1 && shard_count > 0 ;
+  }
+
+  if (!args_ok)
+  {
+    Z_LOG_ERROR("Usage: main_run <configuration file> [shard <index>/<count> | merge <count>]") ;
+    return EXIT_FAILURE ;
+  }
+  bool sharded = shard_count > 1 || shard_merge ;
+  // ..................................
+
+  Zaki::String::Directory dir(__FILE__) ;
+
+  RunConfig cfg ;
+  cfg.Parse(argv[1]) ;
+
+  const RunConfig::Section& run = cfg.GetSection("run") ;
+  Zaki::String::Directory res_dir = dir.ParentDir() + "/" + run.Get("results", "results") ;
+
+  ObjTracker::SetFile(res_dir + "/Objs_run.txt") ;
+  LogManager::SetLogLevels(LogLevel::Info, LogLevel::Verbose) ;
+  // The shards write their own logs
+  std::string log_tag = "" ;
+  if (sharded)
+    log_tag = shard_merge ? ".merge" : "." + std::to_string(shard_idx) + "_of_" + std::to_string(shard_count) ;
+  LogManager::SetLogFile(res_dir + "/" + run.Get("log_file", "log_run.txt") + log_tag) ;
+
+  Z_TIMER_SCOPE("run_main") ;
+
+  //.......................
+  // Analysis
+  //.......................
+  Analysis a1 ;
+  a1.SetName(run.Get("name", "DMSS Analysis")) ;
+  a1.SetWrkDir(res_dir) ;
+  a1.SetECut(run.GetDouble("e_cut", 50)) ;
+  a1.SetPlotMode(MakePlotMode(run.Get("plot_mode", "Ldec_Gann"))) ;
+  a1.SetFastLimits(run.Get("fast_limits", "false") == "true") ;
+  a1.SetFitChain((size_t)run.GetDouble("fit_chain", 1)) ;
+  a1.SetCLsToys((size_t)run.GetDouble("cls_toys_min", 500),
+                (size_t)run.GetDouble("cls_toys_max", 8000)) ;
+  a1.SetCLsSeed(std::stoull(run.Get("cls_seed", "0"))) ;
+
+  // Identical fits are looked up (also the ones of the previous runs)
+  FitCache::Get().SetCapacity((size_t)run.GetDouble("fit_cache_size", 4096)) ;
+  if (run.Has("fit_cache"))
+    FitCache::Get().Open(res_dir + "/" + run.Get("fit_cache")) ;
+  if (run.Has("plots"))
+    PlotQueue::SetMode(MakePlotQueueMode(run.Get("plots"))) ;
+
+  // Finished fits & scans are recorded, and skipped if resuming
+  if (run.Has("checkpoint"))
+    a1.SetCheckpoint(res_dir + "/" + run.Get("checkpoint"),
+                     run.Get("resume", "false") == "true") ;
+
+  // Each shard (and the merge) keeps its own records
+  size_t shard_tiles = (size_t)run.GetDouble("shard_tiles", 0) ;
+  if (shard_merge)
+    a1.SetShardMerge(shard_count, shard_tiles) ;
+  else if (sharded)
+    a1.SetShard(shard_idx, shard_count, shard_tiles) ;
+
+  TaskGraph graph ;
+  graph.SetWrkDir(res_dir) ;
+  // The shards (and the merge) share the work directory
+  graph.SetStampSuffix(log_tag) ;
+
+  // Everything that the analysis results depend on
+  //  (the shards' runs differ as well), but not the
+  //  plots, logs, caches & checkpoints
+  std::string data_sig = run.Signature({"e_cut", "plot_mode", "fast_limits",
+                                        "fit_chain", "cls_toys_min",
+                                        "cls_toys_max", "cls_seed",
+                                        "shard_tiles"}) ;
+  if (sharded)
+    data_sig += shard_merge ? " merge " + std::string(argv[3]) 
+                            : " shard " + std::string(argv[3]) ;
+  std::vector<std::string> prep_steps ;
+
+  //.......................
+  // Satellites
+  //.......................
+  std::vector<const RunConfig::Section*> sat_secs = cfg.GetSections("satellite") ;
+  for (size_t sat_idx = 0 ; sat_idx < sat_secs.size() ; ++sat_idx)
+  {
+    const RunConfig::Section& sec = *sat_secs[sat_idx] ;
+    std::shared_ptr<Satellite> sat = MakeSatellite(sec.label) ;
+
+    if (sec.Has("name"))
+      sat->SetName(sec.Get("name")) ;
+
+    std::vector<std::string> dur = sec.GetWords("time_duration") ;
+    if (dur.size() == 1 && dur[0] == "actual")
+      sat->SetTimeDuration(sat->GetActualTimeDuration()) ;
+    else if (dur.size() == 2)
+      sat->SetTimeDuration({MakeDate(dur[0]), MakeDate(dur[1])}) ;
+    else
+    {
+      Z_LOG_ERROR("'time_duration' should be 'actual' or 'YYYY-MM-DD YYYY-MM-DD'.") ;
+      exit(EXIT_FAILURE) ;
+    }
+
+    a1.AttachSatellite(sat) ;
+    a1.SetBinPeriod(sat_idx, sec.GetInts("bin_period")) ;
+
+    Zaki::Physics::Date start = sat->GetTimeDuration().start ;
+    Zaki::Physics::Date end   = sat->GetTimeDuration().end ;
+
+    // Setting the time stamp for the file names
+    char tmp[150] ;
+    sprintf(tmp, "_%s_%s", start.StrForm("#b#Y").c_str(),
+            end.StrForm("#b#Y").c_str()) ;
+    std::string time_stamp(tmp) ;
+
+    std::string exp_file = sec.Get("exposure_file",
+                                   sat->GetName() + "_Exposure" + time_stamp + ".dat") ;
+    Zaki::String::Directory exp_path = sat->GetWrkDir() + "/" + exp_file ;
+
+    // ............ Exposure ............
+    std::vector<std::string> prep_deps ;
+    // The shards would evaluate the same exposure at the same time
+    if (sharded)
+      Z_LOG_INFO("Shard mode: importing the exposure from '" + exp_path.Str() + "'.") ;
+    else if (sec.Get("exposure", "import") == "evaluate" ||
+             sec.Get("exposure", "import") == "extend")
+    {
+      // The daily exposure of the earlier runs is only extended
+      //  to the new days, when the time range grows
+      std::string exp_store = "" ;
+      if (sec.Get("exposure") == "extend")
+        exp_store = sec.Get("exposure_store", sat->GetName() + "_Exposure_Store.dat") ;
+
+      // Only depends on the time range, not on the binning
+      graph.Add({"exposure:" + sat->GetName(), {}, {}, {exp_path},
+                 sec.label + " " + sat->GetName() + " " + sec.Get("time_duration"),
+                 false,
+                 [sat, start, end, exp_file, exp_store]()
+                 {
+                   if (exp_store.empty())
+                     sat->EvaluateExposure(start, end) ;
+                   else
+                     sat->ExtendExposure(start, end, exp_store) ;
+                   sat->ExportExposure(exp_file, Zaki::File::FileMode::Write) ;
+                 }}) ;
+      prep_deps.push_back("exposure:" + sat->GetName()) ;
+    }
+    // ..................................
+
+    // ............ Time-binning ............
+    int time_bin = (int)sec.GetDouble("time_bin") ;
+    bool plots   = sec.Get("plots", "false") == "true" ;
+
+    // Variable-width time bins (replacing the bin periods), with
+    //  equal exposures, or the fewest within an information loss
+    std::vector<std::string> edge_rule ;
+    if (sec.Has("time_edges"))
+    {
+      edge_rule = sec.GetWords("time_edges") ;
+      if (edge_rule.size() != 2 || (edge_rule[0] != "exposure" && edge_rule[0] != "information"))
+      {
+        Z_LOG_ERROR("'time_edges' should be 'exposure <bins>' or 'information <max loss>'.") ;
+        exit(EXIT_FAILURE) ;
+      }
+    }
+
+    graph.Add({"prepare:" + sat->GetName(), prep_deps, {exp_path}, {}, "", true,
+               [&a1, sat_idx, sat, exp_file, time_bin, edge_rule, plots, time_stamp]()
+               {
+                 sat->ImportExposure(exp_file) ;
+                 sat->NormalizeExposure() ;
+                 sat->TimeBin(time_bin) ;
+
+                 if (!edge_rule.empty())
+                 {
+                   std::vector<double> edges = edge_rule[0] == "exposure" 
+                          ? sat->ExposureEdges(std::stoul(edge_rule[1]))
+                          : sat->InfoEdges(std::stod(edge_rule[1])) ;
+                   Z_LOG_INFO(sat->GetName() + ": " + std::to_string(edges.size() - 1) 
+                              + " variable-width time bins.") ;
+
+                   a1.SetBinEdges(sat_idx, std::vector<std::vector<double>>(
+                                    sat->GetData().GetBins().size(), edges)) ;
+                 }
+
+                 if (plots && !PlotQueue::Headless())
+                 {
+                   // ROOT graphics aren't thread-safe
+                   std::unique_lock<std::mutex> lock = PlotQueue::Lock() ;
+
+                   sat->PlotExposure("Exposure" + time_stamp, 900) ;
+                   sat->PlotSigShape(sat->GetName() + "_Sig_Shape" + time_stamp) ;
+                 }
+               }}) ;
+    prep_steps.push_back("prepare:" + sat->GetName()) ;
+    // ..................................
+
+    data_sig += " " + sec.Signature() ;
+  }
+
+  //.......................
+  // Models
+  //.......................
+  // The models share the analysis, so they run one after the other
+  std::string prev_step = "" ;
+  for (const RunConfig::Section* sec : cfg.GetSections("model"))
+  {
+    std::string step_name = "model:" + sec->label ;
+    std::vector<std::string> deps = prep_steps ;
+    if (!prev_step.empty())
+      deps.push_back(prev_step) ;
+
+    // The result files of the steps, so that they are 
+    //  remade if any of them is deleted
+    std::vector<Zaki::String::Directory> outputs ;
+    {
+      std::shared_ptr<Model> model = MakeModel(sec->label) ;
+      if (sec->Has("dm_mass"))
+        model->SetDMMass(sec->GetDoubles("dm_mass")) ;
+
+      size_t sat_idx = (size_t)sec->GetDouble("sat_idx", 0) ;
+      for (auto&& step : sec->GetWords("steps"))
+        for (auto&& f : a1.ResultFiles(step, sat_idx, *model))
+          outputs.push_back(f) ;
+    }
+
+    graph.Add({step_name, deps, {}, outputs, data_sig + " " + sec->Signature(), false,
+               [&a1, sec]()
+               {
+                 std::shared_ptr<Model> model = MakeModel(sec->label) ;
+                 a1.SetModel(model) ;
+
+                 if (sec->Has("dm_mass"))
+                   model->SetDMMass(sec->GetDoubles("dm_mass")) ;
+
+                 size_t sat_idx = (size_t)sec->GetDouble("sat_idx", 0) ;
+                 for (auto&& step : sec->GetWords("steps"))
+                 {
+                   if      (step == "DoBoost")              a1.DoBoost() ;
+                   else if (step == "DoThresh")             a1.DoThresh(sat_idx) ;
+                   else if (step == "DoThreshMinuit")       a1.DoThreshMinuit(sat_idx) ;
+                   else if (step == "FitThreshAsimov")      a1.FitThreshAsimov(sat_idx) ;
+                   else if (step == "FitThreshCLs")         a1.FitThreshCLs(sat_idx) ;
+                   else if (step == "OptimizeBinPeriods")
+                     a1.OptimizeBinPeriods(sat_idx, 
+                                           sec->GetInts("period_candidates"),
+                                           sec->GetDouble("period_prune", 1.5)) ;
+                   else if (step == "PlotParamSpaceBoost")  a1.PlotParamSpaceBoost(sat_idx) ;
+                   else if (step == "PlotParamSpaceThresh") a1.PlotParamSpaceThresh(sat_idx) ;
+                   else
+                   {
+                     Z_LOG_ERROR("Unknown step '" + step + "'.") ;
+                     exit(EXIT_FAILURE) ;
+                   }
+                 }
+               }}) ;
+    prev_step = step_name ;
+  }
+
+  graph.Run() ;
+
+  // The plots queued during the run
+  PlotQueue::Flush() ;
+
+  return 0;
+}
@@ -1,29 +1,46 @@
-/* 
+/*
 
-  Assuming a constant background, and a randomly 
+  Assuming a constant background, and a randomly
    (const) generated data, and an oscillating signal,
    we find the 95% limit on the signal strength.
    We vary the time-binning and check how the limit changes.
 
   - Last updated by Zaki Nov 23, 2020
 
+  The toys run in parallel, each with its own random stream,
+   so the results only depend on the seed:
+
+    ./time_binning [n_toys=100] [seed=1]
+
+  Only the limits are kept (the summary and the limits of each
+   toy), the signal plot is rendered by the plot queue, e.g. with
+   'DMSS_PLOT_MODE=background' (or 'headless' to skip it).
+
+  Each binning is fitted by the Poisson fitter, and only if it
+   fails by Migrad & Minos, which start from the minimum of the
+   previous Minuit fit of the toy.
+
 */
 
 // #include <Zaki/File/VecSaver.hpp>
-#include <Zaki/Util/ObjObserver.hpp>
 #include <Zaki/File/VecSaver.hpp>
 
 // Local headers
+#include "DMSS/ObjTracker.hpp"
 #include "DMSS/Bin.hpp"
 #include "DMSS/LogLikeli.hpp"
+#include "DMSS/PlotQueue.hpp"
+#include "DMSS/ToyMC.hpp"
+#include "DMSS/FitSeed.hpp"
+#include "DMSS/PoissonFitter.hpp"
 // #include "DMSS/GenericModel.hpp"
 // #include "DMSS/DarkPhoton.hpp"
 // #include "DMSS/Prog.hpp"
 
+#include <TROOT.h>
 #include <TH1.h>
 #include <TF1.h>
 #include <TCanvas.h>
-#include <TRandom3.h>
 // #include <TRandom.h>
 
 #include <Math/QuantFuncMathMore.h>
@@ -46,210 +63,198 @@
 //************//
 //    MAIN
 //************//
-int main() {
-  
+int main(int argc, char* argv[]) {
+
   using namespace Zaki::Util ;
 
 
   Zaki::String::Directory dir(__FILE__) ;
 
 
-  ObjManager::SetFile(dir.ParentDir() +"/results/Time_Binning/Objs_time_binning.txt") ;
+  ObjTracker::SetFile(dir.ParentDir() +"/results/Time_Binning/Objs_time_binning.txt") ;
   LogManager::SetLogLevels(LogLevel::Info, LogLevel::Verbose) ;
   LogManager::SetLogFile(dir.ParentDir() +"/results/Time_Binning/log_time_binning.txt") ;
   // LogManager::SetBlackWhite(true) ;
 
+  // Allowing concurrent histogram creation in ROOT
+  ROOT::EnableThreadSafety() ;
 
   size_t n_bins = 100 ;
+  size_t n_events = 1000 ;
   double sig_period = 35 ;
 
-for (size_t j = 0; j < 100; j++)
-{
-  gRandom = new TRandom3(0);
-  //......................................................
-  // Data
-  TH1F h_obs("Events", "Events", n_bins, 0, 100) ;
-
-  TF1 *mygaus = new TF1("flat","1", 0, 100);
-  h_obs.FillRandom("flat", 1000) ;
-  // hh.Scale( 1.0/hh.GetNormFactor() ) ;
-  
-  // std::vector<Zaki::Math::Quantity> two_bin_obs_set = { {0, 0}, {0, 0} };
-
-  // for (size_t i = 0; i < n_bins; i += 2)
-  // {
-  //   two_bin_obs_set[0].val += obs_set[i].val ;
-  //   two_bin_obs_set[1].val += obs_set[i+1].val ;
-  // }
-  //......................................................
+  size_t n_toys = argc > 1 ? std::stoul(argv[1]) : 100 ;
+  uint64_t seed = argc > 2 ? std::stoull(argv[2]) : 1 ;
+
+  Zaki::String::Directory out_dir = dir.ParentDir() +"/results/Time_Binning/T_"
+                                    + std::to_string((int)sig_period) ;
 
   //......................................................
-  // Signal
+  // Signal (the same in all the toys)
   TH1F hsig("signal", "sig", n_bins, 0, 100) ;
+  hsig.SetDirectory(nullptr) ;
 
-  TF1 *sinsig = new TF1("sinsig","sin(2*pi*x/[0]) + 1", 0, 100);
+  TF1 sinsig("sinsig","sin(2*pi*x/[0]) + 1", 0, 100);
 
-  sinsig->SetParameter(0, sig_period);
+  sinsig.SetParameter(0, sig_period);
 
   for (size_t i = 0; i < 100; i++)
   {
-    hsig.AddBinContent(i+1, sinsig->Integral(i, i+1)) ;
+    hsig.AddBinContent(i+1, sinsig.Integral(i, i+1)) ;
   }
   // hsig.FillRandom("sinsig", 1000) ;
   hsig.Scale(10) ;
-
-
-
-  // TH1F two_bin_sig("signal_2b", "sig2b", 2, 0, 100) ;
-  // std::pair<double, double> tmp_sig_2_bins = {0, 0} ;
-  // for (size_t i = 0; i < n_bins; i += 2)
-  // {
-  //   tmp_sig_2_bins.first += hsig.GetBinContent(i+1) ;
-  //   tmp_sig_2_bins.second += hsig.GetBinContent(i+2) ;
-  // }
-  // two_bin_sig.SetBinContent(1, tmp_sig_2_bins.first) ;
-  // two_bin_sig.SetBinContent(2, tmp_sig_2_bins.second) ;
   //......................................................
 
   //......................................................
   // Plotting
-  TCanvas c1("c1", "Sin-Flat", 1000, 800) ;
-
   hsig.SetLineColor(kRed) ;
-  hsig.Draw() ; 
-  
-  h_obs.Draw("same") ;
 
-  c1.SaveAs((dir.ParentDir() +"/results/Time_Binning/T_"+ std::to_string((int)sig_period) + "/Sin_Flat_"
-              +std::to_string(n_bins)+".pdf").Str().c_str()) ;
+  PlotQueue::Push([hsig, out_file = (out_dir + "/Sin_Signal_"
+                                      + std::to_string(n_bins)+".pdf").Str()]() mutable
+  {
+    TCanvas c1("c1", "Sin-Flat", 1000, 800) ;
+
+    hsig.Draw() ;
+
+    c1.SaveAs(out_file.c_str()) ;
+  }) ;
   //......................................................
-  std::vector<std::vector<double> > fit_results; fit_results.reserve(50) ;
+
   std::vector<double> bin_period_set = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
                                         13, 14, 15, 16, 17, 18, 19, 21, 22,
                                         23, 24, 25, 30, 40, 50, 100} ;
 
+  //......................................................
+  // The likelihood of each binning (copied into the toys' workspaces)
+  // -2Log & chi2 have the same normalization:
+  double err_def = ROOT::MathMore::chisquared_quantile(0.95, 2) ;
+
+  std::vector<ROOT::Minuit2::LogLikeli> fcn_set(bin_period_set.size()) ;
+  std::vector<std::vector<double>> sig_set(bin_period_set.size()) ;
+  std::vector<std::string> stat_names ;
   for (size_t i = 0; i < bin_period_set.size(); i++)
   {
-    
     double bin_period = bin_period_set[i] ;
 
     TH1F sig_shape_hist = *(TH1F*)(hsig.Clone(("sig_shape_"+std::to_string(bin_period)).c_str()));
+    sig_shape_hist.SetDirectory(nullptr) ;
     sig_shape_hist.Rebin(bin_period);
 
     double scale_factor = 1.0 / sig_shape_hist.Integral();
     sig_shape_hist.Scale(100*scale_factor) ;
 
+    fcn_set[i].AddSigShape(sig_shape_hist) ;
+    fcn_set[i].SetErrorDef(err_def) ;
 
-    TH1F h_obs_rebin = *(TH1F*)(h_obs.Clone(("obs_"+std::to_string(bin_period)).c_str()));
-    h_obs_rebin.Rebin(bin_period) ;
-
-    std::vector<Zaki::Math::Quantity> obs_set ; 
-    for (size_t i = 0; i < (1.0*n_bins) / bin_period; i++)
-    {
-      obs_set.push_back({h_obs_rebin.GetBinContent(i+1), h_obs_rebin.GetBinError(i+1)}) ;
-    }
-
-    // Bin b({100, 200}, {150, 5}, {},) ;  
-    // size_t chops = hsig.GetSize() -2  ;
-    // b.divide(chops);
-
-    ROOT::Minuit2::LogLikeli  fcn;
-
-    fcn.AddObsSet(obs_set) ;
-    fcn.AddSigShape(sig_shape_hist)  ;
+    for (int j = 1; j <= sig_shape_hist.GetNbinsX(); j++)
+      sig_set[i].push_back(sig_shape_hist.GetBinContent(j)) ;
 
+    stat_names.emplace_back("T=" + std::to_string((int)bin_period)) ;
+  }
+  //......................................................
 
-    // fcn.AddObsSet(two_bin_obs_set) ;
-    // fcn.AddSigShape(two_bin_sig) ;
-    //......................................................
-    //  Minimize
-    //......................................................
-
-    //(para_name, para_start_value, para_uncertainties)
-    ROOT::Minuit2::MnUserParameters upar ;
-    upar.Add("mu", 1e-1, 1e-1);
-    upar.Add("bg", bin_period*(1000.0/n_bins), 2);
-
-    // set limits
-    upar.SetLowerLimit("mu", 0);
-    upar.SetLowerLimit("bg", 0);
-
-    // Creat MIGRAD minimizer
-    int strategy_counter = 2 ;
-    ROOT::Minuit2::MnMigrad migrad(fcn, upar, strategy_counter);
-
-    // Minimize
-    ROOT::Minuit2::FunctionMinimum min = migrad();
-
-    // output
-    std::cout<<"minimum: "<<min<<std::endl;
-
-    //......................................................
-    // ****************
-    //  Error analysis
-    // ****************
-    // MINOS Error analysis
-    ROOT::Minuit2::MnMinos Minos(fcn, min);
-
-    // MINOS errors
-    // -2Log & chi2 have the same normalization:
-    // Zaki::Math::NDimContLevel cont_level((int)upar.Params().size(), conf_level) ;
-    // fcn.SetErrorDef(cont_level.Solve().Up);
-    fcn.SetErrorDef(ROOT::MathMore::chisquared_quantile(0.95,
-                    (int)upar.Params().size())) ;
-
-    ROOT::Minuit2::MinosError e0 = Minos.Minos(0); // get parameter 0's error
-    ROOT::Minuit2::MinosError e1 = Minos.Minos(1); // get parameter 1's error
+  //......................................................
+  // Toys: flat data, and the 95% limit for each binning
+  ToyMC toys(seed, stat_names) ;
+  toys.Run(n_toys, [&]() -> ToyMC::Toy
+  {
+    // Workspace of the toys
+    std::vector<ROOT::Minuit2::LogLikeli> fcns(fcn_set) ;
+    std::vector<double> counts(n_bins) ;
+    std::vector<Zaki::Math::Quantity> obs_set ;
+    std::vector<double> n_obs_set ;
+
+    return [&bin_period_set, &sig_set, err_def, n_bins, n_events, fcns,
+            counts, obs_set, n_obs_set]
+           (ToyRNG& rng, std::vector<double>& limits) mutable
+    {
+      // Data
+      std::fill(counts.begin(), counts.end(), 0) ;
+      for (size_t k = 0; k < n_events; k++)
+        counts[std::min(n_bins - 1, (size_t)(rng.Uniform()*n_bins))] += 1 ;
+
+      FitSeed seed ;
+      for (size_t i = 0; i < bin_period_set.size(); i++)
+      {
+        size_t bin_period = (size_t)bin_period_set[i] ;
+
+        // Rebinning (the bins that don't fill a period are dropped)
+        obs_set.clear() ;
+        n_obs_set.clear() ;
+        for (size_t b = 0; b + bin_period <= n_bins; b += bin_period)
+        {
+          double n_obs = 0 ;
+          for (size_t k = b; k < b + bin_period; k++)
+            n_obs += counts[k] ;
+          obs_set.push_back({n_obs, sqrt(n_obs)}) ;
+          n_obs_set.push_back(n_obs) ;
+        }
+
+        //......................................................
+        // The Poisson fit (Minuit only if it fails)
+        std::vector<double> sig(sig_set[i].begin(),
+                                sig_set[i].begin() + n_obs_set.size()) ;
+        PoissonFitter::Result res = PoissonFitter(n_obs_set, sig).Fit(err_def) ;
+        if (res.valid && res.mu_err.IsValid())
+        {
+          limits[i] = res.mu_err.Min() + res.mu_err.Upper() ;
+          continue ;
+        }
+
+        fcns[i].SetObsSet(obs_set) ;
+
+        //......................................................
+        //  Minimize
+        //......................................................
+        //(para_name, para_start_value, para_uncertainties)
+        // The background scales with the period (its start is
+        //  the expected value), so only mu comes from the seed
+        std::string bg_name = "bg_" + std::to_string(bin_period) ;
+
+        ROOT::Minuit2::MnUserParameters upar ;
+        upar.Add("mu", 1e-1, 1e-1);
+        upar.Add(bg_name, bin_period*(1.0*n_events/n_bins), 2);
+
+        // set limits
+        upar.SetLowerLimit("mu", 0);
+        upar.SetLowerLimit(bg_name, 0);
+
+        // Creat MIGRAD minimizer
+        int strategy_counter = 2 ;
+
+        // Minimize (from the previous binning's minimum)
+        ROOT::Minuit2::FunctionMinimum min = FitSeed::Migrad(fcns[i], upar, &seed, strategy_counter) ;
+        seed = FitSeed(min) ;
+
+        //......................................................
+        // MINOS Error analysis (only the upper limit of mu)
+        ROOT::Minuit2::MnMinos Minos(fcns[i], min);
+        ROOT::Minuit2::MinosError e0 = Minos.Minos(0);
+
+        // The failed fits are left out of the summary
+        if(!min.IsValid() || !e0.IsValid())
+          continue ;
+
+        limits[i] = e0.Min() + e0.Upper() ;
+      }
+    } ;
+  }) ;
+  //......................................................
 
-    // output
-    Z_LOG_INFO("Minos errors: ") ;
-    std::cout<<e0<<"\n"<<e1<<"\n";
+  toys.ExportSummary(out_dir + "/Sin_Flat_Fit_Summary.tsv") ;
+  toys.ExportToys(out_dir + "/Sin_Flat_Fit_Results.tsv") ;
 
-    char tmp_char[150] ;
-    sprintf(tmp_char, "\n -Lower Limit (95%%): %.2e\n -Upper Limit (95%%): %.2e",
-            e0.Min() + e0.Lower(), e0.Min() + e0.Upper()) ;
+  char tmp_char[150] ;
+  for (size_t i = 0; i < bin_period_set.size(); i++)
+  {
+    ToyStat st = toys.GetStat(i) ;
+    sprintf(tmp_char, "T = %3d: median limit (95%%): %.2e, [%.2e, %.2e] (%zu failed)",
+            (int)bin_period_set[i], st.band[2], st.band[1], st.band[3], st.n_failed) ;
     Z_LOG_INFO(tmp_char) ;
-
-    if(!e0.IsValid() || !e1.IsValid() ) Z_LOG_ERROR(" ---> Minos error is invalid!") ;
-    //......................................................
-
-    //......................................................
-    // Plotting
-    TCanvas c2("c2", "Sin-Flat Fit", 1000, 800) ;
-
-    sig_shape_hist.Scale(e0.Min() + e0.Upper()) ;
-
-    TH1F sig_bg_hist("signal-bg", "sig-bg", (size_t) ((1.0*n_bins) / bin_period), 0, 100) ;
-    for (size_t i = 0; i < (size_t) ((1.0*n_bins) / bin_period); i++)
-    {
-      sig_bg_hist.SetBinContent(i+1, e1.Min() + sig_shape_hist.GetBinContent(i+1)) ;
-      // sig_bg_hist.SetBinError(i+1, e1.Upper()) ;
-    }
-
-    h_obs_rebin.Draw() ;
-    
-    h_obs_rebin.SetMaximum(1.05*std::max(h_obs_rebin.GetMaximum(), sig_bg_hist.GetMaximum()) ) ;
-    h_obs_rebin.SetMinimum(0.95*std::min(h_obs_rebin.GetMinimum(), sig_bg_hist.GetMinimum()) ) ;
-    
-    sig_bg_hist.SetLineColor(kRed) ;
-    sig_bg_hist.Draw("same") ;
-
-
-    
-    c2.SaveAs((dir.ParentDir() +"/results/Time_Binning/T_"
-              + std::to_string((int)sig_period) + "/Sin_Flat_Fit_"
-              + std::to_string((int)bin_period)+".pdf").Str().c_str()) ;
-    //......................................................
-
-    fit_results.push_back({bin_period, e0.Min() + e0.Upper()}) ;
   }
 
-  Zaki::File::VecSaver saver(dir.ParentDir() +"/results/Time_Binning/T_"
-                              + std::to_string((int)sig_period) 
-                              + "/Sin_Flat_Fit_Results_"+std::to_string(j)+".tsv") ;
+  PlotQueue::Flush() ;
 
-  saver.Export2D(fit_results, "\t") ;
-
-}
   return 0;
 }
@@ -6,6 +6,11 @@
 // Creating directory
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+#include <TROOT.h>
 #include <Math/QuantFuncMathMore.h>
 #include <root6/Minuit2/MnScan.h>
 #include <root6/Minuit2/MnContours.h>
@@ -24,6 +29,13 @@
 #include "DMSS/LogLikeli.hpp"
 
 #include "DMSS/Analysis.hpp"
+#include "DMSS/TaskPool.hpp"
+#include "DMSS/CLsLimit.hpp"
+#include "DMSS/ToyMC.hpp"
+#include "DMSS/PlotQueue.hpp"
+#include "DMSS/PoissonFitter.hpp"
+#include "DMSS/LikeLi_Eq.hpp"
+#include "DMSS/AsyncLog.hpp"
 
 //==============================================================
 
@@ -42,18 +54,22 @@ Analysis::Analysis(const Analysis& other) :
 Prog("Analysis", true),
 set_satPtr_flag(other.set_satPtr_flag), cpy_ctr_called(other.cpy_ctr_called),
 assign_op_called(other.assign_op_called),
-sig_shape_hist(other.sig_shape_hist), 
 // all_bins(other.all_bins),
 focus_bins(other.focus_bins), thresh_limits(other.thresh_limits),
 thresh_limits_true(other.thresh_limits_true), e_bins(other.e_bins),
 // all_bin_periods(other.all_bin_periods), 
 focus_bin_periods(other.focus_bin_periods),
+expected_limits(other.expected_limits), asimov_bg_scale(other.asimov_bg_scale),
+fast_limits(other.fast_limits), fit_chain(other.fit_chain),
+cls_limits(other.cls_limits), cls_toys_min(other.cls_toys_min),
+cls_toys_max(other.cls_toys_max), cls_seed(other.cls_seed),
 boost_fit_results(other.boost_fit_results), boost_fit_val(other.boost_fit_val),
 e_cut_val(other.e_cut_val),
-m_SatBundles(other.m_SatBundles)
+m_SatBundles(other.m_SatBundles), checkpoint(other.checkpoint),
+shard(other.shard), grid_table(other.grid_table)
 {
   Z_LOG_NOTE("Analysis copy constructor called: from " + other.PtrStr() + " --> " + PtrStr()) ;
-  
+
   //.............................
   // Copying satellites
   
@@ -86,15 +102,25 @@ Analysis& Analysis::operator=(const Analysis& other)
     set_satPtr_flag = other.set_satPtr_flag;
     cpy_ctr_called  = other.cpy_ctr_called ;
     assign_op_called  = other.assign_op_called ;
-    sig_shape_hist= other.sig_shape_hist;
     focus_bins= other.focus_bins;
     thresh_limits= other.thresh_limits;
     thresh_limits_true= other.thresh_limits_true; e_bins= other.e_bins;
     focus_bin_periods= other.focus_bin_periods;
+    expected_limits= other.expected_limits;
+    asimov_bg_scale= other.asimov_bg_scale;
+    fast_limits= other.fast_limits;
+    fit_chain= other.fit_chain;
+    cls_limits= other.cls_limits;
+    cls_toys_min= other.cls_toys_min;
+    cls_toys_max= other.cls_toys_max;
+    cls_seed= other.cls_seed;
     boost_fit_results= other.boost_fit_results; 
     boost_fit_val= other.boost_fit_val;
     e_cut_val= other.e_cut_val;
     m_SatBundles = other.m_SatBundles ;
+    checkpoint = other.checkpoint ;
+    shard = other.shard ;
+    grid_table = other.grid_table ;
     // Pointer member variables
     modelPtr = other.modelPtr->Clone() ;
     assign_op_called = true ;
@@ -104,11 +130,91 @@ Analysis& Analysis::operator=(const Analysis& other)
 
 }
 
+//--------------------------------------------------------------
+// Move Constructor
+Analysis::Analysis(Analysis&& other) noexcept :
+Prog("Analysis", true),
+set_satPtr_flag(other.set_satPtr_flag), cpy_ctr_called(other.cpy_ctr_called),
+assign_op_called(other.assign_op_called),
+plot_mode(other.plot_mode),
+focus_bins(std::move(other.focus_bins)), conf_level(other.conf_level),
+thresh_limits(std::move(other.thresh_limits)),
+thresh_limits_true(std::move(other.thresh_limits_true)), 
+e_bins(std::move(other.e_bins)),
+focus_bin_periods(std::move(other.focus_bin_periods)),
+expected_limits(std::move(other.expected_limits)),
+asimov_bg_scale(other.asimov_bg_scale),
+fast_limits(other.fast_limits),
+fit_chain(other.fit_chain),
+cls_limits(std::move(other.cls_limits)),
+cls_toys_min(other.cls_toys_min),
+cls_toys_max(other.cls_toys_max),
+cls_seed(other.cls_seed),
+boost_fit_results(std::move(other.boost_fit_results)), 
+boost_fit_val(other.boost_fit_val),
+e_cut_val(other.e_cut_val),
+m_SatBundles(std::move(other.m_SatBundles)),
+modelPtr(std::move(other.modelPtr)),
+checkpoint(std::move(other.checkpoint)),
+shard(other.shard), grid_table(std::move(other.grid_table))
+{
+  //.............................
+  // Prog base-class members
+  wrk_dir = std::move(other.wrk_dir) ;
+  name        = std::move(other.name) ;
+  set_name_flag = other.set_name_flag    ;
+  set_wrk_dir_flag = other.set_wrk_dir_flag ;
+  //.............................
+
+  other.set_satPtr_flag = false ;
+}
+
+//--------------------------------------------------------------
+// Move assignment operator
+Analysis& Analysis::operator=(Analysis&& other) noexcept
+{
+  if(this == &other) return *this ;
+
+  set_satPtr_flag     = other.set_satPtr_flag ;
+  cpy_ctr_called      = other.cpy_ctr_called ;
+  assign_op_called    = other.assign_op_called ;
+  plot_mode           = other.plot_mode ;
+  focus_bins          = std::move(other.focus_bins) ;
+  conf_level          = other.conf_level ;
+  thresh_limits       = std::move(other.thresh_limits) ;
+  thresh_limits_true  = std::move(other.thresh_limits_true) ;
+  e_bins              = std::move(other.e_bins) ;
+  focus_bin_periods   = std::move(other.focus_bin_periods) ;
+  expected_limits     = std::move(other.expected_limits) ;
+  asimov_bg_scale     = other.asimov_bg_scale ;
+  fast_limits         = other.fast_limits ;
+  fit_chain           = other.fit_chain ;
+  cls_limits          = std::move(other.cls_limits) ;
+  cls_toys_min        = other.cls_toys_min ;
+  cls_toys_max        = other.cls_toys_max ;
+  cls_seed            = other.cls_seed ;
+  boost_fit_results   = std::move(other.boost_fit_results) ;
+  boost_fit_val       = other.boost_fit_val ;
+  e_cut_val           = other.e_cut_val ;
+  m_SatBundles        = std::move(other.m_SatBundles) ;
+  modelPtr            = std::move(other.modelPtr) ;
+  checkpoint          = std::move(other.checkpoint) ;
+  shard               = other.shard ;
+  grid_table          = std::move(other.grid_table) ;
+
+  other.set_satPtr_flag = false ;
+
+  return *this ;
+}
+
 //--------------------------------------------------------------
 // Destructor
 Analysis::~Analysis() 
 {
   Z_LOG_NOTE("Analysis destructor called for: " + PtrStr()) ;
+
+  // The queued plots are rendered while ROOT is still alive
+  PlotQueue::Flush() ;
 }
 
 //--------------------------------------------------------------
@@ -127,7 +233,7 @@ void Analysis::SetWrkDir(const Zaki::String::Directory& input)
     Z_LOG_INFO("Directory '" + wrk_dir.Str() + "' created."); 
   // .................................................
 
-  for(auto satB : m_SatBundles)
+  for(auto& satB : m_SatBundles)
   {
     satB->SetWrkDir(input) ;
   }
@@ -199,17 +305,18 @@ void Analysis::DoThresh(const size_t& sat_idx,
     {
       t_mu95.push_back({(double)GetBinPeriod(sat_idx)[j], tmp_mu95}) ;
       mu95.push_back(tmp_mu95) ;
-      e_bins.push_back(m_SatBundles[sat_idx].GetTimeBin(i,j).GetECenter().val);
+      // Time-binning doesn't change the bin center
+      e_bins.push_back(m_SatBundles[sat_idx]->GetData()[i].GetECenter().val);
       j++ ;
     }
   } 
   else
   {
-    for(size_t i=0 ; i < m_SatBundles[sat_idx]->GetData().GetBins().size() ; ++i)
+    for(size_t i=0 ; i < m_SatBundles[sat_idx]->GetData().size() ; ++i)
     {
       t_mu95.push_back({(double)GetBinPeriod(sat_idx)[i], tmp_mu95}) ;
       mu95.push_back(tmp_mu95) ;
-      e_bins.push_back(m_SatBundles[sat_idx].GetTimeBin(i,i).GetECenter().val);
+      e_bins.push_back(m_SatBundles[sat_idx]->GetData()[i].GetECenter().val);
     }
   }
 
@@ -280,7 +387,7 @@ void Analysis::DoThresh(const size_t& sat_idx,
 
   (*mfcwPtr)->SetWrkDir(wrk_dir + "/" + tmp_name + "/Fit") ;
 
-  (*mfcwPtr)->SetThreads(8) ;
+  (*mfcwPtr)->SetThreads(TaskPool::Get().Size()) ;
 
   // ...........................
   // Saving time by checking if the grid values are the
@@ -324,12 +431,12 @@ void Analysis::DoThresh(const size_t& sat_idx,
 
       if(in_bins_idx)
       {
-        modelPtr->SetActiveBin(m_SatBundles[sat_idx]->GetData().GetBins()[(*in_bins_idx)[i]]) ;
+        modelPtr->SetActiveBin(m_SatBundles[sat_idx]->GetData()[(*in_bins_idx)[i]]) ;
         (*mfcwPtr)->SetContVal({mu95[i]}, {"T_"+std::to_string(GetBinPeriod(sat_idx)[i])}) ;
       }
       else
       {
-        modelPtr->SetActiveBin(m_SatBundles[sat_idx]->GetData().GetBins()[i]) ;
+        modelPtr->SetActiveBin(m_SatBundles[sat_idx]->GetData()[i]) ;
         (*mfcwPtr)->SetContVal({mu95[i]}, {"M_"+std::to_string((int)e_bins[i]*modelPtr->GetDecayProd().size())}) ;
       }
 
@@ -365,7 +472,7 @@ void Analysis::DoThresh(const size_t& sat_idx,
   } 
   else            
   { 
-    tmp_bins_size = m_SatBundles[sat_idx]->GetData().GetBins().size() ; 
+    tmp_bins_size = m_SatBundles[sat_idx]->GetData().size() ; 
   }
   // ...........................
   // Making the plot legend
@@ -413,13 +520,64 @@ void Analysis::DoThresh(const size_t& sat_idx,
 std::vector<double> Analysis::ScanParThresh(const size_t& b_idx, const size_t& t_idx, const size_t& sat_idx) 
 {
   Bin b = m_SatBundles[sat_idx].GetTimeBin(b_idx,t_idx) ;
-
   TH1F sig_shape = m_SatBundles[sat_idx]->GetSigShape(b.GetECenter().val) ;
 
+  return ScanBinThresh({0, b_idx, t_idx, std::move(b), sig_shape}, sat_idx) ;
+}
+
+//--------------------------------------------------------------
+/// Scans the likelihood of all the satellite's bins in parallel
+std::vector<std::vector<double>> Analysis::ScanParThreshAll(const size_t& sat_idx) 
+{
+  std::vector<std::pair<size_t, size_t>> idx ;
+  idx.reserve(GetBinPeriod(sat_idx).size()) ;
+  for (size_t i = 0; i < GetBinPeriod(sat_idx).size(); i++)
+    idx.emplace_back(i, i) ;
+
+  std::vector<std::vector<double>> out(idx.size()) ;
+
+  // The finished scans are skipped when resuming
+  std::vector<std::string> keys ;
+  for (auto&& i : idx)
+    keys.push_back(UnitKey("thresh_scan|" + m_SatBundles[sat_idx]->GetName() 
+                           + "|b=" + std::to_string(i.first) 
+                           + "|T=" + std::to_string(GetBinPeriod(sat_idx)[i.second])
+                           + (fast_limits ? "|fast" : ""))) ;
+
+  RunThreshTasks(sat_idx, idx, 
+    [&](ThreshTask& task) 
+    { 
+      if (checkpoint && checkpoint->Find(keys[task.pos], out[task.pos]))
+        return ;
+
+      if (ShardSkips(task.pos, keys[task.pos])) return ;
+
+      out[task.pos] = ScanBinThresh(task, sat_idx) ; 
+      if (checkpoint) checkpoint->Save(keys[task.pos], out[task.pos]) ;
+    },
+    [](ThreshTask&) {}) ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+/// Scans the likelihood of a single time-binned bin
+///  (safe to call from the per-bin driver)
+std::vector<double> Analysis::ScanBinThresh(const ThreshTask& task, const size_t& sat_idx) 
+{
+  const size_t& b_idx = task.b_idx ;
+  const size_t& t_idx = task.t_idx ;
+  const Bin& b        = task.bin ;
+
   ROOT::Minuit2::LogLikeli  fcn;
 
   fcn.AddObsCounts(b) ;
-  fcn.AddSigShape(sig_shape)  ;
+  fcn.AddSigShape(task.sig_shape)  ;
+
+  // Solving for the limit directly
+  if (fast_limits)
+    return {(double)b_idx, (double)GetBinPeriod(sat_idx)[t_idx], 
+            fcn.UpperLimit(ROOT::Minuit2::LogLikeli::ChiSqQuantile(conf_level, 2))} ;
 
   using namespace CONFIND ;
   MemFuncContWrapper<ROOT::Minuit2::LogLikeli, 
@@ -439,26 +597,37 @@ std::vector<double> Analysis::ScanParThresh(const size_t& b_idx, const size_t& t
   
   mfcw->SetWrkDir(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName()  + "/LikeLi") ;
   
-  mfcw->SetContVal({ROOT::MathMore::chisquared_quantile(0.68, 2),
-                    ROOT::MathMore::chisquared_quantile(0.90, 2),
-                    ROOT::MathMore::chisquared_quantile(0.95, 2)}) ;
+  mfcw->SetContVal({ROOT::Minuit2::LogLikeli::ChiSqQuantile(0.68, 2),
+                    ROOT::Minuit2::LogLikeli::ChiSqQuantile(0.90, 2),
+                    ROOT::Minuit2::LogLikeli::ChiSqQuantile(0.95, 2)}) ;
 
   mfcw->SetGridVals(CONFIND::ContourFinder::Mode::Fast) ;
 
-  mfcw->MakeLegend(true, "#Delta [ -2Log(L) ]", "user") ;
-  mfcw->GetLegend()->SetX1(0.10) ; mfcw->GetLegend()->SetY1(0.10) ;
-  mfcw->GetLegend()->SetX2(0.25) ; mfcw->GetLegend()->SetY2(0.30) ;
-  mfcw->GetLegend()->SetTextSize(0.025) ;
+  // The contours are still needed when the plots are skipped
+  const bool headless = PlotQueue::Headless() ;
+
+  // ROOT graphics isn't thread-safe
+  std::unique_lock<std::mutex> gfx_lock = PlotQueue::Lock() ;
+
+  if (!headless)
+  {
+    mfcw->MakeLegend(true, "#Delta [ -2Log(L) ]", "user") ;
+    mfcw->GetLegend()->SetX1(0.10) ; mfcw->GetLegend()->SetY1(0.10) ;
+    mfcw->GetLegend()->SetX2(0.25) ; mfcw->GetLegend()->SetY2(0.30) ;
+    mfcw->GetLegend()->SetTextSize(0.025) ;
 
-  mfcw->Plot("Thresh/Plots/Threshold_B" + std::to_string(b_idx) + "_T="
-             + std::to_string(GetBinPeriod(sat_idx)[t_idx]), ("-2 Log Likelihood ( T = "
-             + std::to_string(GetBinPeriod(sat_idx)[t_idx]) +" )").c_str(),
-            "#mu",
-            "bg") ;
+    mfcw->Plot("Thresh/Plots/Threshold_B" + std::to_string(b_idx) + "_T="
+               + std::to_string(GetBinPeriod(sat_idx)[t_idx]), ("-2 Log Likelihood ( T = "
+               + std::to_string(GetBinPeriod(sat_idx)[t_idx]) +" )").c_str(),
+              "#mu",
+              "bg") ;
+  }
   mfcw->ExportContour("Thresh/Conts/B=" + std::to_string(b_idx)  
                       + "_T=" + std::to_string(GetBinPeriod(sat_idx)[t_idx]), 
                       Zaki::File::FileMode::Write ) ;
 
+  gfx_lock.unlock() ;
+
   // Removing the contours we don't need
   for (auto &&i : {"2.28e+00", "4.61e+00"})
   {
@@ -476,7 +645,7 @@ std::vector<double> Analysis::ScanParThresh(const size_t& b_idx, const size_t& t
   // Error opening the file
   if (file.fail()) 
   {
-    Z_LOG_ERROR("File '"+(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName() 
+    DMSS_LOG_ERROR("File '"+(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName() 
                                     + "/LikeLi/"
                                     + "Thresh/Conts/B=" + std::to_string(b_idx)  
                       + "_T=" + std::to_string(GetBinPeriod(sat_idx)[t_idx]) + "_5.99e+00").Str() +"' cannot be opened!") ;
@@ -499,20 +668,37 @@ return {(double)b_idx, (double)GetBinPeriod(sat_idx)[t_idx], *std::max_element(m
 // Plots the parameter space given the mu95 input file
 void Analysis::PlotParamSpaceThresh(const size_t& sat_idx, const bool bypass) 
 {
+  //....................................
+  // Initializing the model
+  if(modelPtr)
+    modelPtr->Init() ;
+  else
+  {
+    Z_LOG_ERROR("Model is not set, use 'SetModel' first.") ;
+    return;
+  }
+  //....................................
+
+  std::string campaign = "thresh_" + m_SatBundles[sat_idx]->GetName() 
+                          + "_" + modelPtr->GetName() ;
+  if (shard.merge)
+    CheckShards(campaign) ;
+
   std::vector<std::vector<double>> tmp_vec ;
  if(!bypass)
  {
-    for (size_t i = 0; i < GetBinPeriod(0).size(); i++)
+    tmp_vec = ScanParThreshAll(sat_idx) ;
+
+    // The shards only have a part of the limits
+    if(!shard.Partial())
     {
-      tmp_vec.emplace_back( ScanParThresh(i, i, 0) ) ;
+      Zaki::File::VecSaver my_saver(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName() 
+                                        + "/LikeLi/"
+                                        + "Thresh/Conts/"+ m_SatBundles[sat_idx]->GetName() 
+                                        +"_Thresh.dat", 
+                                    Zaki::File::FileMode::Write) ;
+      my_saver.Export2D(tmp_vec) ;
     }
-
-    Zaki::File::VecSaver my_saver(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName() 
-                                      + "/LikeLi/"
-                                      + "Thresh/Conts/"+ m_SatBundles[sat_idx]->GetName() 
-                                      +"_Thresh.dat", 
-                                  Zaki::File::FileMode::Write) ;
-    my_saver.Export2D(tmp_vec) ;
   }
   // Limits are already found we just need to read them from file
   else
@@ -539,17 +725,6 @@ void Analysis::PlotParamSpaceThresh(const size_t& sat_idx, const bool bypass)
       tmp_vec.push_back({std::stof((*loop)[0]), std::stof((*loop)[1]), std::stof((*loop)[2])}) ;
     }
   }
-  
-  //....................................
-  // Initializing the model
-  if(modelPtr)
-    modelPtr->Init() ;
-  else
-  {
-    Z_LOG_ERROR("Model is not set, use 'SetModel' first.") ;
-    return;
-  }
-  //....................................
 
   using namespace CONFIND ;
   MemFuncContWrapper<Analysis, 
@@ -560,7 +735,7 @@ void Analysis::PlotParamSpaceThresh(const size_t& sat_idx, const bool bypass)
   mfcw->SetGrid(modelPtr->GetTGrid(plot_mode)->grid) ;
   
   mfcw->SetWrkDir(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName()  + "/LikeLi") ;
-    
+  mfcw->SetThreads(TaskPool::Get().Size()) ;
 
   std::vector<double> cont_vals ; cont_vals.reserve(20) ;
   std::vector<std::string> cont_labels ; cont_labels.reserve(20) ;
@@ -570,21 +745,44 @@ void Analysis::PlotParamSpaceThresh(const size_t& sat_idx, const bool bypass)
   // "2500", "2800", "3200" , "3700", "4300", "4900", "5600", "6500",
   // "7400", "8500"} ;
   char tmp_lab[100] ;
+  char tmp_plane[200] ;
   for (size_t i = 0; i < tmp_vec.size(); i++)
   {
-    cont_vals.push_back(tmp_vec[i][2]) ;
-    sprintf(tmp_lab, "%d", 10*(int)((m_SatBundles[sat_idx].GetTimeBin(i,i).GetECenter().val*modelPtr->GetDecayProd().size())/10)) ;
+    sprintf(tmp_lab, "%d", 10*(int)((m_SatBundles[sat_idx]->GetData()[i].GetECenter().val*modelPtr->GetDecayProd().size())/10)) ;
 
     // Changing the DM mass in the model
-    modelPtr->SetDMMass(m_SatBundles[sat_idx].GetTimeBin(i,i).GetECenter().val*modelPtr->GetDecayProd().size()) ;
-    modelPtr->SetActiveBin(m_SatBundles[sat_idx]->GetData().GetBins()[i]) ;
+    modelPtr->SetDMMass(m_SatBundles[sat_idx]->GetData()[i].GetECenter().val*modelPtr->GetDecayProd().size()) ;
+    modelPtr->SetActiveBin(m_SatBundles[sat_idx]->GetData()[i]) ;
+
+    // Grid values of the plane: evaluated by the shards, and
+    //  looked up when merging (the scans are the first units)
+    grid_table = nullptr ;
+    if(shard.count > 1)
+      ShardPlane(campaign + "_b=" + std::to_string(i), tmp_vec.size() + i*shard.tiles,
+                 modelPtr->GetTGrid(plot_mode)->grid, &Analysis::ContFuncThresh_LG) ;
+    if(shard.Partial())
+      continue ;
+
+    // The stored values are reused when bypassing
+    sprintf(tmp_plane, "Thresh_%s_%d_M=%.10g_b=%zu", modelPtr->GetName().c_str(),
+            (int)plot_mode, modelPtr->GetDMMass(), i) ;
+    StorePlane(m_SatBundles[sat_idx]->GetName(), tmp_plane, 
+               modelPtr->GetTGrid(plot_mode)->grid, &Analysis::ContFuncThresh_LG, bypass) ;
+
+    cont_vals.push_back(tmp_vec[i][2]) ;
     mfcw->SetContVal({tmp_vec[i][2]}, {tmp_lab}) ;
     UpdateMFCW(&mfcw) ;
     mfcw->SetGridVals(CONFIND::ContourFinder::Mode::Fast) ;
 
     cont_labels.push_back(tmp_lab) ;
   }
+  grid_table = nullptr ;
 
+  if(shard.Partial())
+  {
+    FinishShard(campaign) ;
+    return ;
+  }
 
 
 
@@ -668,7 +866,19 @@ void Analysis::ScanParMinuit(const size_t& b_idx, const size_t& sat_idx)
 /// Scans the likelihood function vs parameters
 std::vector<double> Analysis::ScanParBoost(const double& in_mass, const size_t& sat_idx) 
 {
+  std::unique_ptr<Model> model = modelPtr->Clone() ;
+  model->SetDMMass(in_mass) ;
+
+  return ScanBoostMass(PrepBoostSet({sat_idx}), *model, sat_idx) ;
+}
 
+//--------------------------------------------------------------
+/// Scans the likelihood of the boosted case for the model's DM mass
+///  (safe to call from the mass sweep)
+std::vector<double> Analysis::ScanBoostMass(const BoostSet& boost_set, 
+                                            Model& model, const size_t& sat_idx) 
+{
+  const double in_mass = model.GetDMMass() ;
   Zaki::Math::Range<double> e_range = {GetECut(), in_mass} ; 
 
   std::vector<double> tmp_best_fit = {1e-7} ;
@@ -678,20 +888,20 @@ std::vector<double> Analysis::ScanParBoost(const double& in_mass, const size_t&
   std::vector<double> fixed_bg_set  ;
   
 
-  for(size_t i=0 ; i < m_SatBundles[sat_idx]->GetData().GetBins().size() ; ++i)
+  for(auto&& bb : boost_set.bins)
   {
-    Bin b = m_SatBundles[sat_idx].GetTimeBin(i,i) ;
+    Bin b = bb.bin ;
     // ..............................
     // out of spectrum condition
     if( b.GetERange().min >= e_range.max || b.GetERange().max <= e_range.min )
       continue ; 
 
 
-    TH1F sig_shape = m_SatBundles[sat_idx]->GetSigShape(b.GetECenter().val) ;
+    TH1F sig_shape = bb.sig_shape ;
 
     // Scaling the histogram by the energy-dependent 
     //  spectrum of the model
-    sig_shape.Scale(modelPtr->GetSpectrum(b)) ;
+    sig_shape.Scale(model.GetSpectrum(b)) ;
           
     fcn.AddObsCounts(b) ;
     fcn.AddSigShape(sig_shape)  ;
@@ -699,6 +909,10 @@ std::vector<double> Analysis::ScanParBoost(const double& in_mass, const size_t&
     fixed_bg_set.push_back(b.GetTBinObsSet()[0].val) ;
   }
 
+  // Solving for the limit directly, on the profile of all the backgrounds
+  if (fast_limits)
+    return { in_mass, fcn.UpperLimit(ROOT::Minuit2::LogLikeli::ChiSqQuantile(conf_level, tmp_best_fit.size())) } ;
+
   for (size_t ign_idx = 0; ign_idx < fixed_bg_set.size() ; ign_idx++)
   {
     fcn.SetNDBgSet(ign_idx, fixed_bg_set) ;
@@ -717,22 +931,26 @@ std::vector<double> Analysis::ScanParBoost(const double& in_mass, const size_t&
 
     mfcw->SetWrkDir(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName()  + "/LikeLi") ;
     
-    mfcw->SetContVal({ROOT::MathMore::chisquared_quantile(0.68, tmp_best_fit.size()),
-                      ROOT::MathMore::chisquared_quantile(0.90, tmp_best_fit.size()),
-                      ROOT::MathMore::chisquared_quantile(0.95, tmp_best_fit.size())}) ;
+    mfcw->SetContVal({ROOT::Minuit2::LogLikeli::ChiSqQuantile(0.68, tmp_best_fit.size()),
+                      ROOT::Minuit2::LogLikeli::ChiSqQuantile(0.90, tmp_best_fit.size()),
+                      ROOT::Minuit2::LogLikeli::ChiSqQuantile(0.95, tmp_best_fit.size())}) ;
     mfcw->SetGridVals(CONFIND::ContourFinder::Mode::Fast) ;
 
-    mfcw->MakeLegend(true, "#Delta [ -2Log(L) ]", "user") ;
-    mfcw->GetLegend()->SetX1(0.75) ; mfcw->GetLegend()->SetY1(0.10) ;
-    mfcw->GetLegend()->SetX2(0.90) ; mfcw->GetLegend()->SetY2(0.30) ;
-    mfcw->GetLegend()->SetTextSize(0.025) ;
-    mfcw->GetGraph()->GetXaxis()->SetMaxDigits(2) ;
-
     char tmp[200] ;
-    sprintf(tmp, "Boost/Plots/M_%.0f/Boosted_%zu_M=%.0f", in_mass, ign_idx, in_mass) ;
-    mfcw->Plot(tmp,
-                ("-2 Log Likelihood ( B = " + std::to_string(ign_idx) + ")").c_str(),
-                "#mu", "bg") ;
+    {
+      std::unique_lock<std::mutex> gfx_lock = PlotQueue::Lock() ;
+
+      mfcw->MakeLegend(true, "#Delta [ -2Log(L) ]", "user") ;
+      mfcw->GetLegend()->SetX1(0.75) ; mfcw->GetLegend()->SetY1(0.10) ;
+      mfcw->GetLegend()->SetX2(0.90) ; mfcw->GetLegend()->SetY2(0.30) ;
+      mfcw->GetLegend()->SetTextSize(0.025) ;
+      mfcw->GetGraph()->GetXaxis()->SetMaxDigits(2) ;
+
+      sprintf(tmp, "Boost/Plots/M_%.0f/Boosted_%zu_M=%.0f", in_mass, ign_idx, in_mass) ;
+      mfcw->Plot(tmp,
+                  ("-2 Log Likelihood ( B = " + std::to_string(ign_idx) + ")").c_str(),
+                  "#mu", "bg") ;
+    }
     sprintf(tmp, "Boost/Conts/M_%.0f/Boosted_%zu_M=%.0f",  in_mass, ign_idx, in_mass) ;
     
     // mfcw->ExportContour(tmp, Zaki::File::FileMode::Write ) ;
@@ -743,14 +961,14 @@ std::vector<double> Analysis::ScanParBoost(const double& in_mass, const size_t&
     {
       sprintf(tmp, "/LikeLi/Boost/Conts/M_%.0f/Boosted_%zu_M=%.0f_%.2e", 
         in_mass, ign_idx, in_mass,
-        ROOT::MathMore::chisquared_quantile(i, tmp_best_fit.size()) ) ;
+        ROOT::Minuit2::LogLikeli::ChiSqQuantile(i, tmp_best_fit.size()) ) ;
 
       std::remove((wrk_dir + "/" + m_SatBundles[sat_idx]->GetName() + std::string(tmp)).Str().c_str()) ;
     }
 
     sprintf(tmp, "/LikeLi/Boost/Conts/M_%.0f/Boosted_%zu_M=%.0f_%.2e", 
               in_mass, ign_idx, in_mass,
-              ROOT::MathMore::chisquared_quantile(0.95, tmp_best_fit.size()) ) ;
+              ROOT::Minuit2::LogLikeli::ChiSqQuantile(0.95, tmp_best_fit.size()) ) ;
 
     std::ifstream file( (wrk_dir + "/" + m_SatBundles[sat_idx]->GetName() 
                         + std::string(tmp) ).Str());
@@ -758,7 +976,7 @@ std::vector<double> Analysis::ScanParBoost(const double& in_mass, const size_t&
     // Error opening the file
     if (file.fail()) 
     {
-      Z_LOG_ERROR("File '"+(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName() 
+      DMSS_LOG_ERROR("File '"+(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName() 
                             +  std::string(tmp) ).Str() +"' cannot be opened!") ;
       exit(EXIT_FAILURE) ;
       return {-1, -1};
@@ -799,15 +1017,26 @@ void Analysis::PlotParamSpaceBoost(const size_t& sat_idx, const bool bypass)
   std::vector<std::vector<double>> tmp_vec ;
   if(!bypass)
   {
-    for (size_t i = 0; i < modelPtr->GetDMMassSet().size(); i++)
-    {
+    // The time-binned bins don't depend on the DM mass, so they
+    //  are prepared once, and the masses are scanned in parallel
+    BoostSet boost_set = PrepBoostSet({sat_idx}) ;
 
-      // Changing the DM mass
-      modelPtr->SetDMMass(modelPtr->GetDMMassSet()[i]) ;
-
-      tmp_vec.emplace_back( ScanParBoost(modelPtr->GetDMMass(), sat_idx) ) ;
-    
-    }  
+    tmp_vec.resize(modelPtr->GetDMMassSet().size()) ;
+    SweepDMMass([&](size_t i, Model& model)
+    { 
+      // The finished masses are skipped when resuming
+      char tmp[100] ;
+      sprintf(tmp, "|M=%.17g", model.GetDMMass()) ;
+      std::string key = UnitKey("boost_scan|" + m_SatBundles[sat_idx]->GetName() 
+                                + "|" + model.GetName() + tmp
+                                + (fast_limits ? "|fast" : "")) ;
+
+      if (checkpoint && checkpoint->Find(key, tmp_vec[i]))
+        return ;
+
+      tmp_vec[i] = ScanBoostMass(boost_set, model, sat_idx) ; 
+      if (checkpoint) checkpoint->Save(key, tmp_vec[i]) ;
+    }) ;
     
     Zaki::File::VecSaver my_saver(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName() 
                                     + "/LikeLi/"
@@ -841,68 +1070,94 @@ void Analysis::PlotParamSpaceBoost(const size_t& sat_idx, const bool bypass)
       tmp_vec.emplace_back(std::stof((*loop)[0]), std::stof((*loop)[1])) ;
     }
   }
+}
 
-return  ;
-  using namespace CONFIND ;
-  MemFuncContWrapper<Analysis, 
-                      double (Analysis::*) (double, double)> 
-                      mfcw(*this, &Analysis::ContFuncBoost_LG) ;
+//--------------------------------------------------------------
+// Fitting the histograms and finding the errors (C.L.)
+void Analysis::FitBin(Bin b, const size_t& sat_idx)
+{
+  TH1F sig_shape = m_SatBundles[sat_idx]->GetSigShape(b.GetECenter().val) ;
 
+  StoreBinFit(sat_idx, b, sig_shape, FitBinMinos(b, sig_shape)) ;
+}
 
-  mfcw->SetGrid(modelPtr->GetBGrid(plot_mode)->grid) ;
-  
-  mfcw->SetWrkDir(wrk_dir + "/" + m_SatBundles[sat_idx]->GetName()  + "/LikeLi") ;
+//--------------------------------------------------------------
+// Fits a single bin (with Migrad & Minos if the Poisson fitter
+//  fails) and finds the errors. Only local objects are used, so bins can be fitted in parallel.
+Analysis::ThreshFit Analysis::FitBinMinos(const Bin& b, const TH1F& sig_shape,
+                                          const FitSeed* seed) const
+{
+  DMSS_LOG_INFO("Performing the threshold fit for E = " 
+              + std::to_string(b.GetECenter().val) + " GeV.") ;
 
-  std::vector<double> cont_vals ; cont_vals.reserve(20) ;
-  std::vector<std::string> cont_labels ; cont_labels.reserve(20) ;
+  // The fit is determined by the counts, the signal shape & the C.L.
+  FitCache::Key key("thresh_minos") ;
+  AddFitInputs(key, b, sig_shape) ;
+  key.Add(conf_level) ;
 
-  char tmp_lab[100] ;
-  for (size_t i = 0; i < tmp_vec.size(); i++)
+  ThreshFit out ;
+  std::vector<double> cached ;
+  auto find_cached = [&](const std::string& solver_key)
   {
-    cont_vals.push_back(tmp_vec[i][1]) ;
-    sprintf(tmp_lab, "%.1e", modelPtr->GetDMMassSet()[i]) ;
+    size_t pos = 0 ;
+    if (!FitCache::Get().Find(solver_key, cached) || 
+        !out.e0.Unpack(cached, pos) || !out.e1.Unpack(cached, pos))
+      return false ;
 
-    //   Changing the DM mass in the model
-    modelPtr->SetDMMass(modelPtr->GetDMMassSet()[i]) ;
+    // The minimum seeds the next fit of the chain (the older
+    //  records only have the Minos values)
+    if (!out.seed.Unpack(cached, pos, {"mu", "bg"}))
+      out.seed = FitSeed({"mu", "bg"}, {out.e0.Min(), out.e1.Min()}) ;
 
-    mfcw->SetContVal({tmp_vec[i][1]}, {tmp_lab}) ;
-    UpdateMFCW(&mfcw) ;
-    mfcw->SetGridVals(CONFIND::ContourFinder::Mode::Fast) ;
+    out.summary = "\n Cached fit: " + solver_key + "\n" ;
+    return true ;
+  } ;
 
-    cont_labels.push_back(tmp_lab) ;
+  // Each solver keeps its own records, and the Minuit ones are 
+  //  only looked up once the Poisson fitter fails, as they'd run
+  const std::string poisson_key = FitCache::Key(key).Add("poisson").Str() ;
+  const std::string minuit_key  = FitCache::Key(key).Add("minuit").Str() ;
+  if (find_cached(poisson_key))
+    return out ;
+
+  // -2Log & chi2 have the same normalization
+  double err_def = ROOT::Minuit2::LogLikeli::ChiSqQuantile(conf_level, 2) ;
+
+  // The dedicated fitter first (Minuit if it fails)
+  std::vector<double> counts, sig ;
+  for (size_t j = 0 ; j < b.GetTBinObsSet().size() ; ++j)
+  {
+    counts.push_back(b.GetTBinObsSet()[j].val) ;
+    sig.push_back(sig_shape.GetBinContent(j+1)) ;
   }
 
-  mfcw->MakeLegend(true, "M_{DM}  [GeV]", "user") ;
-  mfcw->GetLegend()->SetX1(0.75) ; mfcw->GetLegend()->SetY1(0.10) ;
-  mfcw->GetLegend()->SetX2(0.90) ; mfcw->GetLegend()->SetY2(0.15 + tmp_vec.size()*0.03) ;
-  mfcw->GetLegend()->SetTextSize(0.025) ;
-  mfcw->SetLegendLabels(cont_labels) ;
-  mfcw->GetGraph()->GetXaxis()->SetMaxDigits(2) ;
-  
-  char tmp_plot_label[200] ;
-  sprintf(tmp_plot_label,"%s - Boost (%s)", 
-          modelPtr->GetName().c_str(), m_SatBundles[sat_idx]->GetName().c_str()) ;  
+  PoissonFitter::Result res = PoissonFitter(counts, sig, Bin::RelWidths(sig_shape)).Fit(err_def) ;
+  if (res.valid && res.mu_err.IsValid() && res.bg_err.IsValid())
+  {
+    out.e0   = res.mu_err ;
+    out.e1   = res.bg_err ;
+    out.seed = FitSeed({"mu", "bg"}, {res.mu, res.bg},
+                       {res.cov[0], res.cov[1], res.cov[2]}) ;
 
-  mfcw->Plot(m_SatBundles[sat_idx]->GetName() + "_Boost_" 
-             + modelPtr->GetName(),
-              tmp_plot_label,
-              modelPtr->GetBGrid(plot_mode)->option.xLabel.c_str(), 
-              modelPtr->GetBGrid(plot_mode)->option.yLabel.c_str()) ;
+    char tmp[300] ;
+    sprintf(tmp, "\n Poisson fit: mu = %.6e, bg = %.6e, -2LogL = %.8e,"
+                 " cov = {%.4e, %.4e, %.4e}, %u calls\n",
+            res.mu, res.bg, res.min_val, res.cov[0], res.cov[1], res.cov[2],
+            res.n_calls) ;
+    out.summary = tmp ;
 
-  mfcw->ExportContour("Boost/Conts/" + modelPtr->GetName()+ "/" + 
-                      m_SatBundles[sat_idx]->GetName() + "_" + modelPtr->GetName(), 
-                      Zaki::File::FileMode::Write ) ;
-}
+    cached.clear() ;
+    out.e0.Pack(cached) ;
+    out.e1.Pack(cached) ;
+    out.seed.Pack(cached) ;
+    FitCache::Get().Save(poisson_key, cached) ;
 
-//--------------------------------------------------------------
-// Fitting the histograms and finding the errors (C.L.)
-void Analysis::FitBin(Bin b, const size_t& sat_idx)
-{
- 
-  Z_LOG_INFO("Performing the threshold fit for E = " 
-              + std::to_string(b.GetECenter().val) + " GeV.") ;
+    return out ;
+  }
+  DMSS_LOG_NOTE("The Poisson fit failed, using Minuit.") ;
 
-  TH1F sig_shape = m_SatBundles[sat_idx]->GetSigShape(b.GetECenter().val) ;
+  if (find_cached(minuit_key))
+    return out ;
 
   ROOT::Minuit2::LogLikeli   fcn;
 
@@ -917,19 +1172,14 @@ void Analysis::FitBin(Bin b, const size_t& sat_idx)
   upar.Add("mu", 3e-4, 1e-7);
   upar.Add("bg", b.GetTBinObsSet()[0].val, 1);
 
-  std::cout << "\n --------> b.GetTBinObsSet()[0].val: " << b.GetTBinObsSet()[0].val << "\n" ;
-  // upar.Add("period", bin_per, 0.00000001);
-
   // set limits
   upar.SetLowerLimit("mu", 0);
 
-
   // Creat MIGRAD minimizer
   int strategy_counter = 2 ;
-  ROOT::Minuit2::MnMigrad migrad(fcn, upar, strategy_counter);
 
-  // Minimize
-  ROOT::Minuit2::FunctionMinimum min = migrad();
+  // Minimize (from the neighbouring bin's minimum, if seeded)
+  ROOT::Minuit2::FunctionMinimum min = FitSeed::Migrad(fcn, upar, seed, strategy_counter) ;
 
   //.................
   // If minimization failed:
@@ -937,15 +1187,12 @@ void Analysis::FitBin(Bin b, const size_t& sat_idx)
   {
     strategy_counter++ ;
     // try with higher strategy
-    Z_LOG_ERROR("Migrad min is invalid, trying with strategy = "+ std::to_string(strategy_counter)+ ".");
+    DMSS_LOG_ERROR("Migrad min is invalid, trying with strategy = "+ std::to_string(strategy_counter)+ ".");
     ROOT::Minuit2::MnMigrad migrad(fcn, upar, strategy_counter);
     min = migrad();
   }
   //.................
 
-  // output
-  std::cout<<"minimum: "<<min<<std::endl;
-
   // ****************
   //  Error analysis
   // ****************
@@ -953,16 +1200,204 @@ void Analysis::FitBin(Bin b, const size_t& sat_idx)
   ROOT::Minuit2::MnMinos Minos(fcn, min);
 
   // MINOS errors
+  fcn.SetErrorDef(err_def) ;
+
+  out.seed = FitSeed(min) ;
+  out.e0 = Minos.Minos(0); // get parameter 0's error
+  out.e1 = Minos.Minos(1); // get parameter 1's error
+
+  std::stringstream ss ;
+  ss << "\n --------> b.GetTBinObsSet()[0].val: " << b.GetTBinObsSet()[0].val << "\n" ;
+  ss << "minimum: " << min << "\n" ;
+  out.summary = ss.str() ;
+
+  // Only the valid fits are cached (a seeded refit may succeed)
+  if (out.e0.IsValid())
+  {
+    cached.clear() ;
+    out.e0.Pack(cached) ;
+    out.e1.Pack(cached) ;
+    out.seed.Pack(cached) ;
+    FitCache::Get().Save(minuit_key, cached) ;
+  }
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+// The likelihood of a bin only depends on the counts (& their 
+//  errors) of its time bins, and on the signal shape (& the 
+//  widths of its bins, if they vary)
+void Analysis::AddFitInputs(FitCache::Key& key, const Bin& b, const TH1F& sig_shape)
+{
+  std::vector<double> vals ;
+  for (auto&& q : b.GetTBinObsSet())
+  {
+    vals.push_back(q.val) ;
+    vals.push_back(q.err) ;
+  }
+  key.Add(vals) ;
+
+  vals.clear() ;
+  for (int i = 0 ; i <= sig_shape.GetNbinsX() + 1 ; ++i)
+    vals.push_back(sig_shape.GetBinContent(i)) ;
+  key.Add(vals) ;
+
+  if (sig_shape.GetXaxis()->IsVariableBinSize())
+    key.Add(Bin::RelWidths(sig_shape)) ;
+}
+
+//--------------------------------------------------------------
+// The Asimov dataset of the background hypothesis has the 
+//  expected counts in every time bin, so its limit is the
+//  median limit. Asymptotically (Cowan et al., EPJC 71, 1554)
+//   -2 Delta Ln L(mu) = ((mu - mu_hat) / sigma)^2,
+//  with mu_hat ~ N(0, sigma) under the background hypothesis,
+//  so the limit mu_hat + sigma*sqrt(q) has the bands 
+//  sigma*(sqrt(q) + N), and sigma follows from the median.
+Analysis::ExpectedLimit Analysis::FitBinAsimov(const Bin& b, const TH1F& sig_shape) const
+{
+  // Background-only fit: the mean count of the time bins (per
+  //  unit of their relative widths, whose mean is 1)
+  const std::vector<Zaki::Math::Quantity>& obs = b.GetTBinObsSet() ;
+  const std::vector<double> width = Bin::RelWidths(sig_shape) ;
+  double bg = 0 ;
+  for (auto&& o : obs)
+    bg += o.val ;
+  bg *= asimov_bg_scale / obs.size() ;
+
+  std::vector<double> counts ;
+  std::vector<Zaki::Math::Quantity> asimov_set ;
+  for (size_t j = 0 ; j < obs.size() ; ++j)
+  {
+    counts.push_back(bg*width[j]) ;
+    asimov_set.push_back({bg*width[j], sqrt(bg*width[j])}) ;
+  }
+
+  ExpectedLimit out ;
+  out.e_bin = b.GetECenter().val ;
+  out.bin_period = 0 ;
+
   // -2Log & chi2 have the same normalization:
-  // Zaki::Math::NDimContLevel cont_level((int)upar.Params().size(), conf_level) ;
-  // fcn.SetErrorDef(cont_level.Solve().Up);
-  fcn.SetErrorDef(ROOT::MathMore::chisquared_quantile(conf_level,
-                  (int)upar.Params().size())) ;
+  const double q = ROOT::Minuit2::LogLikeli::ChiSqQuantile(conf_level, 2) ;
+
+  // The dedicated fitter first (Minuit if it fails)
+  std::vector<double> sig ;
+  for (size_t j = 0 ; j < obs.size() ; ++j)
+    sig.push_back(sig_shape.GetBinContent(j+1)) ;
+
+  PoissonFitter::Result res = PoissonFitter(counts, sig, width).Fit(q) ;
+  if (res.valid && res.mu_err.IsValid())
+  {
+    const double median = res.mu_err.Min() + res.mu_err.Upper() ;
+    const double sigma  = median / sqrt(q) ;
+    for (int n = -2 ; n <= 2 ; ++n)
+      out.band[n + 2] = std::max(0.0, sigma*(sqrt(q) + n)) ;
+
+    return out ;
+  }
+  DMSS_LOG_NOTE("The Poisson fit failed, using Minuit.") ;
+
+  ROOT::Minuit2::LogLikeli   fcn;
+
+  fcn.AddObsSet(asimov_set) ;
+  fcn.AddSigShape(sig_shape)  ;
+
+  //(para_name, para_start_value, para_uncertainties)
+  ROOT::Minuit2::MnUserParameters upar ;
+  upar.Add("mu", 3e-4, 1e-7);
+  upar.Add("bg", bg, 1);
 
-  ROOT::Minuit2::MinosError e0 = Minos.Minos(0); // get parameter 0's error
-  ROOT::Minuit2::MinosError e1 = Minos.Minos(1); // get parameter 1's error
+  // set limits
+  upar.SetLowerLimit("mu", 0);
+
+  ROOT::Minuit2::MnMigrad migrad(fcn, upar, 2);
+  ROOT::Minuit2::FunctionMinimum min = migrad();
+
+  fcn.SetErrorDef(q) ;
+
+  ROOT::Minuit2::MnMinos Minos(fcn, min);
+  ROOT::Minuit2::MinosError e0 = Minos.Minos(0);
+
+  char tmp_char[150] ;
+  sprintf(tmp_char, " ---> Asimov fit for E=%.1f, t = %d is invalid!", b.GetECenter().val, sig_shape.GetSize()) ;
+  if(!min.IsValid() || !e0.IsValid()) DMSS_LOG_ERROR(tmp_char) ;
+
+  const double median = e0.Min() + e0.Upper() ;
+  const double sigma  = median / sqrt(q) ;
+  for (int n = -2 ; n <= 2 ; ++n)
+    out.band[n + 2] = std::max(0.0, sigma*(sqrt(q) + n)) ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+// The toys of a bin have their own seed, so its limit doesn't
+//  depend on the other bins, or on the threads
+Analysis::CLsResult Analysis::FitBinCLs(const Bin& b, const TH1F& sig_shape,
+                                        const uint64_t& seed) const
+{
+  // The limit is determined by the counts, the signal shape, 
+  //  the C.L. and the toys (their seed & numbers)
+  FitCache::Key key("thresh_cls") ;
+  AddFitInputs(key, b, sig_shape) ;
+  key.Add(conf_level).Add(std::to_string(seed))
+     .Add((double)cls_toys_min).Add((double)cls_toys_max) ;
+
+  CLsResult out ;
+  out.e_bin      = b.GetECenter().val ;
+  out.bin_period = 0 ;
+
+  std::vector<double> cached ;
+  if (FitCache::Get().Find(key.Str(), cached) && cached.size() == 3)
+  {
+    out.limit       = cached[0] ;
+    out.wilks_limit = cached[1] ;
+    out.n_toys      = (size_t)cached[2] ;
+    return out ;
+  }
+
+  const std::vector<Zaki::Math::Quantity>& obs = b.GetTBinObsSet() ;
+  std::vector<double> counts, sig ;
+  for (size_t j = 0 ; j < obs.size() ; ++j)
+  {
+    counts.push_back(obs[j].val) ;
+    sig.push_back(sig_shape.GetBinContent(j+1)) ;
+  }
+
+  const std::vector<double> width = Bin::RelWidths(sig_shape) ;
+
+  CLsLimit cls(counts, sig, seed, width) ;
+  cls.SetToys(cls_toys_min, cls_toys_max) ;
+
+  out.limit      = cls.Limit(conf_level) ;
+  out.n_toys     = cls.NToys() ;
+
+  // The profile-likelihood limit, as in 'FitBinMinos'
+  const double q = ROOT::Minuit2::LogLikeli::ChiSqQuantile(conf_level, 2) ;
+  PoissonFitter::Result fit = PoissonFitter(counts, sig, width).Fit(q) ;
+  out.wilks_limit = fit.valid ? fit.mu_err.Min() + fit.mu_err.Upper() 
+                              : std::numeric_limits<double>::quiet_NaN() ;
+
+  char tmp_char[150] ;
+  sprintf(tmp_char, " ---> CLs limit for E=%.1f, t = %d is invalid!", b.GetECenter().val, sig_shape.GetSize()) ;
+  if(std::isnan(out.limit)) DMSS_LOG_ERROR(tmp_char) ;
+  else
+    FitCache::Get().Save(key.Str(), {out.limit, out.wilks_limit, (double)out.n_toys}) ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+// Prints, plots and stores the result of a threshold fit
+void Analysis::StoreBinFit(const size_t& sat_idx, const Bin& b,
+                           const TH1F& sig_shape, const ThreshFit& fit)
+{
+  const MinosResult& e0 = fit.e0 ;
+  const MinosResult& e1 = fit.e1 ;
 
   // output
+  std::cout << fit.summary << std::flush ;
   Z_LOG_INFO("Minos errors: ") ;
   std::cout<<e0<<"\n"<<e1<<"\n";
 
@@ -976,17 +1411,62 @@ void Analysis::FitBin(Bin b, const size_t& sat_idx)
 
   double out = Histgen(sat_idx, e0, e1, b, sig_shape) ;
 
-  // thresh_limits_true.push_back(
-  //   (e0.Min() + e0.Upper())
-  //   *m_SatBundles[sat_idx]->GetNumScaling() / m_SatBundles[sat_idx]->GetExpNorm() 
-  //   ) ;
-
   thresh_limits_true.push_back(
     (e0.Min() + e0.Upper()) * m_SatBundles[sat_idx]->GetNumScaling()  ) ;
 
   thresh_limits.push_back(out);
   e_bins.push_back(b.GetECenter().val);
-    // fitted_bins.push_back(b) ;
+}
+
+//--------------------------------------------------------------
+// Parallel per-bin driver:
+//  Time-binning changes the satellite's state, so the tasks are
+//  prepared serially, a window at a time (bounding the memory).
+//  'work' runs in parallel on each window, and 'finish' runs
+//  serially in the input order, so the results are deterministic.
+//  The tasks of a chain (of 'chain_len' consecutive tasks) run in
+//  order, and a window always holds whole chains.
+void Analysis::RunThreshTasks(const size_t& sat_idx,
+                              const std::vector<std::pair<size_t, size_t>>& idx,
+                              const std::function<void(ThreshTask&)>& work,
+                              const std::function<void(ThreshTask&)>& finish,
+                              const size_t& chain_len)
+{
+  // Allowing concurrent histogram creation in ROOT
+  ROOT::EnableThreadSafety() ;
+
+  TaskPool& pool = TaskPool::Get() ;
+  const size_t len    = std::max<size_t>(1, chain_len) ;
+  const size_t window = 2*pool.Size()*len ;
+
+  std::vector<ThreshTask> tasks ;
+  tasks.reserve(window) ;
+
+  for (size_t start = 0 ; start < idx.size() ; start += window)
+  {
+    size_t end = std::min(start + window, idx.size()) ;
+
+    tasks.clear() ;
+    for (size_t k = start ; k < end ; ++k)
+    {
+      Bin b = m_SatBundles[sat_idx].GetTimeBin(idx[k].first, idx[k].second) ;
+      TH1F sig_shape = m_SatBundles[sat_idx]->GetSigShape(b.GetECenter().val) ;
+      sig_shape.SetDirectory(nullptr) ;
+      tasks.push_back({k, idx[k].first, idx[k].second, std::move(b), sig_shape}) ;
+    }
+
+    pool.ParallelFor((tasks.size() + len - 1) / len, [&](size_t c)
+    {
+      for (size_t k = c*len ; k < std::min(tasks.size(), (c+1)*len) ; ++k)
+        work(tasks[k]) ;
+    }) ;
+
+    // The fits' messages come before their results
+    AsyncLog::Flush() ;
+
+    for (auto&& t : tasks)
+      finish(t) ;
+  }
 }
 
 //--------------------------------------------------------------
@@ -1040,42 +1520,394 @@ void Analysis::FitThreshold(const size_t& sat_idx,
   else
     Z_LOG_INFO("Directory '"+m_SatBundles[sat_idx]->GetWrkDir().Str()+"/Fit' created."); 
   // .................................................
+  // (energy bin, time bin) pairs
+  std::vector<std::pair<size_t, size_t>> idx ;
   if(in_bins_idx)
   {
     size_t j = 0 ;
     for(size_t i : *in_bins_idx)
-    {
-      // Bin b = satPtrSet[sat_idx]->GetData().GetBins()[i];
-
-      // satPtrSet[sat_idx]->TimeBin(all_bin_periods[j++]);
-
-      // size_t chops = satPtrSet[sat_idx]->GetSigShape(b.GetECenter().val).GetSize() -2  ;
-      // // std::cout<<"\n Size - 2 = "<<chops<<" \n"<<std::flush;
-      // b.divide(chops);
-      // FitBin(b, b.GetECenter().val, sat_idx) ;
-      FitBin(m_SatBundles[sat_idx].GetTimeBin(i,j++), sat_idx) ;
-    }
+      idx.emplace_back(i, j++) ;
   } 
   else
   {
-    for(size_t i=0 ; i < m_SatBundles[sat_idx]->GetData().GetBins().size() ; ++i)
-    {
-      // Bin b = satPtrSet[sat_idx]->GetData().GetBins()[i];
-
-      // satPtrSet[sat_idx]->TimeBin(all_bin_periods[i]);
-
-      // size_t chops = satPtrSet[sat_idx]->GetSigShape(b.GetECenter().val).GetSize() -2  ;
-      // // std::cout<<"\n Size - 2 = "<<chops<<" \n"<<std::flush;
-      // b.divide(chops);
-      // FitBin(b, b.GetECenter().val, sat_idx) ;
-      FitBin(m_SatBundles[sat_idx].GetTimeBin(i,i), sat_idx) ;
-    }
+    for(size_t i=0 ; i < m_SatBundles[sat_idx]->GetData().size() ; ++i)
+      idx.emplace_back(i, i) ;
   }
-  
-  // Bin my_bin ;
 
-}
+  // The finished fits are skipped when resuming
+  std::vector<std::string> keys ;
+  for (auto&& i : idx)
+    keys.push_back(UnitKey("thresh_fit|" + m_SatBundles[sat_idx]->GetName() 
+                           + "|b=" + std::to_string(i.first) 
+                           + "|T=" + std::to_string(GetBinPeriod(sat_idx)[i.second]))) ;
 
+  // {thresh_limits_true, thresh_limits, e_bins} of the finished fits
+  std::vector<std::vector<double>> done(idx.size()) ;
+
+  // Fits run in parallel, plotting & storing in the bin order.
+  //  The neighbouring bins are chained: each fit starts from
+  //  the previous bin's minimum.
+  std::vector<ThreshFit> fits(idx.size()) ;
+  FitChain chain(idx.size(), fit_chain) ;
+  RunThreshTasks(sat_idx, idx,
+    [&](ThreshTask& task) 
+    { 
+      if (checkpoint && checkpoint->Find(keys[task.pos], done[task.pos]))
+        return ;
+
+      fits[task.pos] = FitBinMinos(task.bin, task.sig_shape, chain.Prev(task.pos)) ; 
+      chain.Set(task.pos, fits[task.pos].seed) ;
+    },
+    [&](ThreshTask& task) 
+    { 
+      if (done[task.pos].size() == 3)
+      {
+        thresh_limits_true.push_back(done[task.pos][0]) ;
+        thresh_limits.push_back(done[task.pos][1]) ;
+        e_bins.push_back(done[task.pos][2]) ;
+        return ;
+      }
+
+      StoreBinFit(sat_idx, task.bin, task.sig_shape, fits[task.pos]) ; 
+      if (checkpoint) 
+        checkpoint->Save(keys[task.pos], {thresh_limits_true.back(), 
+                                          thresh_limits.back(), e_bins.back()}) ;
+    }, chain.Length()) ;
+
+}
+
+
+//--------------------------------------------------------------
+/// Expected limits (Asimov), the bins are chosen as in 'FitThreshold'
+void Analysis::FitThreshAsimov(const size_t& sat_idx,
+ std::vector<size_t>* in_bins_idx)
+{
+  if(in_bins_idx && 
+     in_bins_idx->size() != m_SatBundles[sat_idx].GetBinPeriod().size() )
+  {
+    Z_LOG_ERROR(" The bin periods set size doesn't match the input size.") ;
+    return;
+  }
+
+  expected_limits.clear() ;
+
+  // ............ Creating a directory ............
+  if (mkdir((m_SatBundles[sat_idx]->GetWrkDir()+"/Fit").Str().c_str(), ACCESSPERMS) == -1) 
+  {
+    Z_LOG_NOTE("Directory '"+m_SatBundles[sat_idx]->GetWrkDir().Str()+"/Fit' wasn't created, because: "+strerror(errno)+".") ;  
+  }
+  // .................................................
+
+  // (energy bin, time bin) pairs
+  std::vector<std::pair<size_t, size_t>> idx ;
+  if(in_bins_idx)
+  {
+    size_t j = 0 ;
+    for(size_t i : *in_bins_idx)
+      idx.emplace_back(i, j++) ;
+  } 
+  else
+  {
+    for(size_t i=0 ; i < m_SatBundles[sat_idx]->GetData().size() ; ++i)
+      idx.emplace_back(i, i) ;
+  }
+
+  // One fit per bin, in parallel
+  std::vector<ExpectedLimit> fits(idx.size()) ;
+  RunThreshTasks(sat_idx, idx,
+    [&](ThreshTask& task) 
+    { 
+      fits[task.pos] = FitBinAsimov(task.bin, task.sig_shape) ; 
+    },
+    [&](ThreshTask& task) 
+    { 
+      ExpectedLimit& lim = fits[task.pos] ;
+      lim.bin_period = GetBinPeriod(sat_idx)[task.t_idx] ;
+
+      // Same scaling as the observed limits
+      for (double& v : lim.band)
+        v *= m_SatBundles[sat_idx]->GetNumScaling() ;
+
+      char tmp_char[200] ;
+      sprintf(tmp_char, "Expected limit (E = %.1f GeV, T = %d): %.2e [%.2e, %.2e]",
+              lim.e_bin, lim.bin_period, lim.band[2], lim.band[1], lim.band[3]) ;
+      Z_LOG_INFO(tmp_char) ;
+
+      expected_limits.push_back(lim) ;
+    }) ;
+
+  // E, T, -2σ, -1σ, median, +1σ, +2σ
+  std::vector<std::vector<double>> out ;
+  for (auto&& lim : expected_limits)
+    out.push_back({lim.e_bin, (double)lim.bin_period, lim.band[0], lim.band[1],
+                   lim.band[2], lim.band[3], lim.band[4]}) ;
+
+  Zaki::File::VecSaver my_saver(m_SatBundles[sat_idx]->GetWrkDir() + "/Fit/Asimov_Limits_" 
+                                + m_SatBundles[sat_idx]->GetName() + ".tsv", 
+                                Zaki::File::FileMode::Write) ;
+  my_saver.Export2D(out, "\t") ;
+}
+
+//--------------------------------------------------------------
+/// CLs limits, the bins are chosen as in 'FitThreshold'
+void Analysis::FitThreshCLs(const size_t& sat_idx,
+ std::vector<size_t>* in_bins_idx)
+{
+  if(in_bins_idx && 
+     in_bins_idx->size() != m_SatBundles[sat_idx].GetBinPeriod().size() )
+  {
+    Z_LOG_ERROR(" The bin periods set size doesn't match the input size.") ;
+    return;
+  }
+
+  cls_limits.clear() ;
+
+  // ............ Creating a directory ............
+  if (mkdir((m_SatBundles[sat_idx]->GetWrkDir()+"/Fit").Str().c_str(), ACCESSPERMS) == -1) 
+  {
+    Z_LOG_NOTE("Directory '"+m_SatBundles[sat_idx]->GetWrkDir().Str()+"/Fit' wasn't created, because: "+strerror(errno)+".") ;  
+  }
+  // .................................................
+
+  // (energy bin, time bin) pairs
+  std::vector<std::pair<size_t, size_t>> idx ;
+  if(in_bins_idx)
+  {
+    size_t j = 0 ;
+    for(size_t i : *in_bins_idx)
+      idx.emplace_back(i, j++) ;
+  } 
+  else
+  {
+    for(size_t i=0 ; i < m_SatBundles[sat_idx]->GetData().size() ; ++i)
+      idx.emplace_back(i, i) ;
+  }
+
+  // The toys of a bin depend on the base seed, the satellite and
+  //  the (energy, time) bin (FNV-1a hash of the name)
+  uint64_t sat_hash = 1469598103934665603ULL ;
+  for (const char c : m_SatBundles[sat_idx]->GetName())
+    sat_hash = (sat_hash ^ (unsigned char)c) * 1099511628211ULL ;
+
+  // The bins in parallel (and their toys, in the same pool)
+  std::vector<CLsResult> fits(idx.size()) ;
+  RunThreshTasks(sat_idx, idx,
+    [&](ThreshTask& task) 
+    { 
+      const uint64_t seed = ToyRNG(cls_seed ^ sat_hash, 
+                                   ((uint64_t)task.b_idx << 32) + task.t_idx)() ;
+      fits[task.pos] = FitBinCLs(task.bin, task.sig_shape, seed) ; 
+    },
+    [&](ThreshTask& task) 
+    { 
+      CLsResult& lim = fits[task.pos] ;
+      lim.bin_period = GetBinPeriod(sat_idx)[task.t_idx] ;
+
+      // Same scaling as the observed limits
+      lim.limit       *= m_SatBundles[sat_idx]->GetNumScaling() ;
+      lim.wilks_limit *= m_SatBundles[sat_idx]->GetNumScaling() ;
+
+      char tmp_char[200] ;
+      sprintf(tmp_char, "CLs limit (E = %.1f GeV, T = %d): %.2e (profile likelihood: %.2e, %zu toys)",
+              lim.e_bin, lim.bin_period, lim.limit, lim.wilks_limit, lim.n_toys) ;
+      Z_LOG_INFO(tmp_char) ;
+
+      cls_limits.push_back(lim) ;
+    }) ;
+
+  // E, T, CLs limit, profile-likelihood limit, toys
+  std::vector<std::vector<double>> out ;
+  for (auto&& lim : cls_limits)
+    out.push_back({lim.e_bin, (double)lim.bin_period, lim.limit,
+                   lim.wilks_limit, (double)lim.n_toys}) ;
+
+  Zaki::File::VecSaver my_saver(m_SatBundles[sat_idx]->GetWrkDir() + "/Fit/CLs_Limits_" 
+                                + m_SatBundles[sat_idx]->GetName() + ".tsv", 
+                                Zaki::File::FileMode::Write) ;
+  my_saver.Export2D(out, "\t") ;
+}
+
+//--------------------------------------------------------------
+std::vector<Analysis::CLsResult> Analysis::GetCLsLimits() const
+{
+  return cls_limits ;
+}
+
+//--------------------------------------------------------------
+void Analysis::SetCLsToys(const size_t& in_min, const size_t& in_max)
+{
+  cls_toys_min = std::max<size_t>(1, in_min) ;
+  cls_toys_max = std::max(cls_toys_min, in_max) ;
+}
+
+//--------------------------------------------------------------
+void Analysis::SetCLsSeed(const uint64_t& in_seed)
+{
+  cls_seed = in_seed ;
+}
+
+//--------------------------------------------------------------
+// With J time bins of N/J counts, the asymptotic error on mu is
+//   sigma^2 = (N/J) / sum_j (s_j - <s>)^2 ,
+//  which only takes a rebinning, so the dominated periods are
+//  dropped before any fit. The Asimov fits of the rest run in
+//  parallel, with the candidates as the satellite's bin periods.
+std::vector<int> Analysis::OptimizeBinPeriods(const size_t& sat_idx,
+                                              const std::vector<int>& candidates,
+                                              const double& prune_ratio)
+{
+  const std::vector<int> periods = GetBinPeriod(sat_idx) ;
+  if (candidates.empty())
+  {
+    Z_LOG_ERROR(" No candidate bin periods.") ;
+    return periods ;
+  }
+
+  // The periods replace any variable-width time bins
+  if (!m_SatBundles[sat_idx].GetBinEdges().empty())
+  {
+    Z_LOG_WARNING("The variable-width time bins of '" + m_SatBundles[sat_idx]->GetName() 
+                  + "' are replaced by the optimized bin periods.") ;
+    m_SatBundles[sat_idx].SetBinEdges({}) ;
+  }
+
+  // ............ Creating a directory ............
+  if (mkdir((m_SatBundles[sat_idx]->GetWrkDir()+"/Fit").Str().c_str(), ACCESSPERMS) == -1) 
+  {
+    Z_LOG_NOTE("Directory '"+m_SatBundles[sat_idx]->GetWrkDir().Str()+"/Fit' wasn't created, because: "+strerror(errno)+".") ;  
+  }
+  // .................................................
+
+  const size_t n_e = m_SatBundles[sat_idx]->GetData().size() ;
+  const size_t n_c = candidates.size() ;
+  const double inf = std::numeric_limits<double>::infinity() ;
+  const double NaN = std::numeric_limits<double>::quiet_NaN() ;
+
+  // ............ The asymptotic errors ............
+  // Infinite if the signal is flat (or there's a single time bin)
+  std::vector<std::vector<double>> sigma(n_e, std::vector<double>(n_c, inf)) ;
+  for (size_t k = 0 ; k < n_c ; ++k)
+  {
+    m_SatBundles[sat_idx]->TimeBin(candidates[k]) ;
+    for (size_t b = 0 ; b < n_e ; ++b)
+    {
+      const Bin& bin = m_SatBundles[sat_idx]->GetData()[b] ;
+      TH1F sig_shape = m_SatBundles[sat_idx]->GetSigShape(bin.GetECenter().val) ;
+      sig_shape.SetDirectory(nullptr) ;
+
+      const int n_t = sig_shape.GetNbinsX() ;
+      if (n_t < 2) continue ;
+
+      double mean = 0, var = 0 ;
+      for (int j = 1 ; j <= n_t ; ++j)
+        mean += sig_shape.GetBinContent(j) ;
+      mean /= n_t ;
+      for (int j = 1 ; j <= n_t ; ++j)
+        var += pow(sig_shape.GetBinContent(j) - mean, 2) ;
+
+      if (var > 0)
+        sigma[b][k] = sqrt(bin.GetNCount().val / n_t / var) ;
+    }
+  }
+
+  // (energy bin, candidate) pairs that aren't dominated
+  std::vector<std::pair<size_t, size_t>> idx ;
+  std::vector<size_t> n_fits(n_e, 0) ;
+  for (size_t b = 0 ; b < n_e ; ++b)
+  {
+    double best = *std::min_element(sigma[b].begin(), sigma[b].end()) ;
+    for (size_t k = 0 ; k < n_c ; ++k)
+      if (std::isfinite(sigma[b][k]) && sigma[b][k] <= prune_ratio*best)
+      {
+        idx.emplace_back(b, k) ;
+        n_fits[b]++ ;
+      }
+  }
+  // ...............................................
+
+  char tmp_char[200] ;
+  sprintf(tmp_char, "Fitting %zu of the %zu (bin, period) pairs.", idx.size(), n_e*n_c) ;
+  Z_LOG_INFO(tmp_char) ;
+
+  // Median limits, NaN if dominated
+  std::vector<std::vector<double>> limits(n_e, std::vector<double>(n_c, NaN)) ;
+  m_SatBundles[sat_idx].SetBinPeriod(candidates) ;
+  RunThreshTasks(sat_idx, idx,
+    [&](ThreshTask& task) 
+    { 
+      limits[task.b_idx][task.t_idx] = FitBinAsimov(task.bin, task.sig_shape).band[2] ; 
+    },
+    [&](ThreshTask& task) 
+    { 
+      // Same scaling as the observed limits
+      limits[task.b_idx][task.t_idx] *= m_SatBundles[sat_idx]->GetNumScaling() ;
+    }) ;
+
+  // ............ The best period of each bin ............
+  // E, T, its limit, and the limits of all the candidates
+  std::vector<int> best(n_e) ;
+  std::vector<std::vector<double>> out ;
+  for (size_t b = 0 ; b < n_e ; ++b)
+  {
+    size_t k_best = n_c ;
+    for (size_t k = 0 ; k < n_c ; ++k)
+      if (limits[b][k] > 0 && (k_best == n_c || limits[b][k] < limits[b][k_best]))
+        k_best = k ;
+
+    double e_bin = m_SatBundles[sat_idx]->GetData()[b].GetECenter().val ;
+    if (k_best == n_c)
+    {
+      sprintf(tmp_char, " ---> No valid bin period for E=%.1f, keeping T = %d!",
+              e_bin, b < periods.size() ? periods[b] : candidates[0]) ;
+      Z_LOG_ERROR(tmp_char) ;
+      best[b] = b < periods.size() ? periods[b] : candidates[0] ;
+    }
+    else
+    {
+      best[b] = candidates[k_best] ;
+      sprintf(tmp_char, "E = %.1f GeV: T = %d, expected limit %.2e (%zu of %zu periods fitted)",
+              e_bin, best[b], limits[b][k_best], n_fits[b], n_c) ;
+      Z_LOG_INFO(tmp_char) ;
+    }
+
+    out.push_back({e_bin, (double)best[b], k_best < n_c ? limits[b][k_best] : NaN}) ;
+    out.back().insert(out.back().end(), limits[b].begin(), limits[b].end()) ;
+  }
+  // .....................................................
+
+  SetBinPeriod(sat_idx, best) ;
+
+  Zaki::File::VecSaver my_saver(m_SatBundles[sat_idx]->GetWrkDir() + "/Fit/Bin_Periods_" 
+                                + m_SatBundles[sat_idx]->GetName() + ".tsv", 
+                                Zaki::File::FileMode::Write) ;
+  my_saver.Export2D(out, "\t") ;
+
+  return best ;
+}
+
+//--------------------------------------------------------------
+std::vector<Analysis::ExpectedLimit> Analysis::GetExpectedLimits() const
+{
+  return expected_limits ;
+}
+
+//--------------------------------------------------------------
+void Analysis::SetAsimovBgScale(const double& in_scale)
+{
+  asimov_bg_scale = in_scale ;
+}
+
+//--------------------------------------------------------------
+void Analysis::SetFastLimits(const bool in_fast)
+{
+  fast_limits = in_fast ;
+}
+
+//--------------------------------------------------------------
+void Analysis::SetFitChain(const size_t& in_len)
+{
+  fit_chain = std::max<size_t>(1, in_len) ;
+}
 
 //--------------------------------------------------------------
 // Boosted Case
@@ -1087,13 +1919,17 @@ void Analysis::FitBoosted(Zaki::Math::Range<double> e_range)
     return ;
   }
 
-  Zaki::String::Directory tmp_dir("") ;
-
-  if(m_SatBundles.size() == 0 )
-  {
-    Z_LOG_ERROR("Satellite not attached!") ;
+  if(!MakeBoostFitDir())
     return ;
-  }
+
+  StoreBoostFit(FitBoostedMass(PrepBoostSet(), *modelPtr, e_range)) ;
+}
+
+//--------------------------------------------------------------
+// Creates the 'Fit' directory for the boosted fit results
+bool Analysis::MakeBoostFitDir()
+{
+  Zaki::String::Directory tmp_dir("") ;
 
   if(m_SatBundles.size() == 1)
   {
@@ -1104,7 +1940,7 @@ void Analysis::FitBoosted(Zaki::Math::Range<double> e_range)
   else
   {
     Z_LOG_ERROR("Satellite not attached!") ;
-    return ;
+    return false ;
   }
   
 
@@ -1117,19 +1953,93 @@ void Analysis::FitBoosted(Zaki::Math::Range<double> e_range)
     Z_LOG_INFO("Directory '"+tmp_dir.Str()+"/Fit' created."); 
   // .................................................
 
-  // Cleaning up to avoid bugs
-  // otherwise calling FitThreshold twice 
-  // will keep growing the following vectors:
-  if( boost_fit_results.size()!=0 ||
-      focus_bin_periods.size()!=0 ||  focus_bins.size() != 0 )
+  return true ;
+}
+
+//--------------------------------------------------------------
+// Time-bins the bins of the satellites in 'sat_set' (all of them 
+//  if empty), and normalizes their signal shapes to the mean exposure.
+//  Time-binning changes the satellites' state, so this runs serially.
+Analysis::BoostSet Analysis::PrepBoostSet(std::vector<size_t> sat_set)
+{
+  if(sat_set.empty())
+    for(size_t sat_j=0 ; sat_j < m_SatBundles.size() ; ++sat_j)
+      sat_set.push_back(sat_j) ;
+
+  BoostSet out ;
+
+  size_t bins_size = 0 ;
+  for(size_t sat_j : sat_set)
   {
-    Z_LOG_NOTE("Clearing the previous boosted fit results...") ;
-    focus_bins.clear() ;
-    focus_bin_periods.clear() ;
-    boost_fit_results.clear() ;
-    boost_fit_val = 0 ;
-  } 
-  //....................................................
+    bins_size += m_SatBundles[sat_j]->GetData().size() ;
+    out.mean_scale_factor +=  m_SatBundles[sat_j]->GetNumScaling()/ sat_set.size() ;
+    out.mean_exposure +=  m_SatBundles[sat_j]->GetExpNorm()/ sat_set.size() ;
+  }
+
+  // This Saves the allocation time
+  out.bins.reserve(bins_size) ;
+  // _______________________1st Loop__________________________
+  for(size_t sat_j : sat_set)
+  {
+    // _______________________2nd Loop__________________________
+    for(size_t i=0 ; i < m_SatBundles[sat_j]->GetData().size() ; ++i)
+    {
+      // Time-binning & dividing the bin into same pieces as the sigshape
+      Bin b = m_SatBundles[sat_j].GetTimeBin(i, i) ;
+
+      // Getting the signal shape from Satellite 
+      TH1F tmp_sig_hist = m_SatBundles[sat_j]->GetSigShape(b.GetECenter().val) ;
+      tmp_sig_hist.SetDirectory(nullptr) ;
+
+      tmp_sig_hist.Scale(m_SatBundles[sat_j]->GetExpNorm()/out.mean_exposure) ;
+      tmp_sig_hist.Scale(out.mean_scale_factor /m_SatBundles[sat_j]->GetNumScaling()) ;
+
+      out.bins.push_back({sat_j, i, m_SatBundles[sat_j].GetBinPeriod()[i],
+                          std::move(b), tmp_sig_hist}) ;
+    }
+  // _________________________________________________________
+  }
+  // _________________________________________________________
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+// Runs 'work' for every DM mass in the model's mass set in parallel.
+//  Each mass gets its own copy of the model, so the shared model
+//  isn't changed. The masses of a chain run in order.
+void Analysis::SweepDMMass(const std::function<void(size_t, Model&)>& work,
+                           const size_t& chain_len) 
+{
+  // Allowing concurrent histogram creation in ROOT
+  ROOT::EnableThreadSafety() ;
+
+  std::vector<double> mass_set = modelPtr->GetDMMassSet() ;
+
+  // The copies are made serially
+  std::vector<std::unique_ptr<Model>> models ;
+  models.reserve(mass_set.size()) ;
+  for (size_t i = 0; i < mass_set.size(); i++)
+  {
+    models.emplace_back(modelPtr->Clone()) ;
+    models[i]->SetDMMass(mass_set[i]) ;
+  }
+
+  FitChain(mass_set.size(), chain_len).Run([&](size_t i) { work(i, *models[i]) ; }) ;
+
+  // The fits' messages come before their results
+  AsyncLog::Flush() ;
+}
+
+//--------------------------------------------------------------
+// The boosted fit for the model's DM mass (the score equations,
+//  or Minuit if they fail)
+//  (thread-safe, no members are changed)
+Analysis::BoostFit Analysis::FitBoostedMass(const BoostSet& boost_set, Model& model,
+                                            const Zaki::Math::Range<double>& e_range,
+                                            const FitSeed* seed) const
+{
+  BoostFit out ;
 
   // ROOT::Minuit2::MnMachinePrecision minuit_prec ;
   // minuit_prec.SetPrecision(1e-11) ;
@@ -1137,6 +2047,9 @@ void Analysis::FitBoosted(Zaki::Math::Range<double> e_range)
   // Likelihood Function
   ROOT::Minuit2::LogLikeli  fcn ;
 
+  // The same likelihood, for the score-equation solver
+  LikeLi_Eq eq ;
+
   // Fitting Parameters
   ROOT::Minuit2::MnUserParameters upar;
 
@@ -1148,94 +2061,155 @@ void Analysis::FitBoosted(Zaki::Math::Range<double> e_range)
 
   upar.SetLowerLimit("mu", 0);
 
-  //................................................................
-  size_t focus_bins_size = 0 ;
-  double mean_scale_factor = 0 ;
-  double mean_exposure = 0 ;
-
-  for(size_t sat_j=0 ; sat_j < m_SatBundles.size() ; ++sat_j)
-  {
-    focus_bins_size += m_SatBundles[sat_j]->GetData().GetBins().size() ;
-    mean_scale_factor +=  m_SatBundles[sat_j]->GetNumScaling()/ m_SatBundles.size() ;
-    mean_exposure +=  m_SatBundles[sat_j]->GetExpNorm()/ m_SatBundles.size() ;
-  }
+  // The fit is determined by the counts & the signal shapes 
+  //  of the bins in the energy range, and the C.L.
+  FitCache::Key key("boost_minos") ;
+  key.Add(e_range.min).Add(e_range.max).Add(conf_level) ;
 
+  //................................................................
   // This Saves the allocation time
-  focus_bins.reserve(focus_bins_size) ;
-  focus_bin_periods.reserve(focus_bins_size) ;
-  // _______________________1st Loop__________________________
-  for(size_t sat_j=0 ; sat_j < m_SatBundles.size() ; ++sat_j)
+  out.bins.reserve(boost_set.bins.size()) ;
+  out.periods.reserve(boost_set.bins.size()) ;
+  for(auto&& bb : boost_set.bins)
   {
-    // _______________________2nd Loop__________________________
-    for(size_t i=0 ; i < m_SatBundles[sat_j]->GetData().GetBins().size() ; ++i)
-    {
-      Bin b = m_SatBundles[sat_j]->GetData().GetBins()[i];
-      // ..............................
-      // out of spectrum condition
-      if( b.GetERange().min >= e_range.max || b.GetERange().max <= e_range.min )
-        continue ; 
-      
-      focus_bins.push_back(b) ;
-      focus_bin_periods.push_back(m_SatBundles[sat_j].GetBinPeriod()[i]) ;
-      // ..............................
-
-      // Time-binning
-      m_SatBundles[sat_j]->TimeBin(m_SatBundles[sat_j].GetBinPeriod()[i]);
+    const Bin& b = bb.bin ;
+    // ..............................
+    // out of spectrum condition
+    if( b.GetERange().min >= e_range.max || b.GetERange().max <= e_range.min )
+      continue ; 
+    
+    out.bins.push_back(b) ;
+    out.periods.push_back(bb.period) ;
+    // ..............................
 
-      // Getting the signal shape from Satellite 
-      TH1F tmp_sig_hist = m_SatBundles[sat_j]->GetSigShape(b.GetECenter().val) ;
+    // Scaling the histogram by the energy-dependent 
+    //  spectrum of the model
+    TH1F tmp_sig_hist = bb.sig_shape ;
+    tmp_sig_hist.Scale(model.GetSpectrum(out.bins.back())) ;
 
-      // Dividing the bin into same pieces as the sigshape
-      b.divide(tmp_sig_hist.GetSize() -2 );
+    fcn.AddObsCounts(b) ;
+    fcn.AddSigShape(tmp_sig_hist)  ;
+    eq.AddObsCounts(b) ;
+    eq.AddSigShape(tmp_sig_hist) ;
+    AddFitInputs(key, b, tmp_sig_hist) ;
 
-      // Scaling the histogram by the energy-dependent 
-      //  spectrum of the model
-      tmp_sig_hist.Scale(modelPtr->GetSpectrum(b)) ;
+    std::string bg_par_str = "bg_" + std::to_string(bb.sat_j) 
+                            + "_"+ std::to_string(bb.b_idx);  
 
-      tmp_sig_hist.Scale(m_SatBundles[sat_j]->GetExpNorm()/mean_exposure) ;
-      tmp_sig_hist.Scale(mean_scale_factor /m_SatBundles[sat_j]->GetNumScaling()) ;
+    Zaki::Math::Quantity tmp_obs_q = b.GetTBinObsSet()[0] ;
+    // double tmp_min_lim = ( tmp_obs_q.val > 2*tmp_obs_q.err > 0 ) ? 
+    //                       tmp_obs_q.val - 2*tmp_obs_q.err : 0.5 ;
 
-      fcn.AddObsCounts(b) ;
-      fcn.AddSigShape(tmp_sig_hist)  ;
+    // Adding the i-th background paramater with 
+    // initial value 38 (could be anything reasonable)
+    upar.Add(bg_par_str, tmp_obs_q.val, 1, 
+            0, 4500);
+    // upar.SetLowerLimit(bg_par_str, 0.2);
+    // upar.SetUpperLimit(bg_par_str, 1000);
+  }
+  // _________________________________________________________
+
+  // The names of the parameters, for the seeds
+  std::vector<std::string> par_names ;
+  for (auto&& p : upar.Parameters())
+    par_names.push_back(p.GetName()) ;
 
-      std::string bg_par_str = "bg_" + std::to_string(sat_j) 
-                              + "_"+ std::to_string(i);  
+  std::vector<double> cached ;
+  auto find_cached = [&](const std::string& solver_key)
+  {
+    if (!FitCache::Get().Find(solver_key, cached)) 
+      return false ;
 
-      Zaki::Math::Quantity tmp_obs_q = b.GetTBinObsSet()[0] ;
-      // double tmp_min_lim = ( tmp_obs_q.val > 2*tmp_obs_q.err > 0 ) ? 
-      //                       tmp_obs_q.val - 2*tmp_obs_q.err : 0.5 ;
+    size_t pos = 0 ;
+    out.results.resize(out.bins.size()+1) ;
+    bool found = true ;
+    for (auto&& r : out.results)
+      if (!r.Unpack(cached, pos)) { found = false ; break ; }
 
-      // Adding the i-th background paramater with 
-      // initial value 38 (could be anything reasonable)
-      upar.Add(bg_par_str, tmp_obs_q.val, 1, 
-              0, 4500);
-      // upar.Add(bg_par_str, b.GetTBinObsSet()[0].val, 0.05,
-      //          b.GetTBinObsSet()[0].val - b.GetTBinObsSet()[0].err,
-      //          b.GetTBinObsSet()[0].val + b.GetTBinObsSet()[0].err);
-      // upar.SetLowerLimit(bg_par_str, 0.2);
-      // upar.SetUpperLimit(bg_par_str, 1000);
-      // upar.SetLimits(bg_par_str, 1, 100 ) ;
+    // The minimum seeds the next fit of the chain (the older
+    //  records only have the Minos values)
+    if (found && !out.seed.Unpack(cached, pos, par_names))
+    {
+      std::vector<double> par ;
+      for (auto&& r : out.results)
+        par.push_back(r.Min()) ;
+      out.seed = FitSeed(par_names, par) ;
+    }
 
+    if (found && pos == cached.size())
+    {
+      out.val = (out.results[0].Min() + out.results[0].Upper()) * boost_set.mean_scale_factor ;
+      out.summary = "\n Cached fit: " + solver_key + "\n" ;
+      return true ;
     }
-  // _________________________________________________________
+    out.results.clear() ;
+    return false ;
+  } ;
+
+  // Each solver keeps its own records (the backgrounds are only 
+  //  capped in Minuit), and the Minuit ones are only looked up 
+  //  once the score equations fail, as they'd run
+  const std::string eq_key     = FitCache::Key(key).Add("score_eq").Str() ;
+  const std::string minuit_key = FitCache::Key(key).Add("minuit|bg<=4500").Str() ;
+  if (find_cached(eq_key))
+    return out ;
+
+  // -2Log & chi2 have the same normalization:
+  double err_def = ROOT::Minuit2::LogLikeli::ChiSqQuantile(conf_level,
+                   (int)upar.Params().size()) ;
+
+  // The score equations first (Minuit if they fail)
+  eq.SetErrorDef(err_def) ;
+  if (eq.Minimize())
+  {
+    out.results.reserve(out.bins.size()+1) ;
+    for(size_t i=0 ; i < out.bins.size()+1 ; ++i)
+      out.results.push_back(eq.Minos(i)) ;
+
+    if (out.results[0].IsValid())
+    {
+      out.val  = (out.results[0].Min() + out.results[0].Upper()) * boost_set.mean_scale_factor ;
+      out.seed = FitSeed(par_names, eq.Params()) ;
+
+      cached.clear() ;
+      for (auto&& r : out.results)
+        r.Pack(cached) ;
+      out.seed.Pack(cached) ;
+      FitCache::Get().Save(eq_key, cached) ;
+
+      char tmp[300] ;
+      sprintf(tmp, "\n Score-equation fit: mu = %.6e, -2LogL = %.8e,"
+                   " %zu iterations (residual = %.2e)\n",
+              eq.Params()[0], eq.Fval(), eq.NIter(), eq.Residual()) ;
+      std::stringstream ss ;
+      ss << tmp ;
+      ss << "--> mean_scale_factor= " << boost_set.mean_scale_factor << "\n";
+      ss << "--> mean_exposure= " << boost_set.mean_exposure << "\n";
+      out.summary = ss.str() ;
+
+      return out ;
+    }
+    out.results.clear() ;
   }
-  // _________________________________________________________
+  DMSS_LOG_NOTE("The score-equation fit failed, using Minuit.") ;
+
+  if (find_cached(minuit_key))
+    return out ;
 
   // Creat MIGRAD minimizer
   int strategy_counter = 2 ;
-  ROOT::Minuit2::MnMigrad migrad(fcn, upar, strategy_counter);
 
   // migrad.SetPrecision(1e-8) ;
 
-  // Minimize
-  ROOT::Minuit2::FunctionMinimum min = migrad(4000);
+  // Minimize (from the neighbouring mass's minimum, if seeded)
+  ROOT::Minuit2::FunctionMinimum min = FitSeed::Migrad(fcn, upar, seed, strategy_counter, 4000) ;
   //.................
   // If minimization failed:
   while(!min.IsValid() && strategy_counter < 2) 
   {
     strategy_counter++ ;
     // try with higher strategy
-    Z_LOG_ERROR("Migrad min is invalid, trying with strategy = "+ std::to_string(strategy_counter)+ ".");
+    DMSS_LOG_ERROR("Migrad min is invalid, trying with strategy = "+ std::to_string(strategy_counter)+ ".");
     ROOT::Minuit2::MnMigrad migrad(fcn, upar, strategy_counter);
     min = migrad();
   }
@@ -1243,9 +2217,6 @@ void Analysis::FitBoosted(Zaki::Math::Range<double> e_range)
 
   // std::cout << "Minimum EDM = "<< min.Edm() << "\n" ;
 
-  // output
-  std::cout<<"minimum: "<<min<<std::endl;
-  
   unsigned int Minos_max_f_calls = 4000 ;
 
   ROOT::Minuit2::MnMinos Minos(fcn, min);
@@ -1255,26 +2226,39 @@ void Analysis::FitBoosted(Zaki::Math::Range<double> e_range)
   // Zaki::Math::NDimContLevel cont_level((int)upar.Params().size(), conf_level) ;
   // std::cout << "--> upar.Params().size(): " << (int)upar.Params().size() <<"\n" ;
   // fcn.SetErrorDef(cont_level.Solve().Up);
-  fcn.SetErrorDef(ROOT::MathMore::chisquared_quantile(conf_level,
-                  (int)upar.Params().size())) ;
+  fcn.SetErrorDef(err_def) ;
   // fcn.SetErrorDef(pow(2.486,2));
 
   ROOT::Minuit2::MinosError e0 = Minos.Minos(0, Minos_max_f_calls); // get parameter 0's error
   // ROOT::Minuit2::MinosError e1 = Minos.Minos(1); // get parameter 1's error 
 
-  boost_fit_results.reserve(focus_bins.size()+1) ;
-  for(size_t i=0 ; i < focus_bins.size()+1 ; ++i)
+  out.results.reserve(out.bins.size()+1) ;
+  for(size_t i=0 ; i < out.bins.size()+1 ; ++i)
   {
-    boost_fit_results.push_back( Minos.Minos(i, Minos_max_f_calls)) ;
+    out.results.push_back( Minos.Minos(i, Minos_max_f_calls)) ;
   }
   
   // boost_fit_val = (e0.Min() + e0.Upper() ) *
                   // (mean_scale_factor / mean_exposure) ;
 
-  boost_fit_val = (e0.Min() + e0.Upper() ) * mean_scale_factor ;
+  out.val = (e0.Min() + e0.Upper() ) * boost_set.mean_scale_factor ;
+  out.seed = FitSeed(min) ;
+
+  // Only the valid fits are cached (a seeded refit may succeed)
+  if (e0.IsValid())
+  {
+    cached.clear() ;
+    for (auto&& r : out.results)
+      r.Pack(cached) ;
+    out.seed.Pack(cached) ;
+    FitCache::Get().Save(minuit_key, cached) ;
+  }
 
-  std::cout << "--> mean_scale_factor= " << mean_scale_factor << "\n";
-  std::cout << "--> mean_exposure= " << mean_exposure << "\n";
+  std::stringstream ss ;
+  ss << "minimum: " << min << "\n" ;
+  ss << "--> mean_scale_factor= " << boost_set.mean_scale_factor << "\n";
+  ss << "--> mean_exposure= " << boost_set.mean_exposure << "\n";
+  out.summary = ss.str() ;
 
   // ..............................................................
   // Creates Likelihood MnContours
@@ -1382,6 +2366,32 @@ void Analysis::FitBoosted(Zaki::Math::Range<double> e_range)
   // std::cout<< " * ------------------------------------------------------- * \n" ;
   // // ------------------------------------------------------
 
+  return out ;
+}
+
+//--------------------------------------------------------------
+// Prints and stores the result of a boosted fit
+void Analysis::StoreBoostFit(BoostFit&& fit)
+{
+  // Cleaning up to avoid bugs
+  // otherwise calling FitBoosted twice 
+  // will keep growing the following vectors:
+  if( boost_fit_results.size()!=0 ||
+      focus_bin_periods.size()!=0 ||  focus_bins.size() != 0 )
+  {
+    Z_LOG_NOTE("Clearing the previous boosted fit results...") ;
+  } 
+
+  focus_bins        = std::move(fit.bins) ;
+  focus_bin_periods = std::move(fit.periods) ;
+  boost_fit_results = std::move(fit.results) ;
+  boost_fit_val     = fit.val ;
+  //....................................................
+
+  // output
+  std::cout << fit.summary << std::flush ;
+
+  const MinosResult& e0 = boost_fit_results[0] ;
 
   char tmp_char[150] ;
   sprintf(tmp_char, "\n -Lower Limit (95%%): %.2e\n -Upper Limit (95%%): %.2e",
@@ -1404,89 +2414,374 @@ void Analysis::SetConfidenceLevel(const double in_cl)
   conf_level = in_cl ;
 }
 
+//-------------------------------------------------------------------------------
+void Analysis::SetCheckpoint(const Zaki::String::Directory& f_name, const bool resume)
+{
+  checkpoint = std::make_shared<Checkpoint>(f_name, resume) ;
+}
+
+//-------------------------------------------------------------------------------
+// Identifies a unit of work in the checkpoint file, 
+//  by everything its result depends on
+std::string Analysis::UnitKey(const std::string& unit)
+{
+  char tmp[100] ;
+  sprintf(tmp, "|E_cut=%.17g|CL=%.17g", e_cut_val, conf_level) ;
+
+  std::string out = unit + tmp ;
+  for(auto& satB : m_SatBundles)
+  {
+    out += "|" + satB->GetName() + ":" ;
+    for (int p : satB.GetBinPeriod())
+      out += std::to_string(p) + "," ;
+
+    // The variable-width time bins (by their hash)
+    const std::vector<std::vector<double>> edges = satB.GetBinEdges() ;
+    if (!edges.empty())
+    {
+      FitCache::Key edge_key("edges") ;
+      for (auto&& e : edges)
+        edge_key.Add(e) ;
+      out += edge_key.Str() ;
+    }
+  }
+
+  return out ;
+}
+
+//-------------------------------------------------------------------------------
+void Analysis::SetShard(const size_t& index, const size_t& count, const size_t& tiles)
+{
+  if (count == 0 || index >= count)
+  {
+    Z_LOG_ERROR("Shard index should be in [0, count)!") ;
+    exit(EXIT_FAILURE) ;
+  }
+  shard = {index, count, tiles ? tiles : count, false} ;
+
+  // ............ Creating a directory ............
+  if (mkdir(ShardDir().Str().c_str(), ACCESSPERMS) == -1)
+  {
+    Z_LOG_NOTE("Directory '"+ShardDir().Str()+"' wasn't created, because: "+strerror(errno)+".") ;
+  }
+  // .................................................
+
+  // Re-running a shard resumes it
+  checkpoint = std::make_shared<Checkpoint>(ShardDir() + "/units_" + shard.Tag() + ".txt", true) ;
+
+  Z_LOG_INFO("Running shard " + shard.Tag() + ".") ;
+}
+
+//-------------------------------------------------------------------------------
+void Analysis::SetShardMerge(const size_t& count, const size_t& tiles)
+{
+  if (count == 0)
+  {
+    Z_LOG_ERROR("Shard count should be positive!") ;
+    exit(EXIT_FAILURE) ;
+  }
+  shard = {0, count, tiles ? tiles : count, true} ;
+
+  checkpoint = std::make_shared<Checkpoint>(ShardDir() + "/units_merged.txt", false) ;
+  for (size_t i = 0 ; i < count ; ++i)
+  {
+    Shard other = {i, count, shard.tiles, false} ;
+    if (!checkpoint->Import(ShardDir() + "/units_" + other.Tag() + ".txt"))
+      Z_LOG_ERROR("Shard " + other.Tag() + " has no results!") ;
+  }
+}
+
+//-------------------------------------------------------------------------------
+Zaki::String::Directory Analysis::ShardDir() const
+{
+  return wrk_dir + "/Shards" ;
+}
+
+//-------------------------------------------------------------------------------
+void Analysis::CheckShards(const std::string& campaign) const
+{
+  std::string missing ;
+  for (size_t i = 0 ; i < shard.count ; ++i)
+  {
+    Shard other = {i, shard.count, shard.tiles, false} ;
+    std::ifstream marker((ShardDir() + "/" + campaign + "_" + other.Tag() + ".done").Str()) ;
+    if (marker.fail())
+      missing += " " + other.Tag() ;
+  }
+
+  if (!missing.empty())
+  {
+    Z_LOG_ERROR("Shards" + missing + " haven't finished '" + campaign + "' yet!") ;
+    exit(EXIT_FAILURE) ;
+  }
+}
+
+//-------------------------------------------------------------------------------
+void Analysis::FinishShard(const std::string& campaign) const
+{
+  std::ofstream marker((ShardDir() + "/" + campaign + "_" + shard.Tag() + ".done").Str()) ;
+  marker << shard.Tag() << "\n" ;
+
+  Z_LOG_INFO("Shard " + shard.Tag() + " finished '" + campaign + "'.") ;
+}
+
+//-------------------------------------------------------------------------------
+bool Analysis::ShardSkips(const size_t& unit, const std::string& key) const
+{
+  if (shard.merge)
+  {
+    Z_LOG_ERROR("None of the shards has done '" + key + "'!") ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  return shard.Skips(unit) ;
+}
+
+//-------------------------------------------------------------------------------
+// The tiles of the plane are the units [unit, unit + tiles)
+void Analysis::ShardPlane(const std::string& plane, const size_t& unit,
+                          const Zaki::Math::Grid2D& grid, 
+                          double (Analysis::*cont_func)(double, double))
+{
+  char tmp[200] ;
+  std::vector<Zaki::String::Directory> tile_files ;
+  for (size_t k = 0 ; k < shard.tiles ; ++k)
+  {
+    sprintf(tmp, "%s_tile_%zu_of_%zu.grid", plane.c_str(), k, shard.tiles) ;
+    tile_files.emplace_back(ShardDir() + "/" + tmp) ;
+  }
+
+  // ............ Merging ............
+  if (shard.merge)
+  {
+    grid_table = std::make_shared<GridTable>(grid) ;
+    for (size_t k = 0 ; k < shard.tiles ; ++k)
+      if (!grid_table->ImportTile(k, shard.tiles, tile_files[k]))
+      {
+        Z_LOG_ERROR("Tile '" + tile_files[k].Str() + "' (shard " 
+                    + std::to_string((unit + k) % shard.count) + ") is missing!") ;
+        exit(EXIT_FAILURE) ;
+      }
+    return ;
+  }
+  // .................................
+
+  GridTable table(grid) ;
+  for (size_t k = 0 ; k < shard.tiles ; ++k)
+  {
+    if (shard.Skips(unit + k)) continue ;
+
+    std::vector<double> done ;
+    std::string key = UnitKey("tile|" + tile_files[k].Str()) ;
+    if (checkpoint->Find(key, done)) continue ;
+
+    table.Fill(k, shard.tiles, [&](double x, double y) { return (this->*cont_func)(x, y) ; }) ;
+    table.ExportTile(k, shard.tiles, tile_files[k]) ;
+    checkpoint->Save(key, {1}) ;
+  }
+}
+
+//-------------------------------------------------------------------------------
+// The values are kept in '<dir>/Grids/<plane>.grid'
+void Analysis::StorePlane(const std::string& dir, const std::string& plane,
+                          const Zaki::Math::Grid2D& grid, 
+                          double (Analysis::*cont_func)(double, double),
+                          const bool reuse)
+{
+  Zaki::String::Directory grid_dir = wrk_dir + "/" + dir + "/Grids" ;
+
+  // ............ Creating a directory ............
+  if (mkdir(grid_dir.Str().c_str(), ACCESSPERMS) == -1)
+  {
+    Z_LOG_NOTE("Directory '"+grid_dir.Str()+"' wasn't created, because: "+strerror(errno)+".") ;
+  }
+  // .................................................
+
+  Zaki::String::Directory grid_file = grid_dir + "/" + plane + ".grid" ;
+
+  // Already imported from the shards' tiles
+  if (grid_table)
+  {
+    grid_table->SetLabel(plane) ;
+    grid_table->Export(grid_file) ;
+    return ;
+  }
+
+  std::shared_ptr<GridTable> table = std::make_shared<GridTable>(grid) ;
+  if (reuse && table->Import(grid_file))
+  {
+    Z_LOG_INFO("Grid values of '" + plane + "' are read from '" + grid_file.Str() + "'.") ;
+    grid_table = table ;
+    return ;
+  }
+
+  table->Fill(0, 1, [&](double x, double y) { return (this->*cont_func)(x, y) ; }) ;
+  table->SetLabel(plane) ;
+  table->Export(grid_file) ;
+
+  grid_table = table ;
+}
+
+//-------------------------------------------------------------------------------
+std::vector<Zaki::String::Directory> Analysis::ResultFiles(const std::string& step,
+                                                           const size_t& sat_idx,
+                                                           const Model& model)
+{
+  std::vector<Zaki::String::Directory> out ;
+  if (sat_idx >= m_SatBundles.size()) return out ;
+
+  const std::string sat_name = m_SatBundles[sat_idx]->GetName() ;
+  const Zaki::String::Directory sat_dir = m_SatBundles[sat_idx]->GetWrkDir() ;
+
+  // The shards only write their markers
+  auto marker = [&](const std::string& campaign)
+  { 
+    out.push_back(ShardDir() + "/" + campaign + "_" + shard.Tag() + ".done") ; 
+  } ;
+
+  if (step == "DoBoost")
+  {
+    if (shard.Partial())
+      marker("boost_" + model.GetName()) ;
+    else
+    {
+      std::string tmp_name = m_SatBundles.size() == 1 ? m_SatBundles[0]->GetName() 
+                                                      : "Combined" ;
+      char tmp[200] ;
+      for (auto&& m : model.GetDMMassSet())
+      {
+        sprintf(tmp, "Fit_%s_%d_M=%.10g.grid", model.GetName().c_str(),
+                (int)plot_mode, m) ;
+        out.push_back(wrk_dir + "/" + tmp_name + "/Grids/" + tmp) ;
+      }
+    }
+  }
+  else if (step == "DoThresh")
+    out.push_back(sat_dir + "/LikeLi/t_mu95_" + sat_name + ".dat") ;
+  else if (step == "FitThreshAsimov")
+    out.push_back(sat_dir + "/Fit/Asimov_Limits_" + sat_name + ".tsv") ;
+  else if (step == "FitThreshCLs")
+    out.push_back(sat_dir + "/Fit/CLs_Limits_" + sat_name + ".tsv") ;
+  else if (step == "OptimizeBinPeriods")
+    out.push_back(sat_dir + "/Fit/Bin_Periods_" + sat_name + ".tsv") ;
+  else if (step == "PlotParamSpaceThresh")
+  {
+    if (shard.Partial())
+      marker("thresh_" + sat_name + "_" + model.GetName()) ;
+    else
+      out.push_back(wrk_dir + "/" + sat_name + "/LikeLi/Thresh/Conts/" 
+                    + sat_name + "_Thresh.dat") ;
+  }
+  else if (step == "PlotParamSpaceBoost")
+    out.push_back(wrk_dir + "/" + sat_name + "/LikeLi/Boost/Conts/" 
+                  + sat_name + "_Boost.dat") ;
+
+  return out ;
+}
+
 //-------------------------------------------------------------------------------
 // Generating the histograms in FitBin method for the threshold fit
 double Analysis::Histgen(const size_t& sat_idx,
-                         ROOT::Minuit2::MinosError e0,
-                         ROOT::Minuit2::MinosError e1,
+                         MinosResult e0,
+                         MinosResult e1,
                          Bin b, TH1F sig_shape)
 {
 
   double mu = e0.Min() + e0.Upper() ;
   double bg = e1.Min() ;
-  size_t bin_num        = b.GetTBinChops()  ;
-  int t_min             = 0                 ;   
-  int t_max             = bin_num           ;
 
-  TH1F o = b.GetTBinHist() ;
+  // ............ Plot ............
+  // Described here, and rendered by the plot queue
+  if (!PlotQueue::Headless())
+  {
+    TH1F o = b.GetTBinHist() ;
 
-  TH1F tmp_sig_hist("sig", "Signal", bin_num, t_min, t_max);
+    // The signal histogram shares the time axis of the observed one
+    // (variable-width when the bin edges are set)
+    TH1F tmp_sig_hist(sig_shape) ;
+    tmp_sig_hist.Reset() ;
+    tmp_sig_hist.SetNameTitle("sig", "Signal") ;
+    const double t_min = tmp_sig_hist.GetXaxis()->GetXmin() ;
+    const double t_max = tmp_sig_hist.GetXaxis()->GetXmax() ;
 
+    // The copies outlive the current directory
+    o.SetDirectory(nullptr) ;
+    tmp_sig_hist.SetDirectory(nullptr) ;
 
-  // Filling the signal histogram
-  // Note the use of GetSize() and the fact that indexes of TH1F 
-  // have 2 extra elements, at their first, and last position.
-  for(int i=0; i<sig_shape.GetSize(); i++)
-  {
-    // Technically for i = 0 & i = sig_shape.GetSize() - 1
-    // the element is '0'. 
-    tmp_sig_hist.SetBinContent(i, sig_shape[i]*mu + bg)  ;  
-  }
-
-  TCanvas c("c", m_SatBundles[sat_idx]->GetName().c_str(), 1000, 600) ;
-  c.SetGrid();
-  // c.Divide(2) ;  
-  // c.cd(1) ;
-  // gPad->SetGrid() ;
-  gStyle->SetOptStat(0);
+    // Filling the signal histogram, the background of each bin
+    // is proportional to its width
+    const std::vector<double> width = Bin::RelWidths(sig_shape) ;
+    for(int i=1; i<=sig_shape.GetNbinsX(); i++)
+    {
+      tmp_sig_hist.SetBinContent(i, sig_shape[i]*mu + bg*width[i-1])  ;  
+    }
 
-  // Signal
-  tmp_sig_hist.SetMarkerColor(kRed);
-  tmp_sig_hist.SetMarkerStyle(5);
-  tmp_sig_hist.SetLineColor(kRed);
+    // Signal
+    tmp_sig_hist.SetMarkerColor(kRed);
+    tmp_sig_hist.SetMarkerStyle(5);
+    tmp_sig_hist.SetLineColor(kRed);
   
-  Zaki::Math::Range<double> tmp_obs = {b.GetTBinObsSet()[0].val - b.GetTBinObsSet()[0].err,
-                     b.GetTBinObsSet()[0].val + b.GetTBinObsSet()[0].err } ;
+    Zaki::Math::Range<double> tmp_obs = {b.GetTBinObsSet()[0].val - b.GetTBinObsSet()[0].err,
+                       b.GetTBinObsSet()[0].val + b.GetTBinObsSet()[0].err } ;
+    for (auto&& ob : b.GetTBinObsSet())
+    {
+      tmp_obs.min = std::min(tmp_obs.min, ob.val - ob.err) ;
+      tmp_obs.max = std::max(tmp_obs.max, ob.val + ob.err) ;
+    }
 
-  Zaki::Math::Range<double> tmp_sigbg = {tmp_sig_hist.GetMinimum(), tmp_sig_hist.GetMaximum()} ;
+    Zaki::Math::Range<double> tmp_sigbg = {tmp_sig_hist.GetMinimum(), tmp_sig_hist.GetMaximum()} ;
 
-  Zaki::Math::Range<double> tmp_y = { tmp_sigbg.min< tmp_obs.min? tmp_sigbg.min*0.9 : tmp_obs.min*0.9 , 
-                  tmp_sigbg.max > tmp_obs.max ? tmp_sigbg.max*1.1 : tmp_obs.max*1.1 };
+    Zaki::Math::Range<double> tmp_y = { tmp_sigbg.min< tmp_obs.min? tmp_sigbg.min*0.9 : tmp_obs.min*0.9 , 
+                    tmp_sigbg.max > tmp_obs.max ? tmp_sigbg.max*1.1 : tmp_obs.max*1.1 };
 
-  tmp_sig_hist.SetMaximum(tmp_y.max);
-  tmp_sig_hist.SetMinimum(tmp_y.min);
-  tmp_sig_hist.SetXTitle("Cycle") ;
-  tmp_sig_hist.SetYTitle("Observed Counts") ;
-  tmp_sig_hist.SetTitle("Constant Observed Events") ;
+    tmp_sig_hist.SetMaximum(tmp_y.max);
+    tmp_sig_hist.SetMinimum(tmp_y.min);
+    tmp_sig_hist.SetXTitle(sig_shape.GetXaxis()->IsVariableBinSize() ? "Day" : "Cycle") ;
+    tmp_sig_hist.SetYTitle("Observed Counts") ;
+    tmp_sig_hist.SetTitle("Constant Observed Events") ;
 
-  tmp_sig_hist.Draw("LP") ;
+    // Observed
+    o.SetLineWidth(2) ;
 
-  // Observed
-  o.SetLineWidth(2) ;
-  o.Draw("E1 same") ;
+    std::vector<std::string> labels ;
+    char tmp_label[150] ;    
+    sprintf(tmp_label, "E = [ %.1f - %.1f ] GeV", b.GetERange().min, b.GetERange().max) ;
+    labels.emplace_back(tmp_label);
 
-  TPaveText pl(t_max*0.7, tmp_y.max*0.8, t_max*0.98, tmp_y.max*0.98) ;
+    sprintf(tmp_label, "#mu = %.3e #plus %.2e #minus %.2e", e0.Min(), e0.Upper(), abs(e0.Lower()) ) ;
+    labels.emplace_back(tmp_label);
 
-  char tmp_label[150] ;    
-  sprintf(tmp_label, "E = [ %.1f - %.1f ] GeV", b.GetERange().min, b.GetERange().max) ;
-  pl.AddText(tmp_label);
+    sprintf(tmp_label, "bg = %.2f #plus %.2f #minus %.2f", e1.Min(), e1.Upper(), abs(e1.Lower()) ) ;
+    labels.emplace_back(tmp_label);
 
-  sprintf(tmp_label, "#mu = %.3e #plus %.2e #minus %.2e", e0.Min(), e0.Upper(), abs(e0.Lower()) ) ;
-  pl.AddText(tmp_label);
+    sprintf(tmp_label, "obs = %.2f #pm %.2f", b.GetTBinObsSet()[0].val, b.GetTBinObsSet()[0].err ) ;
+    labels.emplace_back(tmp_label);
 
-  sprintf(tmp_label, "bg = %.2f #plus %.2f #minus %.2f", e1.Min(), e1.Upper(), abs(e1.Lower()) ) ;
-  pl.AddText(tmp_label);
+    // Output file
+    char out_file_char[150] ;    
+    sprintf(out_file_char, "Fit/Thresh_%.0f_GeV.pdf", b.GetECenter().val) ;
+    std::string out_file = (wrk_dir+"/"+m_SatBundles[sat_idx]->GetName() + "/"+ out_file_char).Str() ;
 
-  sprintf(tmp_label, "obs = %.2f #pm %.2f", b.GetTBinObsSet()[0].val, b.GetTBinObsSet()[0].err ) ;
-  pl.AddText(tmp_label);
+    PlotQueue::Push([sig_hist = tmp_sig_hist, o, labels, t_min, t_max, tmp_y, out_file,
+                     title = m_SatBundles[sat_idx]->GetName()]() mutable
+    {
+      TCanvas c("c", title.c_str(), 1000, 600) ;
+      c.SetGrid();
+      gStyle->SetOptStat(0);
 
-  pl.Draw();
+      sig_hist.Draw("LP") ;
+      o.Draw("E1 same") ;
 
-  // Output file
-  char out_file_char[150] ;    
-  sprintf(out_file_char, "Fit/Thresh_%.0f_GeV.pdf", b.GetECenter().val) ;
+      TPaveText pl(t_min + (t_max - t_min)*0.7, tmp_y.max*0.8,
+                   t_min + (t_max - t_min)*0.98, tmp_y.max*0.98) ;
+      for (auto&& l : labels)
+        pl.AddText(l.c_str());
+      pl.Draw();
 
-  c.SaveAs((wrk_dir+"/"+m_SatBundles[sat_idx]->GetName() + "/"+ out_file_char).Str().c_str()) ;
+      c.SaveAs(out_file.c_str()) ;
+    }) ;
+  }
+  // ..............................
 
   double muSig = 0 ;
 
@@ -1596,6 +2891,13 @@ void Analysis::PlotBoost(const Zaki::String::Directory& f_name)
   c.SaveAs((wrk_dir + "/" + tmp_name+ "/Fit"+ f_name + ".pdf").Str().c_str()) ;
 }
 
+//--------------------------------------------------------------
+void Analysis::SetBinEdges(const size_t& sat_idx,
+                           const std::vector<std::vector<double>>& edges)
+{
+  m_SatBundles[sat_idx].SetBinEdges(edges) ;
+}
+
 //--------------------------------------------------------------
 void Analysis::SetBinPeriod(const size_t& sat_idx,
                             const std::vector<int>& per)
@@ -1745,7 +3047,7 @@ void Analysis::DoThreshMinuit(const size_t& sat_idx,
 
   (*mfcwPtr)->SetWrkDir(wrk_dir + "/" + tmp_name + "/Fit") ;
 
-  (*mfcwPtr)->SetThreads(8) ;
+  (*mfcwPtr)->SetThreads(TaskPool::Get().Size()) ;
 
   // ...........................
   // Saving time by checking if the grid values are the
@@ -1792,12 +3094,12 @@ void Analysis::DoThreshMinuit(const size_t& sat_idx,
 
       if(in_bins_idx)
       {
-        modelPtr->SetActiveBin(m_SatBundles[sat_idx]->GetData().GetBins()[(*in_bins_idx)[i]]) ;
+        modelPtr->SetActiveBin(m_SatBundles[sat_idx]->GetData()[(*in_bins_idx)[i]]) ;
         (*mfcwPtr)->SetContVal({thresh_limits_true[i]}, {"T_"+std::to_string(GetBinPeriod(sat_idx)[i])}) ;
       }
       else
       {
-        modelPtr->SetActiveBin(m_SatBundles[sat_idx]->GetData().GetBins()[i]) ;
+        modelPtr->SetActiveBin(m_SatBundles[sat_idx]->GetData()[i]) ;
         (*mfcwPtr)->SetContVal({thresh_limits_true[i]}, {"M_"+std::to_string((int)e_bins[i]*modelPtr->GetDecayProd().size())}) ;
       }
 
@@ -1837,7 +3139,7 @@ void Analysis::DoThreshMinuit(const size_t& sat_idx,
   } 
   else            
   { 
-    tmp_bins_size = m_SatBundles[sat_idx]->GetData().GetBins().size() ; 
+    tmp_bins_size = m_SatBundles[sat_idx]->GetData().size() ; 
   }
   // ...........................
   // Making the plot legend
@@ -1911,20 +3213,24 @@ void Analysis::DoBoost(Zaki::Math::Grid2D* grid_in)
   // ...........................
   // CONFIND::ContourFinder con    ;
   MemFuncContWrapper<Analysis, double (Analysis::*) (double, double)>* mfcwPtr;
+  double (Analysis::*cont_func)(double, double) = nullptr ;
 
   switch (plot_mode)
   {
     case PlotMode::Ldec_Gann:
+      cont_func = &Analysis::ContFuncBoost_LG ;
       mfcwPtr = new MemFuncContWrapper<Analysis,
                 double (Analysis::*) (double, double)>(*this, &Analysis::ContFuncBoost_LG) ;
       break;
     
     case PlotMode::Mdm_Gann:
+      cont_func = &Analysis::ContFuncBoost_MG ;
       mfcwPtr = new MemFuncContWrapper<Analysis,
                 double (Analysis::*) (double, double)>(*this, &Analysis::ContFuncBoost_MG) ;
       break;
 
     case PlotMode::Ldec_Mdm:
+      cont_func = &Analysis::ContFuncBoost_LM ;
       mfcwPtr = new MemFuncContWrapper<Analysis, 
                 double (Analysis::*) (double, double)>(*this, &Analysis::ContFuncBoost_LM) ;
       break;
@@ -1936,17 +3242,20 @@ void Analysis::DoBoost(Zaki::Math::Grid2D* grid_in)
   // Zaki::Math::MemFuncWrapper<Analysis, double (Analysis::*) (double, double)> mfw(*this, &Analysis::ContFuncBoost) ;
   // mfcw->SetMemFunc(&mfw);
   //..................
+  Zaki::Math::Grid2D cont_grid ;
   // Checking the grid input
   if (grid_in)
   {
     Z_LOG_INFO("Using the grid input from 'Analysis'.") ;
-    (*mfcwPtr)->SetGrid(*grid_in) ;
+    cont_grid = *grid_in ;
+    (*mfcwPtr)->SetGrid(cont_grid) ;
   }
   // Checking the grid in the model
   else if(modelPtr->GetBGrid(plot_mode))
   {
     Z_LOG_INFO("Using the grid from 'Model'.") ;
-    (*mfcwPtr)->SetGrid(modelPtr->GetBGrid(plot_mode)->grid) ;
+    cont_grid = modelPtr->GetBGrid(plot_mode)->grid ;
+    (*mfcwPtr)->SetGrid(cont_grid) ;
   }
   // Emitting errors and stopping the process
   else
@@ -1965,6 +3274,47 @@ void Analysis::DoBoost(Zaki::Math::Grid2D* grid_in)
   // Initializing the model
   modelPtr->Init() ;
 
+  if(!MakeBoostFitDir())
+    return ;
+
+  std::string campaign = "boost_" + modelPtr->GetName() ;
+  if (shard.merge)
+    CheckShards(campaign) ;
+
+  // The time-binned bins don't depend on the DM mass, so they
+  //  are prepared once, and the masses are fitted in parallel
+  BoostSet boost_set = PrepBoostSet() ;
+
+  // The consecutive masses are chained: each fit starts 
+  //  from the previous mass's minimum
+  std::vector<BoostFit> fits(modelPtr->GetDMMassSet().size()) ;
+  FitChain chain(fits.size(), fit_chain) ;
+  SweepDMMass([&](size_t i, Model& model)
+  { 
+    // The finished masses are skipped when resuming,
+    //  only their limit is needed for the contours
+    char tmp[200] ;
+    sprintf(tmp, "boost_fit|%s|M=%.17g", model.GetName().c_str(), model.GetDMMass()) ;
+    std::string key = UnitKey(tmp) ;
+
+    std::vector<double> done ;
+    if (checkpoint && checkpoint->Find(key, done) && done.size() == 1)
+    {
+      fits[i].val     = done[0] ;
+      fits[i].resumed = true ;
+      return ;
+    }
+
+    if (ShardSkips(i, key)) return ;
+
+    fits[i] = FitBoostedMass(boost_set, model, {GetECut(), model.GetDMMass()},
+                             chain.Prev(i)) ; 
+    chain.Set(i, fits[i].seed) ;
+    if (checkpoint) checkpoint->Save(key, {fits[i].val}) ;
+  }, chain.Length()) ;
+
+  // The plots & contours are made in the mass order, 
+  //  and all the masses end up on the same contour plot
   char tmp[200] ;
   for (size_t i = 0; i < modelPtr->GetDMMassSet().size(); i++)
   {
@@ -1972,10 +3322,39 @@ void Analysis::DoBoost(Zaki::Math::Grid2D* grid_in)
     // Changing the DM mass
     modelPtr->SetDMMass(modelPtr->GetDMMassSet()[i]) ;
 
-    FitBoosted({GetECut(), modelPtr->GetDMMass()}) ;
+    // The plot of a resumed fit is already made
+    if (fits[i].resumed)
+    {
+      boost_fit_val = fits[i].val ;
+      Z_LOG_INFO("Boosted fit for M = " + std::to_string(modelPtr->GetDMMass()) 
+                 + " GeV is resumed from the checkpoint.") ;
+    }
+    else if (!shard.Skips(i))
+    {
+      StoreBoostFit(std::move(fits[i])) ;
 
-    sprintf(tmp, "Boosted_Fit_%.0f_%.0f", GetECut(), modelPtr->GetDMMass()) ;
-    PlotBoost(tmp);
+      sprintf(tmp, "Boosted_Fit_%.0f_%.0f", GetECut(), modelPtr->GetDMMass()) ;
+      PlotBoost(tmp);
+    }
+
+    // Grid values of the plane: evaluated by the shards, and
+    //  looked up when merging (the fits are the first units)
+    grid_table = nullptr ;
+    if (shard.count > 1)
+    {
+      sprintf(tmp, "%s_M=%.10g", campaign.c_str(), modelPtr->GetDMMass()) ;
+      ShardPlane(tmp, fits.size() + i*shard.tiles, cont_grid, cont_func) ;
+    }
+    if (shard.Partial())
+    {
+      ResetContainers() ;
+      continue ;
+    }
+
+    // The values of a resumed fit are already stored
+    sprintf(tmp, "Fit_%s_%d_M=%.10g", modelPtr->GetName().c_str(),
+            (int)plot_mode, modelPtr->GetDMMass()) ;
+    StorePlane(tmp_name, tmp, cont_grid, cont_func, fits[i].resumed) ;
 
     (*mfcwPtr)->SetContVal({GetBoostLimit()}, {std::to_string((int)modelPtr->GetDMMass())}) ;
 
@@ -1984,7 +3363,7 @@ void Analysis::DoBoost(Zaki::Math::Grid2D* grid_in)
     UpdateMFCW(mfcwPtr) ;
 
     // ...........................
-    (*mfcwPtr)->SetThreads(8) ;
+    (*mfcwPtr)->SetThreads(TaskPool::Get().Size()) ;
     (*mfcwPtr)->SetGridVals(CONFIND::ContourFinder::Mode::Fast) ;
 
     sprintf(tmp, "%.1e", modelPtr->GetDMMass()) ;
@@ -1993,6 +3372,14 @@ void Analysis::DoBoost(Zaki::Math::Grid2D* grid_in)
     // ...........................
     ResetContainers() ;
   }
+  grid_table = nullptr ;
+
+  if (shard.Partial())
+  {
+    FinishShard(campaign) ;
+    delete mfcwPtr ;
+    return ;
+  }
 
   // ...........................
   // Making the plot legend
@@ -2039,6 +3426,9 @@ void Analysis::ResetContainers()
 // Boosted case, in (L_dec, G_ann) plane
 double Analysis::ContFuncBoost_LG(double dec_len, double gamma)
 {
+  // The values imported from the shards
+  if (grid_table) return grid_table->Eval(dec_len, gamma) ;
+
   double out = modelPtr->ContFuncBoost_LG(dec_len, gamma) ;
   // out       *= satPtrSet[sat_idx]->GetKappa(modelPtr->GetDecayProd()) ;
 
@@ -2079,6 +3469,9 @@ double Analysis::ContFuncBoost_LM(double dec_len, double m_dm)
 /// Threshold case, in (L_dec, G_ann) plane
 double Analysis::ContFuncThresh_LG(double dec_len, double gamma)
 {
+  // The values imported from the shards
+  if (grid_table) return grid_table->Eval(dec_len, gamma) ;
+
   double out = modelPtr->ContFuncThresh_LG(dec_len, gamma) ;
   out       *= GetSatellite(0)->GetMultiplicity(modelPtr->GetDecayProd()) ;
 
@@ -2091,6 +3484,9 @@ double Analysis::ContFuncThresh_LG(double dec_len, double gamma)
 /// Threshold case, (M_dm, G_ann) plane
 double Analysis::ContFuncThresh_MG(double m_dm, double gamma)
 {
+  // The values imported from the shards
+  if (grid_table) return grid_table->Eval(m_dm, gamma) ;
+
   double out = modelPtr->ContFuncThresh_MG(m_dm, gamma) ;
   out       *= GetSatellite(0)->GetMultiplicity(modelPtr->GetDecayProd()) ;
 
@@ -2103,6 +3499,9 @@ double Analysis::ContFuncThresh_MG(double m_dm, double gamma)
 /// Threshold case, (L_dec, M_dm) plane
 double Analysis::ContFuncThresh_LM(double L_dec, double M_dm)
 {
+  // The values imported from the shards
+  if (grid_table) return grid_table->Eval(L_dec, M_dm) ;
+
   double out = modelPtr->ContFuncThresh_LM(L_dec, M_dm) ;
   out       *= GetSatellite(0)->GetMultiplicity(modelPtr->GetDecayProd()) ;
 
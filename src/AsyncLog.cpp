@@ -0,0 +1,291 @@
+/*
+  AsyncLog class
+
+*/
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Local headers
+#include "DMSS/AsyncLog.hpp"
+
+//==============================================================
+namespace
+{
+  constexpr size_t QueueSize = 1024 ;   // power of two
+
+  //............................................
+  struct Entry
+  {
+    Zaki::Util::LogLevel level ;
+    int line ;
+    const char* func ;
+    const char* file ;
+    std::string msg ;
+  };
+
+  //............................................
+  /// Single-producer / single-consumer ring buffer
+  struct ThreadQueue
+  {
+    Entry slots[QueueSize] ;
+    std::atomic<size_t> head = 0 ;   // consumer position
+    std::atomic<size_t> tail = 0 ;   // producer position
+    std::atomic<bool> orphaned = false ;
+
+    bool TryPush(Entry&& e)
+    {
+      size_t t = tail.load(std::memory_order_relaxed) ;
+      if (t - head.load(std::memory_order_acquire) == QueueSize)
+        return false ;
+      slots[t & (QueueSize-1)] = std::move(e) ;
+      tail.store(t + 1, std::memory_order_release) ;
+      return true ;
+    }
+
+    bool TryPop(Entry& e)
+    {
+      size_t h = head.load(std::memory_order_relaxed) ;
+      if (h == tail.load(std::memory_order_acquire))
+        return false ;
+      e = std::move(slots[h & (QueueSize-1)]) ;
+      head.store(h + 1, std::memory_order_release) ;
+      return true ;
+    }
+
+    bool Empty() const
+    {
+      return head.load(std::memory_order_acquire)
+             == tail.load(std::memory_order_acquire) ;
+    }
+  };
+
+  //............................................
+  /// Owns the queues and the background writer
+  struct Backend
+  {
+    std::mutex mtx ;    // guards 'queues' and the writer (not the producers)
+    std::condition_variable cv ;
+    std::vector<std::shared_ptr<ThreadQueue>> queues ;
+    std::thread writer ;
+    bool stop = false ;
+    std::atomic<bool> stopped = false ;
+    std::atomic<size_t> dropped = 0 ;
+    size_t reported = 0 ;   // dropped messages already reported (under drain_mtx)
+
+    // Serializes draining (writer thread vs. Flush())
+    std::mutex drain_mtx ;
+
+    Backend()
+    {
+      writer = std::thread([this](){ Run() ; }) ;
+    }
+
+    void Drain()
+    {
+      std::vector<std::shared_ptr<ThreadQueue>> snapshot ;
+      {
+        std::lock_guard<std::mutex> lock(mtx) ;
+        snapshot = queues ;
+      }
+
+      std::lock_guard<std::mutex> lock(drain_mtx) ;
+      Entry e ;
+      for (auto&& q : snapshot)
+        while (q->TryPop(e))
+          Zaki::Util::LogEntry(e.msg, e.line, e.func, e.file, e.level) ;
+
+      // Reporting the messages lost since the last drain
+      const size_t n_dropped = dropped.load() ;
+      if (n_dropped > reported)
+      {
+        Zaki::Util::LogEntry(std::to_string(n_dropped - reported) 
+                             + " log message(s) dropped, since a queue was full.",
+                             __LINE__, __func__, __FILENAME__,
+                             Zaki::Util::LogLevel::Warning) ;
+        reported = n_dropped ;
+      }
+
+      // Forgetting the queues of finished threads
+      std::lock_guard<std::mutex> q_lock(mtx) ;
+      for (size_t i = 0 ; i < queues.size() ; )
+      {
+        if (queues[i]->orphaned && queues[i]->Empty())
+        {
+          queues[i] = queues.back() ;
+          queues.pop_back() ;
+        }
+        else
+          ++i ;
+      }
+    }
+
+    void Run()
+    {
+      std::unique_lock<std::mutex> lock(mtx) ;
+      while (!stop)
+      {
+        cv.wait_for(lock, std::chrono::milliseconds(20)) ;
+        lock.unlock() ;
+        Drain() ;
+        lock.lock() ;
+      }
+    }
+
+    bool Stopped() const
+    {
+      return stopped.load(std::memory_order_relaxed) ;
+    }
+
+    void Shutdown()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mtx) ;
+        if (stop) return ;
+        stop = true ;
+      }
+      stopped = true ;
+      cv.notify_all() ;
+      if (writer.joinable())
+        writer.join() ;
+      Drain() ;
+    }
+  };
+
+  //............................................
+  Backend& GetBackend()
+  {
+    // Intentionally leaked; stopped and drained at exit
+    static Backend* b = [](){
+      Backend* tmp = new Backend ;
+      std::atexit([](){ GetBackend().Shutdown() ; }) ;
+      return tmp ;
+    }() ;
+    return *b ;
+  }
+
+  //............................................
+  /// Registers the thread's queue on first use and
+  ///  hands it over to the backend on thread exit
+  struct QueueHandle
+  {
+    std::shared_ptr<ThreadQueue> q ;
+
+    QueueHandle() : q(std::make_shared<ThreadQueue>())
+    {
+      Backend& b = GetBackend() ;
+      std::lock_guard<std::mutex> lock(b.mtx) ;
+      b.queues.push_back(q) ;
+    }
+
+    ~QueueHandle() ;
+  };
+
+  thread_local QueueHandle t_queue ;
+
+  /// Set once the thread's queue is gone (trivially destructible)
+  thread_local bool t_queue_gone = false ;
+
+  QueueHandle::~QueueHandle()
+  {
+    q->orphaned  = true ;
+    t_queue_gone = true ;
+  }
+}
+
+//==============================================================
+bool LogCallSite::Allow(uint32_t& dropped)
+{
+  int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count() ;
+
+  int64_t start = window_start.load(std::memory_order_relaxed) ;
+  if (now - start >= 1000 &&
+      window_start.compare_exchange_strong(start, now, std::memory_order_relaxed))
+    window_count.store(0, std::memory_order_relaxed) ;
+
+  if (window_count.fetch_add(1, std::memory_order_relaxed) < DMSS_LOG_RATE_LIMIT)
+  {
+    dropped = suppressed.exchange(0, std::memory_order_relaxed) ;
+    return true ;
+  }
+
+  suppressed.fetch_add(1, std::memory_order_relaxed) ;
+  return false ;
+}
+
+//==============================================================
+void AsyncLog::Push(Zaki::Util::LogLevel level, std::string&& msg, int line,
+                    const char* func, const char* file)
+{
+  // Late messages (thread or program teardown) are written directly
+  if (t_queue_gone || GetBackend().Stopped())
+  {
+    Zaki::Util::LogEntry(msg, line, func, file, level) ;
+    return ;
+  }
+
+  Entry e{level, line, func, file, std::move(msg)} ;
+  const bool error = (level == Zaki::Util::LogLevel::Error) ;
+
+  if (!t_queue.q->TryPush(std::move(e)))
+  {
+    // An error isn't lost: it's written after the queued messages
+    if (error)
+    {
+      Flush() ;
+      Zaki::Util::LogEntry(e.msg, e.line, e.func, e.file, e.level) ;
+      return ;
+    }
+    ++GetBackend().dropped ;
+  }
+
+  // Errors are usually followed by 'exit', so we don't wait
+  if (error)
+    Flush() ;
+}
+
+//--------------------------------------------------------------
+void AsyncLog::Flush()
+{
+  GetBackend().Drain() ;
+}
+
+//--------------------------------------------------------------
+size_t AsyncLog::Dropped()
+{
+  return GetBackend().dropped.load() ;
+}
+
+//--------------------------------------------------------------
+std::string AsyncLog::Format(const char* fmt, ...)
+{
+  char tmp[512] ;
+
+  va_list args, args_cpy ;
+  va_start(args, fmt) ;
+  va_copy(args_cpy, args) ;
+  const int n = vsnprintf(tmp, sizeof(tmp), fmt, args) ;
+  va_end(args) ;
+
+  // Formatting again into a buffer that fits the message
+  std::string out ;
+  if (n >= static_cast<int>(sizeof(tmp)))
+  {
+    out.resize(n) ;
+    vsnprintf(&out[0], n + 1, fmt, args_cpy) ;
+  }
+  else if (n > 0)
+    out = tmp ;
+  va_end(args_cpy) ;
+
+  return out ;
+}
+//--------------------------------------------------------------
+
+//==============================================================
@@ -7,6 +7,7 @@
 #include <TStyle.h>
 
 #include "DMSS/Bin.hpp"
+#include "DMSS/AsyncLog.hpp"
 
 //==============================================================
 std::ostream& operator << ( std::ostream &output, Flux f )
@@ -54,11 +55,91 @@ Bin::Bin(const Bin& other)
     t_bin_obs_set(other.t_bin_obs_set),
     t_bin_chops(other.t_bin_chops)
 {
-    t_bin_hist = *(static_cast<TH1F*>(other.t_bin_hist.Clone())) ;
-    t_bin_hist.SetName(("t_bin_hist_" + std::to_string(rand() % 990000)).c_str()) ;
+  CopyTBinHist(other) ;
 //    Z_LOG_INFO("Bin copy constructor called -> from " + std::string(other.t_bin_hist.GetName()) + " to " + std::string(t_bin_hist.GetName()) ) ;
 }
 
+//--------------------------------------------------------------
+/// Move constructor
+Bin::Bin(Bin&& other) noexcept
+    : Prog("Bin", true),
+    flux(other.flux),
+    e_range(other.e_range),
+    e_center(other.e_center),
+    n_count(other.n_count),
+    set_flux_flag(other.set_flux_flag),
+    set_e_range_flag(other.set_e_range_flag),
+    set_e_center_flag(other.set_e_center_flag),
+    set_n_count_flag(other.set_n_count_flag),
+    divided_bin_flag(other.divided_bin_flag),
+    t_bin_obs_set(std::move(other.t_bin_obs_set)),
+    t_bin_hist(std::move(other.t_bin_hist)),
+    t_bin_chops(other.t_bin_chops)
+{
+  other.divided_bin_flag = false ;
+}
+
+//--------------------------------------------------------------
+/// Copy assignment
+Bin& Bin::operator=(const Bin& other)
+{
+  if(this == &other) return *this ;
+
+  flux              = other.flux ;
+  e_range           = other.e_range ;
+  e_center          = other.e_center ;
+  n_count           = other.n_count ;
+  set_flux_flag     = other.set_flux_flag ;
+  set_e_range_flag  = other.set_e_range_flag ;
+  set_e_center_flag = other.set_e_center_flag ;
+  set_n_count_flag  = other.set_n_count_flag ;
+  divided_bin_flag  = other.divided_bin_flag ;
+  t_bin_obs_set     = other.t_bin_obs_set ;
+  t_bin_chops       = other.t_bin_chops ;
+  CopyTBinHist(other) ;
+
+  return *this ;
+}
+
+//--------------------------------------------------------------
+/// Move assignment
+Bin& Bin::operator=(Bin&& other) noexcept
+{
+  if(this == &other) return *this ;
+
+  flux              = other.flux ;
+  e_range           = other.e_range ;
+  e_center          = other.e_center ;
+  n_count           = other.n_count ;
+  set_flux_flag     = other.set_flux_flag ;
+  set_e_range_flag  = other.set_e_range_flag ;
+  set_e_center_flag = other.set_e_center_flag ;
+  set_n_count_flag  = other.set_n_count_flag ;
+  divided_bin_flag  = other.divided_bin_flag ;
+  t_bin_obs_set     = std::move(other.t_bin_obs_set) ;
+  t_bin_hist        = std::move(other.t_bin_hist) ;
+  t_bin_chops       = other.t_bin_chops ;
+
+  other.divided_bin_flag = false ;
+
+  return *this ;
+}
+
+//--------------------------------------------------------------
+/// Deep-copies the time-binned histogram of 'other'
+void Bin::CopyTBinHist(const Bin& other)
+{
+  if(!other.t_bin_hist)
+  {
+    t_bin_hist.reset() ;
+    return ;
+  }
+
+  t_bin_hist = std::make_unique<TH1F>(*other.t_bin_hist) ;
+  t_bin_hist->SetDirectory(nullptr) ;
+  t_bin_hist->SetName(("t_bin_hist_" + std::to_string(rand() % 990000)).c_str()) ;
+}
+
 //--------------------------------------------------------------
 Bin::~Bin() {} 
 
@@ -170,7 +251,7 @@ TH1F Bin::divide(size_t chops)
 {
   if (!set_n_count_flag) 
   { 
-    Z_LOG_ERROR("Number of counts has not been set yet!") ;
+    DMSS_LOG_ERROR("Number of counts has not been set yet!") ;
   }
 
   t_bin_chops = chops ;
@@ -202,22 +283,86 @@ TH1F Bin::divide(size_t chops)
     t_bin_obs_set.push_back(tmp_obs);
   }
 
-  t_bin_hist = o ;
+  t_bin_hist = std::make_unique<TH1F>(o) ;
+  t_bin_hist->SetDirectory(nullptr) ;
+
+  divided_bin_flag = true ; 
+
+  return o;
+}
+//--------------------------------------------------------------
+TH1F Bin::divide(const std::vector<double>& edges)
+{
+  if (!set_n_count_flag) 
+  { 
+    DMSS_LOG_ERROR("Number of counts has not been set yet!") ;
+  }
+
+  if (edges.size() < 2)
+  {
+    DMSS_LOG_ERROR("At least two edges are needed to divide the bin!") ;
+    return divide(1) ;
+  }
+
+  t_bin_chops = edges.size() - 1 ;
+  const double span = edges.back() - edges.front() ;
+
+  char title_char[200] ;    
+  sprintf(title_char, "Constant Observed Events (E = %.1f GeV)", e_center.val) ;
+
+  std::string tmp_str = "obs_" + std::to_string(rand() % 990000) ;
+  TH1F o(tmp_str.c_str(), title_char, t_bin_chops, edges.data());
+
+  t_bin_obs_set     = {} ;
+  t_bin_obs_set.reserve(t_bin_chops) ;
+
+  // Filling the observed histogram
+  for(size_t i=0; i < t_bin_chops; i++)
+  {
+    double frac = (edges[i+1] - edges[i]) / span ;
+    Zaki::Math::Quantity tmp_obs = {frac*n_count.val, pow(frac, 0.5)*n_count.err } ;
+
+    o.SetBinContent(i+1, tmp_obs.val) ;
+    o.SetBinError(i+1, tmp_obs.err) ;
+    t_bin_obs_set.push_back(tmp_obs);
+  }
+
+  t_bin_hist = std::make_unique<TH1F>(o) ;
+  t_bin_hist->SetDirectory(nullptr) ;
 
   divided_bin_flag = true ; 
 
   return o;
 }
+
+//--------------------------------------------------------------
+std::vector<double> Bin::RelWidths(const TH1& h)
+{
+  const TAxis* axis = h.GetXaxis() ;
+  const double mean = (axis->GetXmax() - axis->GetXmin()) / axis->GetNbins() ;
+
+  std::vector<double> out ;
+  out.reserve(axis->GetNbins()) ;
+  for (int j = 1 ; j <= axis->GetNbins() ; ++j)
+    out.push_back(axis->IsVariableBinSize() ? axis->GetBinWidth(j) / mean : 1) ;
+
+  return out ;
+}
+
 //--------------------------------------------------------------
-TH1F Bin::GetTBinHist() const
+const TH1F& Bin::GetTBinHist() const
 {
-  if (!divided_bin_flag )
-    Z_LOG_ERROR("Bin hasn't been divided yet, use 'divide(double chops)' first!") ;
+  if (!divided_bin_flag || !t_bin_hist)
+  {
+    DMSS_LOG_ERROR("Bin hasn't been divided yet, use 'divide(double chops)' first!") ;
+    static const TH1F empty_hist ;
+    return empty_hist ;
+  }
   
-  return t_bin_hist;
+  return *t_bin_hist;
 }
 //--------------------------------------------------------------
-std::vector<Zaki::Math::Quantity> Bin::GetTBinObsSet() const
+const std::vector<Zaki::Math::Quantity>& Bin::GetTBinObsSet() const
 {
   return t_bin_obs_set;
 }
@@ -0,0 +1,348 @@
+/*
+  CLsLimit class
+
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Math/QuantFuncMathCore.h>
+
+// Local headers
+#include "DMSS/CLsLimit.hpp"
+#include "DMSS/TaskPool.hpp"
+#include "DMSS/ToyMC.hpp"
+
+//==============================================================
+namespace
+{
+  const double NaN = std::numeric_limits<double>::quiet_NaN() ;
+
+  /// Toys per parallel task
+  const size_t CHUNK = 16 ;
+}
+
+//==============================================================
+// Constructor
+CLsLimit::CLsLimit(const std::vector<double>& in_counts,
+                   const std::vector<double>& in_sig, const uint64_t& in_seed,
+                   const std::vector<double>& in_width)
+  : counts(in_counts), sig(in_sig), width(in_width), seed(in_seed),
+    obs_fitter(in_counts, in_sig, in_width)
+{
+  if (width.size() != counts.size())
+    width.assign(counts.size(), 1) ;
+
+  obs_fit = obs_fitter.Minimum() ;
+
+  // The background-only toys (stream 0)
+  b_toys.mu = 0 ;
+  obs_fitter.Profile(0, &b_toys.bg) ;
+}
+
+//--------------------------------------------------------------
+void CLsLimit::SetToys(const size_t& in_min, const size_t& in_max)
+{
+  n_min = std::max<size_t>(1, in_min) ;
+  n_max = std::max(n_min, in_max) ;
+}
+
+//--------------------------------------------------------------
+void CLsLimit::SetTolerance(const double& in_tol)
+{
+  tol = in_tol ;
+}
+
+//--------------------------------------------------------------
+const std::vector<CLsLimit::Point>& CLsLimit::GetScan() const
+{
+  return scan ;
+}
+
+//--------------------------------------------------------------
+size_t CLsLimit::NToys() const
+{
+  size_t n = b_toys.Size() ;
+  for (auto&& e : sb_toys)
+    n += e.Size() ;
+
+  return n ;
+}
+
+//--------------------------------------------------------------
+// Toy 't' of an ensemble always has the same random stream
+void CLsLimit::Extend(Ensemble& ens, const size_t& n)
+{
+  const size_t old = ens.Size(), n_bins = counts.size() ;
+  if (n <= old) return ;
+
+  ens.counts.resize(n*n_bins) ;
+  ens.mu_hat.resize(n) ;
+  ens.min_val.resize(n) ;
+
+  TaskPool::Get().ParallelFor((n - old + CHUNK - 1) / CHUNK, [&](size_t c)
+  {
+    std::vector<double> toy(n_bins) ;
+    for (size_t t = old + c*CHUNK ; t < std::min(n, old + (c+1)*CHUNK) ; ++t)
+    {
+      ToyRNG rng(seed, (ens.stream << 32) + t) ;
+
+      double n_tot = 0 ;
+      for (size_t j = 0 ; j < n_bins ; ++j)
+      {
+        toy[j] = rng.Poisson(ens.mu*sig[j] + ens.bg*width[j]) ;
+        ens.counts[t*n_bins + j] = toy[j] ;
+        n_tot += toy[j] ;
+      }
+
+      // Without counts, the minimum is at zero
+      PoissonFitter::Result fit = PoissonFitter(toy, sig, width).Minimum() ;
+      ens.mu_hat[t]  = fit.valid ? fit.mu : (n_tot == 0 ? 0 : NaN) ;
+      ens.min_val[t] = fit.valid ? fit.min_val : 0 ;
+    }
+  }) ;
+}
+
+//--------------------------------------------------------------
+double CLsLimit::TestStat(const double& mu) const
+{
+  if (obs_fit.mu >= mu) return 0 ;
+
+  return std::max(0.0, obs_fitter.Profile(mu) - obs_fit.min_val) ;
+}
+
+//--------------------------------------------------------------
+std::vector<double> CLsLimit::TestStat(const Ensemble& ens, const double& mu) const
+{
+  const size_t n = ens.Size(), n_bins = counts.size() ;
+  std::vector<double> q(n) ;
+
+  TaskPool::Get().ParallelFor((n + CHUNK - 1) / CHUNK, [&](size_t c)
+  {
+    for (size_t t = c*CHUNK ; t < std::min(n, (c+1)*CHUNK) ; ++t)
+    {
+      if (std::isnan(ens.mu_hat[t]) || ens.mu_hat[t] >= mu)
+      {
+        q[t] = std::isnan(ens.mu_hat[t]) ? NaN : 0 ;
+        continue ;
+      }
+
+      std::vector<double> toy(ens.counts.begin() + t*n_bins,
+                              ens.counts.begin() + (t+1)*n_bins) ;
+      q[t] = std::max(0.0, PoissonFitter(toy, sig, width).Profile(mu) - ens.min_val[t]) ;
+    }
+  }) ;
+
+  return q ;
+}
+
+//--------------------------------------------------------------
+// w = L(mu, bg) / L(mu_ens, bg_ens)  of each toy (scaled by the
+//  largest), and the effective number (sum w)^2 / sum w^2
+double CLsLimit::Weights(const Ensemble& ens, const double& mu, const double& bg,
+                         std::vector<double>& w) const
+{
+  const size_t n = ens.Size(), n_bins = counts.size() ;
+
+  std::vector<double> log_ratio(n_bins) ;
+  double rate_diff = 0 ;
+  for (size_t j = 0 ; j < n_bins ; ++j)
+  {
+    double r_1 = ens.mu*sig[j] + ens.bg*width[j], r_2 = mu*sig[j] + bg*width[j] ;
+    log_ratio[j] = (r_1 > 0 && r_2 > 0) ? std::log(r_2 / r_1)
+                                        : -std::numeric_limits<double>::infinity() ;
+    rate_diff += r_2 - r_1 ;
+  }
+
+  w.assign(n, 0) ;
+  double log_max = -std::numeric_limits<double>::infinity() ;
+  for (size_t t = 0 ; t < n ; ++t)
+  {
+    if (std::isnan(ens.mu_hat[t]))
+    {
+      w[t] = -std::numeric_limits<double>::infinity() ;
+      continue ;
+    }
+
+    double log_w = -rate_diff ;
+    for (size_t j = 0 ; j < n_bins ; ++j)
+      if (ens.counts[t*n_bins + j] > 0)
+        log_w += ens.counts[t*n_bins + j] * log_ratio[j] ;
+
+    w[t] = log_w ;
+    log_max = std::max(log_max, log_w) ;
+  }
+
+  if (!std::isfinite(log_max))
+  {
+    w.assign(n, 0) ;
+    return 0 ;
+  }
+
+  double sum = 0, sum_2 = 0 ;
+  for (double& v : w)
+  {
+    v = std::exp(v - log_max) ;
+    sum   += v ;
+    sum_2 += v*v ;
+  }
+
+  return sum*sum / sum_2 ;
+}
+
+//--------------------------------------------------------------
+CLsLimit::Point CLsLimit::Eval(const double& mu, const size_t& n_toys)
+{
+  Point p ;
+  p.mu = mu ;
+  const double q_obs = TestStat(mu) ;
+
+  // ............ Background only ............
+  Extend(b_toys, n_toys) ;
+  std::vector<double> q = TestStat(b_toys, mu) ;
+
+  double pass_b = 0 ;
+  for (double v : q)
+  {
+    if (std::isnan(v)) continue ;
+    p.n_b++ ;
+    pass_b += (v >= q_obs) ;
+  }
+  const double cl_b = p.n_b > 0 ? pass_b / p.n_b : NaN ;
+  // .........................................
+
+  // ............ Signal + background ............
+  // The toys of this mu, or the cached toys with the most effective
+  //  toys, if there are enough of them, or new toys
+  double bg ;
+  obs_fitter.Profile(mu, &bg) ;
+
+  std::vector<double> w, best_w ;
+  Ensemble* ens = nullptr ;
+  for (auto&& e : sb_toys)
+  {
+    if (e.mu == mu && e.bg == bg)
+    {
+      ens  = &e ;
+      p.n_sb = 0 ;
+      break ;
+    }
+
+    double n_eff = Weights(e, mu, bg, w) ;
+    if (n_eff > p.n_sb)
+    {
+      ens    = &e ;
+      p.n_sb = n_eff ;
+      best_w.swap(w) ;
+    }
+  }
+
+  if (ens == nullptr || p.n_sb == 0 || (p.n_sb < 0.5*n_toys))
+  {
+    if (ens == nullptr || p.n_sb != 0)
+    {
+      sb_toys.emplace_back() ;
+      ens = &sb_toys.back() ;
+      ens->mu = mu ;
+      ens->bg = bg ;
+      ens->stream = sb_toys.size() ;
+    }
+    Extend(*ens, n_toys) ;
+    p.n_sb = Weights(*ens, mu, bg, best_w) ;
+  }
+
+  q = TestStat(*ens, mu) ;
+  double pass_sb = 0, sum_w = 0 ;
+  for (size_t t = 0 ; t < q.size() ; ++t)
+  {
+    if (std::isnan(q[t])) continue ;
+    sum_w   += best_w[t] ;
+    pass_sb += best_w[t] * (q[t] >= q_obs) ;
+  }
+  const double cl_sb = sum_w > 0 ? pass_sb / sum_w : NaN ;
+  // .............................................
+
+  // CLs, and its binomial error
+  const double b_min = std::max(cl_b, 1 / std::max(1.0, p.n_b)) ;
+  p.cls = cl_sb / b_min ;
+
+  double var_sb = cl_sb*(1 - cl_sb) / p.n_sb ;
+  double var_b  = cl_b*(1 - cl_b) / p.n_b ;
+  p.cls_err = cl_sb > 0 ? p.cls*std::sqrt(var_sb/(cl_sb*cl_sb) + var_b/(b_min*b_min))
+                        : 1 / (p.n_sb*b_min) ;
+
+  scan.push_back(p) ;
+  return p ;
+}
+
+//--------------------------------------------------------------
+// CLs decreases with mu: the crossing is bracketed from the
+//  asymptotic limit, and found by interpolating ln(CLs)
+double CLsLimit::Limit(const double& cl)
+{
+  if (!obs_fit.valid) return NaN ;
+
+  const double alpha = 1 - cl ;
+
+  // More toys while CLs can't be told apart from alpha
+  auto cls_at = [&](const double& mu)
+  {
+    Point p = Eval(mu, n_min) ;
+    for (size_t n = 2*n_min ; n <= n_max && std::abs(p.cls - alpha) < 2*p.cls_err ; n *= 2)
+      if (std::min(p.n_b, p.n_sb) < 0.9*n)
+        p = Eval(mu, n) ;
+    return p.cls ;
+  } ;
+
+  // The asymptotic limit (one-sided)
+  const double z = ROOT::Math::normal_quantile(cl, 1) ;
+  double a = obs_fit.mu + z*std::sqrt(std::max(0.0, obs_fit.cov[0])) ;
+  if (!(a > 0)) a = 1 ;
+
+  // ............ Bracketing: CLs(a) > alpha >= CLs(b) ............
+  double fa = cls_at(a), b = a, fb = fa ;
+  size_t it = 0 ;
+  if (fa > alpha)
+    do { a = b ; fa = fb ; b *= 2 ; fb = cls_at(b) ; }
+    while (fb > alpha && ++it < 40) ;
+  else
+    do { b = a ; fb = fa ; a *= 0.5 ; fa = cls_at(a) ; }
+    while (fa <= alpha && ++it < 40) ;
+  if (it >= 40) return NaN ;
+  // ..............................................................
+
+  // ............ The crossing: Illinois ............
+  // In ln(CLs / alpha), which is nearly linear in mu
+  double ga = std::log(fa / alpha), gb = std::log(fb / alpha) ;
+  double x = 0.5*(a + b) ;
+  int side = 0 ;
+  for (it = 0 ; it < 40 && b - a > tol*b ; ++it)
+  {
+    x = a + (b - a) * ga / (ga - gb) ;
+    if (!(x > a && x < b)) x = 0.5*(a + b) ;
+
+    double gx = std::log(cls_at(x) / alpha) ;
+    if (gx == 0) return x ;
+
+    // The end kept twice has its value halved
+    if (gx > 0)
+    {
+      a = x ; ga = gx ;
+      if (side == 1) gb *= 0.5 ;
+      side = 1 ;
+    }
+    else
+    {
+      b = x ; gb = gx ;
+      if (side == -1) ga *= 0.5 ;
+      side = -1 ;
+    }
+  }
+  // .................................................
+
+  x = a + (b - a) * ga / (ga - gb) ;
+  return (x > a && x < b) ? x : 0.5*(a + b) ;
+}
+
+//==============================================================
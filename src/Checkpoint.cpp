@@ -0,0 +1,164 @@
+/*
+  Checkpoint class
+
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+
+// Local headers
+#include "DMSS/Checkpoint.hpp"
+
+//==============================================================
+Checkpoint::Checkpoint(const Zaki::String::Directory& f_name, const bool resume)
+  : Prog("Checkpoint", true), file(f_name)
+{
+  if (resume)
+    Load(file, units) ;
+
+  // Rewriting the previous records drops a torn last line 
+  //  (and the duplicates). The new file replaces the old one
+  //  only when it's complete, so a crash here loses nothing.
+  std::string tmp_file = file.Str() + ".tmp" ;
+  out = fopen(tmp_file.c_str(), "w") ;
+  if (!out)
+  {
+    Z_LOG_ERROR("Checkpoint file '" + tmp_file + "' cannot be opened!") ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  for (auto&& u : units)
+    Write(u.first, u.second) ;
+  fflush(out) ;
+  fsync(fileno(out)) ;
+  fclose(out) ;
+
+  // New records are appended
+  if (std::rename(tmp_file.c_str(), file.Str().c_str()) != 0 ||
+      !(out = fopen(file.Str().c_str(), "a")) )
+  {
+    Z_LOG_ERROR("Checkpoint file '" + file.Str() + "' cannot be opened!") ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  char tmp[200] ;
+  sprintf(tmp, "Checkpointing into '%s' (%zu finished units).",
+          file.Str().c_str(), units.size()) ;
+  Z_LOG_INFO(tmp) ;
+}
+
+//--------------------------------------------------------------
+Checkpoint::~Checkpoint()
+{
+  if (out) fclose(out) ;
+}
+
+//--------------------------------------------------------------
+bool Checkpoint::Load(const Zaki::String::Directory& f_name, UnitMap& out_units)
+{
+  std::ifstream in(f_name.Str()) ;
+  if (in.fail()) return false ;
+
+  std::string line ;
+  while (std::getline(in, line))
+  {
+    size_t tab = line.find('\t') ;
+
+    // A torn record (the run stopped while writing it)
+    if (in.eof() || tab == std::string::npos) break ;
+
+    // 'strtod' also reads the 'nan' & 'inf' written by 'Write'
+    std::vector<double> vals ;
+    bool torn = false ;
+    const char* pos = line.c_str() + tab + 1 ;
+    while (*pos)
+    {
+      char* end = nullptr ;
+      double v = std::strtod(pos, &end) ;
+      if (end == pos || (*end != ' ' && *end != '\0'))
+      {
+        torn = true ;
+        break ;
+      }
+      vals.push_back(v) ;
+      pos = *end ? end + 1 : end ;
+    }
+    if (torn) break ;
+
+    out_units[line.substr(0, tab)] = vals ;
+  }
+
+  return true ;
+}
+
+//--------------------------------------------------------------
+bool Checkpoint::Import(const Zaki::String::Directory& f_name)
+{
+  std::lock_guard<std::mutex> lock(mtx) ;
+
+  UnitMap other ;
+  if (!Load(f_name, other)) return false ;
+
+  for (auto&& u : other)
+  {
+    units[u.first] = u.second ;
+    Write(u.first, u.second) ;
+  }
+  fflush(out) ;
+  fsync(fileno(out)) ;
+
+  char tmp[200] ;
+  sprintf(tmp, "Imported %zu units from '%s'.", other.size(),
+          f_name.Str().c_str()) ;
+  Z_LOG_INFO(tmp) ;
+
+  return true ;
+}
+
+//--------------------------------------------------------------
+bool Checkpoint::Find(const std::string& key, std::vector<double>& vals) const
+{
+  std::lock_guard<std::mutex> lock(mtx) ;
+
+  auto it = units.find(key) ;
+  if (it == units.end()) return false ;
+
+  vals = it->second ;
+  return true ;
+}
+
+//--------------------------------------------------------------
+void Checkpoint::Write(const std::string& key, const std::vector<double>& vals)
+{
+  std::string line = key + "\t" ;
+  char tmp[32] ;
+  for (size_t i = 0 ; i < vals.size() ; ++i)
+  {
+    sprintf(tmp, i == 0 ? "%.17g" : " %.17g", vals[i]) ;
+    line += tmp ;
+  }
+  line += "\n" ;
+
+  fputs(line.c_str(), out) ;
+}
+
+//--------------------------------------------------------------
+void Checkpoint::Save(const std::string& key, const std::vector<double>& vals)
+{
+  std::lock_guard<std::mutex> lock(mtx) ;
+  units[key] = vals ;
+
+  Write(key, vals) ;
+  fflush(out) ;
+  fsync(fileno(out)) ;
+}
+
+//--------------------------------------------------------------
+size_t Checkpoint::Size() const
+{
+  std::lock_guard<std::mutex> lock(mtx) ;
+  return units.size() ;
+}
+
+//==============================================================
@@ -10,11 +10,11 @@
 #include <TCanvas.h>
 #include <TStyle.h>
 
-#include <Zaki/File/CSVIterator.hpp>
 #include <Zaki/File/VecSaver.hpp>
 
 // Local headers
 #include "DMSS/Data.hpp"
+#include "DMSS/FluxLoader.hpp"
 
 //==============================================================
 
@@ -29,6 +29,13 @@ Bin& Data::operator[](size_t index)
   return bins[index];
 }
 
+//--------------------------------------------------------------
+// [] Operator (read-only)
+const Bin& Data::operator[](size_t index) const
+{
+  return bins[index];
+}
+
 //--------------------------------------------------------------
 // size
 size_t Data::size() const 
@@ -50,6 +57,20 @@ void Data::AddBin(const Bin& b)
   edge_vec.push_back(b.GetERange().max);
 }
 
+//--------------------------------------------------------------
+// Adding bins (taking over the bin)
+void Data::AddBin(Bin&& b) 
+{
+  // For the first bin we add the left edge
+  if(bins.empty())
+    edge_vec.push_back(b.GetERange().min);
+
+  // For all bins we add the right edge
+  edge_vec.push_back(b.GetERange().max);
+
+  bins.push_back(std::move(b)) ;
+}
+
 //--------------------------------------------------------------
 // Adding bins
 void Data::AddBin(const Zaki::Math::Range<double>& in_e_range,
@@ -84,39 +105,31 @@ void Data::ScaleData(const double& r )
 //--------------------------------------------------------------
 void Data::Input(const Zaki::String::Directory& file_name)
 {  
-  std::ifstream     file(file_name.Str());
-  
-  if (file.fail())
-  {
-    Z_LOG_ERROR(("Data file '" + file_name.Str() + "' cannot be opened!").c_str()) ;
-    exit(EXIT_FAILURE) ;
-    // return;
-  }
-  else
-  {
-    Z_LOG_INFO(("Data file '" + file_name.Str() + "' imported.").c_str()) ;
-  }
-  
-  // Reading the input file
-  for(Zaki::File::CSVIterator loop(file); loop != Zaki::File::CSVIterator(); ++loop)
+  FluxLoader loader(file_name) ;
+  const std::vector<FluxRow>& rows = loader.Load() ;
+
+  Z_LOG_INFO(("Data file '" + file_name.Str() + "' imported.").c_str()) ;
+
+  Reserve(bins.size() + rows.size()) ;
+
+  for(const FluxRow& r : rows)
   {
-//    Bin b0 ;
-//    // b0.SetName(GetName().c_str()) ;
-//    b0.SetERange(std::stof((*loop)[0]), std::stof((*loop)[1])) ;
-//    b0.SetECenter(std::stof((*loop)[2]), std::stof((*loop)[3])) ;
-//    b0.SetNCount(std::stof((*loop)[4]), std::stof((*loop)[5])) ;
-//    b0.SetFlux(std::stof((*loop)[6]), std::stof((*loop)[7]), std::stof((*loop)[8]) ) ;
-      
     AddBin(
-            { std::stof((*loop)[0]), std::stof((*loop)[1]) },
-            { std::stof((*loop)[2]), std::stof((*loop)[3]) },
-            { std::stof((*loop)[4]), std::stof((*loop)[5]) },
-            { std::stof((*loop)[6]), std::stof((*loop)[7]), std::stof((*loop)[8]) }
+            { r.e_min, r.e_max },
+            { r.e_c, r.e_c_err },
+            { r.n, r.n_err },
+            { r.flux, r.stat_err, r.sys_err }
            ) ;
-//    AddBin(b0);
   }
 }
 
+//--------------------------------------------------------------
+void Data::Reserve(size_t n)
+{
+  bins.reserve(n) ;
+  edge_vec.reserve(n + 1) ;
+}
+
 //--------------------------------------------------------------
 void Data::SetStates(const std::vector<DMSolarSignal::Particle>& in_states)
 {
@@ -196,7 +209,7 @@ void Data::Plot(const Zaki::String::Directory& f_name) const
 }
 
 //--------------------------------------------------------------
-std::vector<Bin> Data::GetBins() const
+const std::vector<Bin>& Data::GetBins() const
 {
   return bins;
 }
@@ -0,0 +1,304 @@
+/*
+  FitCache class
+
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// Local headers
+#include "DMSS/FitCache.hpp"
+
+//==============================================================
+namespace
+{
+  const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL ;
+
+  /// The 'splitmix64' finalizer (a bijective 64-bit mix)
+  uint64_t Mix(uint64_t z)
+  {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL ;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL ;
+    return z ^ (z >> 31) ;
+  }
+
+  /// Reads a line, returns false if it's not complete
+  bool ReadLine(FILE* in, std::string& line)
+  {
+    line.clear() ;
+    char buf[4096] ;
+    while (fgets(buf, sizeof(buf), in))
+    {
+      line += buf ;
+      if (line.back() == '\n') return true ;
+    }
+    return false ;
+  }
+
+  /// Splits a record line, returns false if it's torn
+  bool ParseRecord(const std::string& line, std::string& key,
+                   std::vector<double>& vals)
+  {
+    size_t tab = line.find('\t') ;
+    if (tab == std::string::npos) return false ;
+
+    const char* p = line.c_str() + tab + 1 ;
+    char* end ;
+    long n = std::strtol(p, &end, 10) ;
+    if (end == p || n < 0) return false ;
+
+    vals.clear() ;
+    vals.reserve(n) ;
+    for (long i = 0 ; i < n ; ++i)
+    {
+      p = end ;
+      double v = std::strtod(p, &end) ;
+      if (end == p) return false ;
+      vals.push_back(v) ;
+    }
+
+    // Nothing but the newline after the values
+    if (*end != '\n') return false ;
+
+    key = line.substr(0, tab) ;
+    return true ;
+  }
+}
+
+//==============================================================
+FitCache::Key::Key(const std::string& in_kind)
+  : kind(in_kind), h1(GOLDEN_GAMMA), h2(Mix(GOLDEN_GAMMA))
+{
+  Add(kind) ;
+}
+
+//--------------------------------------------------------------
+void FitCache::Key::AddWord(const uint64_t& w)
+{
+  h1 = Mix(h1 + w*GOLDEN_GAMMA) ;
+  h2 = Mix(h2 ^ Mix(w + GOLDEN_GAMMA)) ;
+}
+
+//--------------------------------------------------------------
+FitCache::Key& FitCache::Key::Add(const double& v)
+{
+  uint64_t w ;
+  memcpy(&w, &v, sizeof(w)) ;
+  AddWord(w) ;
+
+  return *this ;
+}
+
+//--------------------------------------------------------------
+FitCache::Key& FitCache::Key::Add(const std::vector<double>& vec)
+{
+  AddWord(vec.size()) ;
+  for (const double v : vec)
+    Add(v) ;
+
+  return *this ;
+}
+
+//--------------------------------------------------------------
+FitCache::Key& FitCache::Key::Add(const std::string& str)
+{
+  AddWord(str.size()) ;
+  for (size_t i = 0 ; i < str.size() ; i += 8)
+  {
+    uint64_t w = 0 ;
+    memcpy(&w, str.data() + i, std::min<size_t>(8, str.size() - i)) ;
+    AddWord(w) ;
+  }
+
+  return *this ;
+}
+
+//--------------------------------------------------------------
+std::string FitCache::Key::Str() const
+{
+  char tmp[40] ;
+  sprintf(tmp, "%016llx%016llx", (unsigned long long)h1, (unsigned long long)h2) ;
+
+  return kind + "|" + tmp ;
+}
+
+//==============================================================
+FitCache& FitCache::Get()
+{
+  static FitCache cache ;
+  return cache ;
+}
+
+//--------------------------------------------------------------
+FitCache::FitCache()
+{
+  if (const char* env = std::getenv("DMSS_FIT_CACHE"))
+    Open(env) ;
+}
+
+//--------------------------------------------------------------
+FitCache::~FitCache()
+{
+  if (in)  fclose(in) ;
+  if (out) fclose(out) ;
+}
+
+//--------------------------------------------------------------
+void FitCache::SetCapacity(const size_t& in_cap)
+{
+  std::lock_guard<std::mutex> lock(mtx) ;
+
+  capacity = std::max<size_t>(1, in_cap) ;
+  while (lru.size() > capacity)
+  {
+    lru_idx.erase(lru.back().first) ;
+    lru.pop_back() ;
+  }
+}
+
+//--------------------------------------------------------------
+void FitCache::Open(const Zaki::String::Directory& f_name)
+{
+  std::lock_guard<std::mutex> lock(mtx) ;
+
+  if (in)  fclose(in) ;
+  if (out) fclose(out) ;
+  in = out = nullptr ;
+  offsets.clear() ;
+
+  file = f_name ;
+
+  // Indexing the previous records (the torn ones are skipped)
+  bool torn_end = false ;
+  if (FILE* old = fopen(file.Str().c_str(), "r"))
+  {
+    std::string line, key ;
+    std::vector<double> vals ;
+    for (long offset = ftell(old) ; ; offset = ftell(old))
+    {
+      bool full = ReadLine(old, line) ;
+      if (line.empty()) break ;
+
+      torn_end = !full ;
+      if (full && ParseRecord(line, key, vals))
+        offsets[key] = offset ;
+    }
+    fclose(old) ;
+  }
+
+  // New records are appended (after ending a torn last line)
+  if (!(out = fopen(file.Str().c_str(), "a")) ||
+      !(in  = fopen(file.Str().c_str(), "r")) )
+  {
+    Z_LOG_ERROR("Fit cache file '" + file.Str() + "' cannot be opened!") ;
+    exit(EXIT_FAILURE) ;
+  }
+  if (torn_end)
+    fputs("\n", out) ;
+
+  char tmp[200] ;
+  sprintf(tmp, "Caching the fits in '%s' (%zu cached fits).",
+          file.Str().c_str(), offsets.size()) ;
+  Z_LOG_INFO(tmp) ;
+}
+
+//--------------------------------------------------------------
+void FitCache::Touch(const std::string& key, const std::vector<double>& vals)
+{
+  auto it = lru_idx.find(key) ;
+  if (it != lru_idx.end())
+  {
+    it->second->second = vals ;
+    lru.splice(lru.begin(), lru, it->second) ;
+    return ;
+  }
+
+  lru.emplace_front(key, vals) ;
+  lru_idx[key] = lru.begin() ;
+
+  if (lru.size() > capacity)
+  {
+    lru_idx.erase(lru.back().first) ;
+    lru.pop_back() ;
+  }
+}
+
+//--------------------------------------------------------------
+bool FitCache::ReadRecord(const long& offset, std::string& key,
+                          std::vector<double>& vals)
+{
+  std::string line ;
+  return fseek(in, offset, SEEK_SET) == 0 && ReadLine(in, line) &&
+         ParseRecord(line, key, vals) ;
+}
+
+//--------------------------------------------------------------
+bool FitCache::Find(const std::string& key, std::vector<double>& vals)
+{
+  std::lock_guard<std::mutex> lock(mtx) ;
+
+  auto it = lru_idx.find(key) ;
+  if (it != lru_idx.end())
+  {
+    lru.splice(lru.begin(), lru, it->second) ;
+    vals = it->second->second ;
+    hits++ ;
+    return true ;
+  }
+
+  auto off = offsets.find(key) ;
+  std::string rec_key ;
+  if (off != offsets.end() && ReadRecord(off->second, rec_key, vals)
+      && rec_key == key)
+  {
+    Touch(key, vals) ;
+    hits++ ;
+    return true ;
+  }
+
+  misses++ ;
+  return false ;
+}
+
+//--------------------------------------------------------------
+void FitCache::Save(const std::string& key, const std::vector<double>& vals)
+{
+  std::lock_guard<std::mutex> lock(mtx) ;
+
+  Touch(key, vals) ;
+
+  if (!out || offsets.count(key)) return ;
+
+  std::string line = key + "\t" + std::to_string(vals.size()) ;
+  char tmp[32] ;
+  for (const double v : vals)
+  {
+    sprintf(tmp, " %.17g", v) ;
+    line += tmp ;
+  }
+  line += "\n" ;
+
+  fseek(out, 0, SEEK_END) ;
+  long offset = ftell(out) ;
+  fputs(line.c_str(), out) ;
+  fflush(out) ;
+
+  offsets[key] = offset ;
+}
+
+//--------------------------------------------------------------
+size_t FitCache::Hits() const
+{
+  std::lock_guard<std::mutex> lock(mtx) ;
+  return hits ;
+}
+
+//--------------------------------------------------------------
+size_t FitCache::Misses() const
+{
+  std::lock_guard<std::mutex> lock(mtx) ;
+  return misses ;
+}
+
+//==============================================================
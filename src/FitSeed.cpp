@@ -0,0 +1,296 @@
+/*
+  FitSeed class
+
+*/
+
+#include <algorithm>
+#include <cmath>
+
+//  Minuit2
+#include <Minuit2/MnMigrad.h>
+#include <Minuit2/MnStrategy.h>
+
+// Local headers
+#include "DMSS/FitSeed.hpp"
+#include "DMSS/TaskPool.hpp"
+
+//==============================================================
+// Constructor
+FitSeed::FitSeed() { }
+
+//--------------------------------------------------------------
+FitSeed::FitSeed(const ROOT::Minuit2::FunctionMinimum& min)
+  : state(min.UserState()), valid(min.IsValid())
+{ }
+
+//--------------------------------------------------------------
+// The errors are the square roots of the variances (or zero, so
+//  that 'Start' keeps the default errors)
+FitSeed::FitSeed(const std::vector<std::string>& names, const std::vector<double>& vals,
+                 const std::vector<double>& cov)
+{
+  if (names.size() != vals.size() || vals.empty())
+    return ;
+
+  const bool has_cov = (cov.size() == vals.size()*(vals.size() + 1)/2) ;
+
+  ROOT::Minuit2::MnUserParameters par ;
+  for (size_t i = 0 ; i < vals.size() ; ++i)
+  {
+    double var = has_cov ? cov[i*(i+3)/2] : 0 ;
+    par.Add(names[i], vals[i], var > 0 ? std::sqrt(var) : 0) ;
+  }
+
+  state = has_cov ? ROOT::Minuit2::MnUserParameterState(par,
+                      ROOT::Minuit2::MnUserCovariance(cov, vals.size()))
+                  : ROOT::Minuit2::MnUserParameterState(par) ;
+  valid = true ;
+}
+
+//--------------------------------------------------------------
+bool FitSeed::Valid() const
+{
+  return valid ;
+}
+
+//--------------------------------------------------------------
+// {n, values (n), m, covariance (m)}, with n = 0 if it's empty
+void FitSeed::Pack(std::vector<double>& vals) const
+{
+  if (!valid)
+  {
+    vals.push_back(0) ;
+    return ;
+  }
+
+  const std::vector<ROOT::Minuit2::MinuitParameter>& par = state.MinuitParameters() ;
+  vals.push_back(par.size()) ;
+  for (auto&& p : par)
+    vals.push_back(p.Value()) ;
+
+  std::vector<double> cov ;
+  if (state.HasCovariance() && state.Covariance().Nrow() == par.size())
+    cov = state.Covariance().Data() ;
+  vals.push_back(cov.size()) ;
+  vals.insert(vals.end(), cov.begin(), cov.end()) ;
+}
+
+//--------------------------------------------------------------
+bool FitSeed::Unpack(const std::vector<double>& vals, size_t& pos,
+                     const std::vector<std::string>& names)
+{
+  if (pos >= vals.size()) return false ;
+
+  const size_t n = (size_t)vals[pos] ;
+  if (n == 0)
+  {
+    *this = FitSeed() ;
+    pos++ ;
+    return true ;
+  }
+
+  if (n != names.size() || pos + n + 2 > vals.size()) return false ;
+
+  const size_t m = (size_t)vals[pos + n + 1] ;
+  if (pos + n + 2 + m > vals.size()) return false ;
+
+  std::vector<double> par(vals.begin() + pos + 1, vals.begin() + pos + 1 + n) ;
+  std::vector<double> cov(vals.begin() + pos + n + 2, vals.begin() + pos + n + 2 + m) ;
+  *this = FitSeed(names, par, cov) ;
+  pos += n + 2 + m ;
+
+  return true ;
+}
+
+//--------------------------------------------------------------
+const ROOT::Minuit2::MnUserParameterState& FitSeed::GetState() const
+{
+  return state ;
+}
+
+//--------------------------------------------------------------
+ROOT::Minuit2::MnUserParameterState FitSeed::Start(const ROOT::Minuit2::MnUserParameters& upar) const
+{
+  if (!valid)
+    return ROOT::Minuit2::MnUserParameterState(upar) ;
+
+  const std::vector<ROOT::Minuit2::MinuitParameter>& prev = state.MinuitParameters() ;
+
+  ROOT::Minuit2::MnUserParameters par(upar) ;
+  bool same_set = (prev.size() == upar.Parameters().size()) ;
+
+  for (unsigned int i = 0 ; i < upar.Parameters().size() ; ++i)
+  {
+    const ROOT::Minuit2::MinuitParameter& p = upar.Parameter(i) ;
+
+    auto it = std::find_if(prev.begin(), prev.end(),
+              [&p](const ROOT::Minuit2::MinuitParameter& q)
+              { return q.GetName() == p.GetName() ; }) ;
+
+    if (it == prev.end() || p.IsFixed() || p.IsConst())
+    {
+      same_set = false ;
+      continue ;
+    }
+    same_set = same_set && (it - prev.begin() == i) ;
+
+    // Minuit's transformation is flat at the limits, so the
+    //  start is kept a tenth of the error away from them
+    double err = it->Error() > 0 ? it->Error() : p.Error() ;
+    double val = it->Value() ;
+    if (p.HasLowerLimit())
+      val = std::max(val, p.LowerLimit() + 0.1*err) ;
+    if (p.HasUpperLimit())
+      val = std::min(val, p.UpperLimit() - 0.1*err) ;
+
+    par.SetValue(i, val) ;
+    par.SetError(i, err) ;
+  }
+
+  ROOT::Minuit2::MnUserParameterState out(par) ;
+
+  // The same parameters: Migrad starts with the seed's
+  //  covariance, instead of the numerical second derivatives
+  if (same_set && state.HasCovariance() &&
+      state.VariableParameters() == out.VariableParameters())
+    return ROOT::Minuit2::MnUserParameterState(par, state.Covariance()) ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+ROOT::Minuit2::FunctionMinimum FitSeed::Migrad(const ROOT::Minuit2::FCNBase& fcn,
+                                               const ROOT::Minuit2::MnUserParameters& upar,
+                                               const FitSeed* seed,
+                                               const unsigned int& strategy,
+                                               const unsigned int& max_calls)
+{
+  ROOT::Minuit2::MnStrategy stra(strategy) ;
+
+  if (seed && seed->Valid())
+  {
+    ROOT::Minuit2::MnMigrad migrad(fcn, seed->Start(upar), stra) ;
+    ROOT::Minuit2::FunctionMinimum min = migrad(max_calls) ;
+
+    if (min.IsValid())
+      return min ;
+  }
+
+  ROOT::Minuit2::MnMigrad migrad(fcn, ROOT::Minuit2::MnUserParameterState(upar), stra) ;
+  return migrad(max_calls) ;
+}
+
+//==============================================================
+MinosResult::MinosResult() { }
+
+//--------------------------------------------------------------
+MinosResult::MinosResult(const ROOT::Minuit2::MinosError& err)
+  : min(err.Min()), lower(err.Lower()), upper(err.Upper()),
+    valid(err.IsValid()), nfcn(err.NFcn())
+{ }
+
+//--------------------------------------------------------------
+MinosResult::MinosResult(const double& in_min, const double& in_lower, 
+                         const double& in_upper, const bool in_valid,
+                         const unsigned int& in_nfcn)
+  : min(in_min), lower(in_lower), upper(in_upper),
+    valid(in_valid), nfcn(in_nfcn)
+{ }
+
+//--------------------------------------------------------------
+double MinosResult::Min() const
+{
+  return min ;
+}
+
+//--------------------------------------------------------------
+double MinosResult::Lower() const
+{
+  return lower ;
+}
+
+//--------------------------------------------------------------
+double MinosResult::Upper() const
+{
+  return upper ;
+}
+
+//--------------------------------------------------------------
+bool MinosResult::IsValid() const
+{
+  return valid ;
+}
+
+//--------------------------------------------------------------
+unsigned int MinosResult::NFcn() const
+{
+  return nfcn ;
+}
+
+//--------------------------------------------------------------
+void MinosResult::Pack(std::vector<double>& vals) const
+{
+  vals.insert(vals.end(), {min, lower, upper, valid ? 1. : 0., (double)nfcn}) ;
+}
+
+//--------------------------------------------------------------
+bool MinosResult::Unpack(const std::vector<double>& vals, size_t& pos)
+{
+  if (pos + 5 > vals.size()) return false ;
+
+  min   = vals[pos] ;
+  lower = vals[pos+1] ;
+  upper = vals[pos+2] ;
+  valid = vals[pos+3] != 0 ;
+  nfcn  = (unsigned int)vals[pos+4] ;
+  pos += 5 ;
+
+  return true ;
+}
+
+//--------------------------------------------------------------
+std::ostream& operator<<(std::ostream& os, const MinosResult& err)
+{
+  os << "Minos: " << err.Min() << " " << err.Lower() << " +" << err.Upper()
+     << (err.IsValid() ? " (valid" : " (invalid") << ", " 
+     << err.NFcn() << " calls)" ;
+  return os ;
+}
+
+//==============================================================
+FitChain::FitChain(const size_t& n, const size_t& in_len)
+  : len(std::max<size_t>(1, in_len)), seeds(n)
+{ }
+
+//--------------------------------------------------------------
+size_t FitChain::Length() const
+{
+  return len ;
+}
+
+//--------------------------------------------------------------
+const FitSeed* FitChain::Prev(const size_t& i) const
+{
+  if (i % len == 0 || !seeds[i-1].Valid())
+    return nullptr ;
+
+  return &seeds[i-1] ;
+}
+
+//--------------------------------------------------------------
+void FitChain::Set(const size_t& i, const FitSeed& seed)
+{
+  seeds[i] = seed ;
+}
+
+//--------------------------------------------------------------
+void FitChain::Run(const std::function<void(size_t)>& fit)
+{
+  TaskPool::Get().ParallelFor((seeds.size() + len - 1) / len, [&](size_t c)
+  {
+    for (size_t i = c*len ; i < std::min(seeds.size(), (c+1)*len) ; ++i)
+      fit(i) ;
+  }) ;
+}
+
+//==============================================================
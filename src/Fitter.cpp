@@ -16,6 +16,7 @@
 #include <TF1.h>
 
 #include "DMSS/Fitter.hpp"
+#include "DMSS/PlotQueue.hpp"
 //==============================================================
 //--------------------------------------------------------------
 // Constructor
@@ -178,29 +179,37 @@ double Fitter::FitIdx(const size_t& idx) const
 
   //......................................................
   // Plotting
-  // !! Changing A_frac to it's upper limit for the plots !!
-  A_frac.setVal(CL_2sigma_A_frac) ;
-  TCanvas c1("c1", "HistPdf Canvas", 1600, 800) ;
-  RooPlot* xframe = x.frame() ;
-  
-  xframe->SetTitle("Constant Observed Events") ;
-  xframe->SetXTitle("t (Days)") ;
-
-  data.plotOn(xframe, RooFit::LineColor(kBlue) ) ;
-  AB_hpdf.plotOn(xframe, RooFit::LineColor(kPink) ) ;
-  AB_hpdf.plotOn(xframe, RooFit::Components("A_hist_pdf"), RooFit::LineColor(kGreen) ) ;
-  // AB_hpdf.plotOn(xframe, RooFit::Components("B_hist_pdf"), RooFit::LineStyle(kDotted),
-                  // RooFit::LineColor(kCyan) ) ;
-
-  xframe->SetAxisRange(obs_set[idx][0].val - 1.1*obs_set[idx][0].err, 
-                        obs_set[idx][0].val + 1.1*obs_set[idx][0].err, "Y") ;
-
-  xframe->Draw() ;
-
-  char out_file_char[150] ;    
-  sprintf(out_file_char, "RooFit/Modulation_Hist_%lu.pdf", idx) ;
-  
-  c1.SaveAs((wrk_dir + "/" + out_file_char).Str().c_str()) ;
+  // The curves are evaluated here into the frame, which
+  //  is drawn later by the plot queue
+  if (!PlotQueue::Headless())
+  {
+    // !! Changing A_frac to it's upper limit for the plots !!
+    A_frac.setVal(CL_2sigma_A_frac) ;
+    std::shared_ptr<RooPlot> xframe(x.frame()) ;
+    
+    xframe->SetTitle("Constant Observed Events") ;
+    xframe->SetXTitle("t (Days)") ;
+
+    data.plotOn(xframe.get(), RooFit::LineColor(kBlue) ) ;
+    AB_hpdf.plotOn(xframe.get(), RooFit::LineColor(kPink) ) ;
+    AB_hpdf.plotOn(xframe.get(), RooFit::Components("A_hist_pdf"), RooFit::LineColor(kGreen) ) ;
+    // AB_hpdf.plotOn(xframe, RooFit::Components("B_hist_pdf"), RooFit::LineStyle(kDotted),
+                    // RooFit::LineColor(kCyan) ) ;
+
+    xframe->SetAxisRange(obs_set[idx][0].val - 1.1*obs_set[idx][0].err, 
+                          obs_set[idx][0].val + 1.1*obs_set[idx][0].err, "Y") ;
+
+    char out_file_char[150] ;    
+    sprintf(out_file_char, "RooFit/Modulation_Hist_%lu.pdf", idx) ;
+    std::string out_file = (wrk_dir + "/" + out_file_char).Str() ;
+
+    PlotQueue::Push([xframe, out_file]()
+    {
+      TCanvas c1("c1", "HistPdf Canvas", 1600, 800) ;
+      xframe->Draw() ;
+      c1.SaveAs(out_file.c_str()) ;
+    }) ;
+  }
   //......................................................
 
   return CL_2sigma_A_frac / sig_shape_hist[idx].Integral() ;
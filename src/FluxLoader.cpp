@@ -0,0 +1,181 @@
+/*
+  FluxLoader class
+
+*/
+
+#include <algorithm>
+#include <charconv>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Zaki/Util/Logger.hpp>
+
+// Local headers
+#include "DMSS/FluxLoader.hpp"
+
+//==============================================================
+//                      MappedFile
+//==============================================================
+MappedFile::MappedFile(const Zaki::String::Directory& f_name)
+{
+  int fd = open(f_name.Str().c_str(), O_RDONLY) ;
+  if (fd < 0) return ;
+
+  struct stat st ;
+  if (fstat(fd, &st) == 0)
+  {
+    len = static_cast<size_t>(st.st_size) ;
+
+    // mmap of an empty file fails, but an empty file is still open
+    if (len == 0)
+      open_flag = true ;
+    else
+    {
+      void* ptr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0) ;
+      if (ptr != MAP_FAILED)
+      {
+        data = static_cast<const char*>(ptr) ;
+        madvise(ptr, len, MADV_SEQUENTIAL) ;
+        open_flag = true ;
+      }
+    }
+  }
+
+  close(fd) ;
+}
+
+//--------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+  if (data)
+    munmap(const_cast<char*>(data), len) ;
+}
+
+//--------------------------------------------------------------
+bool MappedFile::IsOpen() const
+{
+  return open_flag ;
+}
+
+//--------------------------------------------------------------
+std::string_view MappedFile::View() const
+{
+  return data ? std::string_view(data, len) : std::string_view() ;
+}
+
+//==============================================================
+//                      FluxLoader
+//==============================================================
+FluxLoader::FluxLoader(const Zaki::String::Directory& f_name)
+  : file_name(f_name) {}
+
+//--------------------------------------------------------------
+bool FluxLoader::ParseField(std::string_view f, double& out) const
+{
+  // Trimming the white spaces
+  while (!f.empty() && (f.front() == ' ' || f.front() == '\t'))
+    f.remove_prefix(1) ;
+  while (!f.empty() && (f.back() == ' ' || f.back() == '\t' || f.back() == '\r'))
+    f.remove_suffix(1) ;
+
+  if (f.empty()) return false ;
+
+  // Fast path: plain ASCII field
+  if (f.find('\xE2') == std::string_view::npos)
+  {
+    auto res = std::from_chars(f.data(), f.data() + f.size(), out) ;
+    return res.ec == std::errc() && res.ptr == f.data() + f.size() ;
+  }
+
+  // Slow path: replacing U+2212 (E2 88 92) with '-'
+  char buf[64] ;
+  size_t n = 0 ;
+  for (size_t i = 0 ; i < f.size() ; ++i)
+  {
+    if (n == sizeof(buf)) return false ;
+
+    if (f.compare(i, 3, "\xE2\x88\x92") == 0)
+    {
+      buf[n++] = '-' ;
+      i += 2 ;
+    }
+    else
+      buf[n++] = f[i] ;
+  }
+
+  auto res = std::from_chars(buf, buf + n, out) ;
+  return res.ec == std::errc() && res.ptr == buf + n ;
+}
+
+//--------------------------------------------------------------
+void FluxLoader::Fail(size_t row, size_t col, const char* msg,
+                      std::string_view field) const
+{
+  char tmp[256] ;
+  snprintf(tmp, sizeof(tmp), "'%s' row %zu, column %zu: %s ('%.*s').",
+           file_name.Str().c_str(), row, col, msg,
+           static_cast<int>(field.size() > 64 ? 64 : field.size()),
+           field.data()) ;
+  Z_LOG_ERROR(tmp) ;
+  exit(EXIT_FAILURE) ;
+}
+
+//--------------------------------------------------------------
+const std::vector<FluxRow>& FluxLoader::Load()
+{
+  MappedFile file(file_name) ;
+
+  if (!file.IsOpen())
+  {
+    Z_LOG_ERROR(("Data file '" + file_name.Str() + "' cannot be opened!").c_str()) ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  std::string_view txt = file.View() ;
+
+  rows.clear() ;
+  rows.reserve(std::count(txt.begin(), txt.end(), '\n') + 1) ;
+
+  size_t row_idx = 0 ;
+  while (!txt.empty())
+  {
+    size_t eol = txt.find('\n') ;
+    std::string_view line = txt.substr(0, eol) ;
+    txt.remove_prefix(eol == std::string_view::npos ? txt.size() : eol + 1) ;
+    ++row_idx ;
+
+    // Skipping blank lines
+    if (line.find_first_not_of(" \t\r") == std::string_view::npos)
+      continue ;
+
+    double vals[NCols] ;
+    size_t col = 0 ;
+    while (true)
+    {
+      size_t comma = line.find(',') ;
+      std::string_view field = line.substr(0, comma) ;
+
+      if (col == NCols)
+        Fail(row_idx, col + 1, "too many columns", line) ;
+      if (!ParseField(field, vals[col]))
+        Fail(row_idx, col + 1, "invalid number", field) ;
+      ++col ;
+
+      if (comma == std::string_view::npos) break ;
+      line.remove_prefix(comma + 1) ;
+    }
+
+    if (col != NCols)
+      Fail(row_idx, col, "too few columns", line) ;
+
+    rows.push_back({ vals[0], vals[1], vals[2], vals[3], vals[4],
+                     vals[5], vals[6], vals[7], vals[8] }) ;
+  }
+
+  return rows ;
+}
+//--------------------------------------------------------------
+
+//==============================================================
@@ -0,0 +1,227 @@
+/*
+  GridTable class
+
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// Local headers
+#include "DMSS/GridTable.hpp"
+#include "DMSS/TaskPool.hpp"
+
+//==============================================================
+namespace
+{
+  const char GRID_MAGIC[8] = {'D', 'M', 'S', 'S', 'G', 'R', 'D', '2'} ;
+
+  /// Header of a grid (or tile) file, followed by the values (x-major)
+  struct TileHeader
+  {
+    char magic[8] ;
+    uint64_t x_res, y_res ;
+    uint64_t k, n ;
+    double x_min, x_max, y_min, y_max ;
+    char x_scale[16], y_scale[16] ;
+    char label[256] ;
+  };
+
+  /// Copies a string into a fixed-size field
+  template <size_t N>
+  void SetField(char (&field)[N], const std::string& str)
+  {
+    memset(field, 0, N) ;
+    strncpy(field, str.c_str(), N - 1) ;
+  }
+
+  /// Linear interpolation, exact at the end points
+  double Lerp(const double& a, const double& b, const double& t)
+  {
+    if (t == 0) return a ;
+    if (t == 1) return b ;
+    return a + t*(b - a) ;
+  }
+}
+
+//==============================================================
+// Constructor
+GridTable::GridTable(const Zaki::Math::Grid2D& in_grid)
+  : Prog("GridTable", true), grid(in_grid)
+{
+  x_pts.reserve(grid.xAxis.res) ;
+  for (size_t i = 0 ; i < grid.xAxis.res ; ++i)
+    x_pts.push_back(grid.xAxis[i]) ;
+
+  y_pts.reserve(grid.yAxis.res) ;
+  for (size_t j = 0 ; j < grid.yAxis.res ; ++j)
+    y_pts.push_back(grid.yAxis[j]) ;
+
+  vals.assign(x_pts.size()*y_pts.size(), 0) ;
+  filled.assign(x_pts.size(), 0) ;
+}
+
+//--------------------------------------------------------------
+// Destructor
+GridTable::~GridTable() { }
+
+//--------------------------------------------------------------
+Zaki::Math::Range<size_t> GridTable::TileRange(const size_t& k, const size_t& n) const
+{
+  return {k*x_pts.size()/n, (k+1)*x_pts.size()/n} ;
+}
+
+//--------------------------------------------------------------
+void GridTable::Fill(const size_t& k, const size_t& n,
+                     const std::function<double(double, double)>& func)
+{
+  Zaki::Math::Range<size_t> r = TileRange(k, n) ;
+
+  TaskPool::Get().ParallelFor(r.max - r.min, [&](size_t i)
+  {
+    size_t x_idx = r.min + i ;
+    for (size_t j = 0 ; j < y_pts.size() ; ++j)
+      vals[x_idx*y_pts.size() + j] = func(x_pts[x_idx], y_pts[j]) ;
+
+    filled[x_idx] = 1 ;
+  }) ;
+}
+
+//--------------------------------------------------------------
+void GridTable::ExportTile(const size_t& k, const size_t& n,
+                           const Zaki::String::Directory& f_name) const
+{
+  Zaki::Math::Range<size_t> r = TileRange(k, n) ;
+
+  TileHeader head ;
+  memcpy(head.magic, GRID_MAGIC, sizeof(GRID_MAGIC)) ;
+  head.x_res = x_pts.size() ; head.y_res = y_pts.size() ;
+  head.k = k ; head.n = n ;
+  head.x_min = grid.xAxis.Min() ; head.x_max = grid.xAxis.Max() ;
+  head.y_min = grid.yAxis.Min() ; head.y_max = grid.yAxis.Max() ;
+  SetField(head.x_scale, grid.xAxis.scale) ;
+  SetField(head.y_scale, grid.yAxis.scale) ;
+  SetField(head.label, label) ;
+
+  // The file appears only when it's complete, so the other
+  //  processes never see a partial tile
+  std::string tmp_file = f_name.Str() + ".tmp" ;
+  FILE* out = fopen(tmp_file.c_str(), "wb") ;
+  if (!out)
+  {
+    Z_LOG_ERROR("Grid tile file '" + tmp_file + "' cannot be opened!") ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  size_t n_vals = (r.max - r.min)*y_pts.size() ;
+  bool ok = fwrite(&head, sizeof(head), 1, out) == 1 &&
+            fwrite(&vals[r.min*y_pts.size()], sizeof(double), n_vals, out) == n_vals ;
+  ok = (fclose(out) == 0) && ok ;
+
+  if (!ok || std::rename(tmp_file.c_str(), f_name.Str().c_str()) != 0)
+  {
+    Z_LOG_ERROR("Grid tile file '" + f_name.Str() + "' cannot be written!") ;
+    exit(EXIT_FAILURE) ;
+  }
+}
+
+//--------------------------------------------------------------
+bool GridTable::ImportTile(const size_t& k, const size_t& n,
+                           const Zaki::String::Directory& f_name)
+{
+  FILE* in = fopen(f_name.Str().c_str(), "rb") ;
+  if (!in) return false ;
+
+  Zaki::Math::Range<size_t> r = TileRange(k, n) ;
+  size_t n_vals = (r.max - r.min)*y_pts.size() ;
+
+  TileHeader head ;
+  bool ok = fread(&head, sizeof(head), 1, in) == 1 &&
+            memcmp(head.magic, GRID_MAGIC, sizeof(GRID_MAGIC)) == 0 &&
+            head.x_res == x_pts.size() && head.y_res == y_pts.size() &&
+            head.k == k && head.n == n &&
+            head.x_min == grid.xAxis.Min() && head.x_max == grid.xAxis.Max() &&
+            head.y_min == grid.yAxis.Min() && head.y_max == grid.yAxis.Max() &&
+            strncmp(head.x_scale, grid.xAxis.scale.c_str(), sizeof(head.x_scale)) == 0 &&
+            strncmp(head.y_scale, grid.yAxis.scale.c_str(), sizeof(head.y_scale)) == 0 &&
+            fread(&vals[r.min*y_pts.size()], sizeof(double), n_vals, in) == n_vals ;
+  fclose(in) ;
+
+  if (ok)
+  {
+    head.label[sizeof(head.label) - 1] = '\0' ;
+    label = head.label ;
+  }
+
+  if (!ok)
+  {
+    Z_LOG_ERROR("Grid tile file '" + f_name.Str() + "' doesn't match the grid!") ;
+    return false ;
+  }
+
+  std::fill(filled.begin() + r.min, filled.begin() + r.max, 1) ;
+  return true ;
+}
+
+//--------------------------------------------------------------
+void GridTable::Export(const Zaki::String::Directory& f_name) const
+{
+  ExportTile(0, 1, f_name) ;
+}
+
+//--------------------------------------------------------------
+bool GridTable::Import(const Zaki::String::Directory& f_name)
+{
+  return ImportTile(0, 1, f_name) ;
+}
+
+//--------------------------------------------------------------
+void GridTable::SetLabel(const std::string& in_label)
+{
+  label = in_label ;
+}
+
+//--------------------------------------------------------------
+std::string GridTable::GetLabel() const
+{
+  return label ;
+}
+
+//--------------------------------------------------------------
+bool GridTable::Complete() const
+{
+  return std::all_of(filled.begin(), filled.end(), [](char f) { return f ; }) ;
+}
+
+//--------------------------------------------------------------
+size_t GridTable::Locate(const std::vector<double>& pts, const double& v, double& frac)
+{
+  if (pts.size() < 2 || v <= pts.front()) { frac = 0 ; return 0 ; }
+  if (v >= pts.back()) { frac = 1 ; return pts.size() - 2 ; }
+
+  size_t i = std::upper_bound(pts.begin(), pts.end(), v) - pts.begin() - 1 ;
+  frac = (v - pts[i]) / (pts[i+1] - pts[i]) ;
+
+  return i ;
+}
+
+//--------------------------------------------------------------
+double GridTable::Eval(double x, double y) const
+{
+  double fx, fy ;
+  size_t i = Locate(x_pts, x, fx) ;
+  size_t j = Locate(y_pts, y, fy) ;
+
+  size_t ny = y_pts.size() ;
+  size_t i_1 = std::min(i + 1, x_pts.size() - 1) ;
+  size_t j_1 = std::min(j + 1, ny - 1) ;
+
+  double low  = Lerp(vals[i*ny + j], vals[i*ny + j_1], fy) ;
+  double high = Lerp(vals[i_1*ny + j], vals[i_1*ny + j_1], fy) ;
+
+  return Lerp(low, high, fx) ;
+}
+
+//==============================================================
@@ -2,6 +2,9 @@
   LikeLi_Eq class
 */
 
+#include <cmath>
+#include <limits>
+
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_multiroots.h>
@@ -9,12 +12,26 @@
 #include <Math/QuantFuncMathMore.h>
 #include <Math/Util.h>
 
-#include <Zaki/Math/GSLMultiFWrapper.hpp>
 #include <Zaki/Math/GSLMultiFdfWrapper.hpp>
 
 #include "DMSS/LikeLi_Eq.hpp"
+#include "DMSS/PoissonFitter.hpp"
+#include "DMSS/AsyncLog.hpp"
 
 // using namespace DMSS ;
+//==============================================================
+namespace
+{
+  /// No parameter is fixed
+  const size_t NO_PAR = (size_t)-1 ;
+
+  /// The logs are kept in a range where exp() is finite
+  double SafeExp(const double& x)
+  {
+    return std::exp(std::min(300.0, std::max(-300.0, x))) ;
+  }
+}
+
 //==============================================================
 
 //--------------------------------------------------------------
@@ -22,224 +39,495 @@
 LikeLi_Eq::LikeLi_Eq() {}
 
 //--------------------------------------------------------------
-/// F(x) = 0 Equation
-int LikeLi_Eq::Eq(const gsl_vector* x, gsl_vector* in_f)
+void LikeLi_Eq::AddObsCounts(const Bin& b)
 {
-  
-  const double sig_str = gsl_vector_get(x,0);
-  double val    = 0 ;
-  double sig_bg_rate  = 0 ;
+  AddObsSet(b.GetTBinObsSet()) ;
+}
 
-  for(size_t i=0 ; i<obs_set.size() ; ++i)
-    for (size_t j = 0; j < obs_set[i].size(); j++)
+//--------------------------------------------------------------
+void LikeLi_Eq::AddObsSet(const std::vector<Zaki::Math::Quantity>& in_obs_set)
+{
+  obs_set.emplace_back() ;
+  double n = 0 ;
+  for (auto&& o : in_obs_set)
   {
-
-    sig_bg_rate = sig_str*sig_shape_hist[i][ j+1 ] + gsl_vector_get(x,i+1) ;
-
-    /// safe evaluation of log(x) with a protections against negative or zero argument 
-    val += obs_set[i][j].val*ROOT::Math::Util::EvalLog(sig_bg_rate) - sig_bg_rate ;
+    obs_set.back().push_back(o.val) ;
+    n += o.val ;
   }
+  n_bin.push_back(n) ;
+  n_tot += n ;
+}
 
+//--------------------------------------------------------------
+void LikeLi_Eq::AddSigShape(const TH1F& sig_shape)
+{
+  sig_set.emplace_back() ;
+  for (int j = 1 ; j <= sig_shape.GetNbinsX() ; ++j)
+    sig_set.back().push_back(sig_shape.GetBinContent(j)) ;
+
+  width_set.push_back(Bin::RelWidths(sig_shape)) ;
+  w_bin.push_back(0) ;
+  for (double w : width_set.back())
+    w_bin.back() += w ;
+}
 
+//--------------------------------------------------------------
+void LikeLi_Eq::SetErrorDef(const double& in_def)
+{
+  theErrorDef = in_def ;
+}
 
+//--------------------------------------------------------------
+double LikeLi_Eq::ErrorDef() const
+{
+  return theErrorDef ;
+}
 
-  const double x0 = gsl_vector_get(x,0);
-  const double x1 = gsl_vector_get(x,1);
-
-  // Simple system of equations
-  // f_1(x,y) = a*x - 4
-  // f_2(x,y) = b*x + y*x
-  // const double y0 = pars.a * x0  - 4 ;
-  // const double y1 = pars.b * x0 + x1 * x0 ;
-
-  // Rosenbrock system of equations
-  // f_1(x,y) = a * (1 - x)
-  // f_2(x,y) = b * (y - x^2)
-  // const double y0 = pars.a * (1 - x0);
-  // const double y1 = pars.b * (x1 - x0 * x0);
-
-  // gsl_vector_set (in_f, 0, y0);
-  // gsl_vector_set (in_f, 1, y1);
+//--------------------------------------------------------------
+void LikeLi_Eq::SetMaxIter(const size_t& in_max)
+{
+  max_iter = in_max ;
+}
 
-  return GSL_SUCCESS ;
+//--------------------------------------------------------------
+void LikeLi_Eq::SetVerbose(const bool in_flag)
+{
+  verbose = in_flag ;
 }
 
 //--------------------------------------------------------------
-/// F(x) = 0 Equation Solver
-int LikeLi_Eq::SolveEq()
+// Returns  -2Ln(likelihood), as 'LogLikeli::Q'
+double LikeLi_Eq::operator()(const std::vector<double>& par) const
 {
-  const gsl_multiroot_fsolver_type *T = gsl_multiroot_fsolver_hybrid ;
-  gsl_multiroot_fsolver *s = gsl_multiroot_fsolver_alloc (T, 2) ;
+  double val = 0 ;
+  for (size_t i = 0 ; i < obs_set.size() ; ++i)
+    for (size_t j = 0 ; j < obs_set[i].size() ; ++j)
+    {
+      double r = par[0]*sig_set[i][j] + par[i+1]*width_set[i][j] ;
 
-  printf ("Using '%s' solver...\n", gsl_multiroot_fsolver_name(s));
+      /// safe evaluation of log(x) with a protections against negative or zero argument
+      val += obs_set[i][j]*ROOT::Math::Util::EvalLog(r) - r ;
+    }
 
+  return -2*val ;
+}
 
-  Zaki::Math::GSLMultiFWrapper<LikeLi_Eq, 
-    int (LikeLi_Eq::*)(const gsl_vector*, gsl_vector*)> 
-  func(this, &LikeLi_Eq::Eq, 2) ;
+//--------------------------------------------------------------
+bool LikeLi_Eq::IsValid() const
+{
+  return valid ;
+}
 
-  gsl_multiroot_function F = static_cast<gsl_multiroot_function> (func) ; 
+//--------------------------------------------------------------
+const std::vector<double>& LikeLi_Eq::Params() const
+{
+  return min_par ;
+}
 
-  // gsl_set_error_handler_off() ;
-  gsl_vector *r_guess = gsl_vector_alloc (2);
+//--------------------------------------------------------------
+double LikeLi_Eq::Fval() const
+{
+  return min_val ;
+}
 
-  gsl_vector_set (r_guess, 0, root_guess[0]);
-  gsl_vector_set (r_guess, 1, root_guess[1]);
+//--------------------------------------------------------------
+size_t LikeLi_Eq::NIter() const
+{
+  return n_iter ;
+}
 
-  gsl_multiroot_fsolver_set (s, &F, r_guess);
+//--------------------------------------------------------------
+double LikeLi_Eq::Residual() const
+{
+  return residual ;
+}
 
-  int status;
-  int iter = 0, max_iter = 1000;
-  // gsl_vector* r ;
-  do
-  {
-    iter++;
-    status = gsl_multiroot_fsolver_iterate (s);
+//--------------------------------------------------------------
+int LikeLi_Eq::Status() const
+{
+  return status ;
+}
 
-    PrintState(iter, s);
-    
-    if (status)   /* check if solver is stuck */
-        break;
+//--------------------------------------------------------------
+// With r = mu*s + bg*w:  d LogL = sum (n/r - 1) (s, w),
+//  and the Hessian is  -sum n/r^2 (s^2, s*w, w^2)
+bool LikeLi_Eq::Score(const std::vector<double>& par, std::vector<double>& grad,
+                      double& h_mm, std::vector<double>& h_mb,
+                      std::vector<double>& h_bb) const
+{
+  grad.assign(obs_set.size() + 1, 0) ;
+  h_mb.assign(obs_set.size(), 0) ;
+  h_bb.assign(obs_set.size(), 0) ;
+  h_mm = 0 ;
 
-    status = gsl_multiroot_test_residual (s->f, 1e-7) ;
-  }
-  while (status == GSL_CONTINUE && iter < max_iter);
+  for (size_t i = 0 ; i < obs_set.size() ; ++i)
+    for (size_t j = 0 ; j < obs_set[i].size() ; ++j)
+    {
+      double n = obs_set[i][j], s = sig_set[i][j], w = width_set[i][j] ;
+      double r = par[0]*s + par[i+1]*w ;
+
+      if (r <= 0)
+      {
+        if (n > 0) return false ;
+        grad[0]   -= s ;
+        grad[i+1] -= w ;
+        continue ;
+      }
+
+      double a = n/r, c = a/r ;
+      grad[0]   += s*(a - 1) ;
+      grad[i+1] += w*(a - 1) ;
+      h_mm      -= c*s*s ;
+      h_mb[i]   -= c*s*w ;
+      h_bb[i]   -= c*w*w ;
+    }
 
-  gsl_multiroot_fsolver_free (s);
-  gsl_vector_free(r_guess) ;
-  
-  return status ;
+  return true ;
 }
+
 //--------------------------------------------------------------
-// Prints the status
-void LikeLi_Eq::PrintState(const size_t& iter, gsl_multiroot_fsolver * s)
+void LikeLi_Eq::SetWork(const gsl_vector* x)
 {
-  printf ("iter = %3zu x = % .3f % .3f "
-          "f(x) = % .3e % .3e\n",
-          iter,
-          gsl_vector_get (s->x, 0),
-          gsl_vector_get (s->x, 1),
-          gsl_vector_get (s->f, 0),
-          gsl_vector_get (s->f, 1));
+  for (size_t k = 0 ; k < free_idx.size() ; ++k)
+    work[free_idx[k]] = SafeExp(gsl_vector_get(x, k)) ;
 }
+
 //--------------------------------------------------------------
-// Prints the status
-void LikeLi_Eq::PrintState(const size_t& iter, gsl_multiroot_fdfsolver * s)
+/// F(x) = 0 Equation: with p = exp(x),  F_k = p_k dLogL/dp_k
+int LikeLi_Eq::Eq(const gsl_vector* x, gsl_vector* in_f)
 {
-  printf ("iter = %3zu x = % .3f % .3f "
-          "f(x) = % .3e % .3e\n",
-          iter,
-          gsl_vector_get (s->x, 0),
-          gsl_vector_get (s->x, 1),
-          gsl_vector_get (s->f, 0),
-          gsl_vector_get (s->f, 1));
+  SetWork(x) ;
+
+  std::vector<double> grad, h_mb, h_bb ;
+  double h_mm ;
+  Score(work, grad, h_mm, h_mb, h_bb) ;
+
+  for (size_t k = 0 ; k < free_idx.size() ; ++k)
+    gsl_vector_set(in_f, k, work[free_idx[k]]*grad[free_idx[k]]) ;
+
+  return GSL_SUCCESS ;
 }
+
 //--------------------------------------------------------------
-/// Jacobian
+/// Jacobian:  dF_k/dx_l = p_k H_kl p_l + delta_kl F_k
 int LikeLi_Eq::Jacob(const gsl_vector* x, gsl_matrix* J)
 {
-  const double x0 = gsl_vector_get(x,0);
-  const double x1 = gsl_vector_get(x,1);
-
-  // gsl_matrix_set (J, 0, 0, pars.a );
-  gsl_matrix_set (J, 0, 1, 0      );
-  // gsl_matrix_set (J, 1, 0, pars.b + x1 );
-  gsl_matrix_set (J, 1, 1, x0     );
+  gsl_vector* f = gsl_vector_alloc(free_idx.size()) ;
+  EqFdf(x, f, J) ;
+  gsl_vector_free(f) ;
 
-  return 0 ;
+  return GSL_SUCCESS ;
 }
+
 //--------------------------------------------------------------
 /// { F(x), F'(x) }
-int LikeLi_Eq::EqFdf(const gsl_vector* x, gsl_vector* f, gsl_matrix* J) 
+int LikeLi_Eq::EqFdf(const gsl_vector* x, gsl_vector* f, gsl_matrix* J)
 {
+  SetWork(x) ;
 
-  const double x0 = gsl_vector_get(x,0);
-  const double x1 = gsl_vector_get(x,1);
+  std::vector<double> grad, h_mb, h_bb ;
+  double h_mm ;
+  Score(work, grad, h_mm, h_mb, h_bb) ;
+
+  gsl_matrix_set_zero(J) ;
+  for (size_t k = 0 ; k < free_idx.size() ; ++k)
+  {
+    size_t a = free_idx[k] ;
+    double p_a = work[a] ;
 
-  // const double y0 = pars.a * x0  - 4 ;
-  // const double y1 = pars.b * x0 + x1 * x0 ;
+    gsl_vector_set(f, k, p_a*grad[a]) ;
 
-  // gsl_vector_set (f, 0, y0);
-  // gsl_vector_set (f, 1, y1);
+    for (size_t l = 0 ; l < free_idx.size() ; ++l)
+    {
+      size_t b = free_idx[l] ;
+
+      // The Hessian is arrow-shaped: mu mixes with all, a bg only with mu
+      double h = 0 ;
+      if (a == 0 && b == 0)
+        h = h_mm ;
+      else if (a == 0 || b == 0)
+        h = h_mb[a + b - 1] ;
+      else if (a == b)
+        h = h_bb[a - 1] ;
+
+      gsl_matrix_set(J, k, l, p_a*h*work[b] + (k == l ? p_a*grad[a] : 0)) ;
+    }
+  }
 
-  // gsl_matrix_set (J, 0, 0, pars.a );
-  gsl_matrix_set (J, 0, 1, 0      );
-  // gsl_matrix_set (J, 1, 0, pars.b + x1 );
-  gsl_matrix_set (J, 1, 1, x0     );
+  return GSL_SUCCESS ;
+}
 
-  return 0 ;
+//--------------------------------------------------------------
+// Prints the status
+void LikeLi_Eq::PrintState(const size_t& iter, gsl_multiroot_fdfsolver * s)
+{
+  double f_max = 0 ;
+  for (size_t k = 0 ; k < s->f->size ; ++k)
+    f_max = std::max(f_max, std::abs(gsl_vector_get(s->f, k))) ;
+
+  char tmp[150] ;
+  sprintf(tmp, "iter = %3zu  ln(x_0) = % .6e  max|f(x)| = %.3e",
+          iter, gsl_vector_get(s->x, 0), f_max) ;
+  DMSS_LOG_INFO(tmp) ;
 }
 
 //--------------------------------------------------------------
-int LikeLi_Eq::SolveEqJacob()
+bool LikeLi_Eq::Solve()
 {
-  const gsl_multiroot_fdfsolver_type * T = gsl_multiroot_fdfsolver_gnewton;
-  gsl_multiroot_fdfsolver * s = gsl_multiroot_fdfsolver_alloc (T, 2);
+  const size_t n = free_idx.size() ;
+  if (n == 0) return true ;
 
-  printf ("Using '%s' solver...\n", gsl_multiroot_fdfsolver_name(s));
+  // The scale of the equations is the counts
+  const double tol = 1e-10*std::max(1.0, n_tot) ;
 
-  Zaki::Math::GSLMultiFdfWrapper<LikeLi_Eq, 
-    int (LikeLi_Eq::*)(const gsl_vector*, gsl_vector*), 
+  const gsl_multiroot_fdfsolver_type * T = gsl_multiroot_fdfsolver_hybridsj ;
+  gsl_multiroot_fdfsolver * s = gsl_multiroot_fdfsolver_alloc (T, n);
+
+  Zaki::Math::GSLMultiFdfWrapper<LikeLi_Eq,
+    int (LikeLi_Eq::*)(const gsl_vector*, gsl_vector*),
     int (LikeLi_Eq::*)(const gsl_vector*, gsl_matrix*),
     int (LikeLi_Eq::*)(const gsl_vector*, gsl_vector*, gsl_matrix*)
-    > 
-
-  fdf(this, &LikeLi_Eq::Eq, &LikeLi_Eq::Jacob, 
-      &LikeLi_Eq::EqFdf, 2) ;
+    >
 
-  gsl_multiroot_function_fdf Fdf = static_cast<gsl_multiroot_function_fdf> (fdf) ; 
+  fdf(this, &LikeLi_Eq::Eq, &LikeLi_Eq::Jacob,
+      &LikeLi_Eq::EqFdf, n) ;
 
-  gsl_vector *r_guess = gsl_vector_alloc (2);
+  gsl_multiroot_function_fdf Fdf = static_cast<gsl_multiroot_function_fdf> (fdf) ;
 
-  gsl_vector_set (r_guess, 0, root_guess[0]);
-  gsl_vector_set (r_guess, 1, root_guess[1]);
+  gsl_vector *r_guess = gsl_vector_alloc (n);
+  for (size_t k = 0 ; k < n ; ++k)
+    gsl_vector_set (r_guess, k, std::log(work[free_idx[k]]));
 
   gsl_multiroot_fdfsolver_set(s, &Fdf, r_guess) ;
 
   // Iterations begin
-  int status ;
-  int iter = 0, max_iter = 1000;
-  do
+  size_t iter = 0 ;
+  status = gsl_multiroot_test_residual (s->f, tol) ;
+  while ( status == GSL_CONTINUE && iter < max_iter )
   {
     iter++ ;
     status = gsl_multiroot_fdfsolver_iterate(s) ;
 
-    // ................................................
-    // Error handling
-    if (status == GSL_EBADFUNC)
+    if (verbose)
+      PrintState(iter, s);
+
+    // No progress (e.g. at the root, up to the rounding)
+    if (status)
+      break;
+
+    status = gsl_multiroot_test_residual (s->f, tol);
+  }
+
+  SetWork(s->x) ;
+  residual = 0 ;
+  for (size_t k = 0 ; k < n ; ++k)
+    residual = std::max(residual, std::abs(gsl_vector_get(s->f, k))) ;
+  n_iter += iter ;
+
+  gsl_multiroot_fdfsolver_free(s) ;
+  gsl_vector_free(r_guess) ;
+
+  if (status != GSL_SUCCESS && residual > 1e4*tol)
+    return false ;
+
+  // p*dLogL/dp also vanishes as p -> 0, which is only the minimum
+  //  (at the limit) if LogL decreases with p there: the scores
+  //  are compared to their positive parts
+  std::vector<double> grad, pos(obs_set.size() + 1, 0) ;
+  for (size_t i = 0 ; i < obs_set.size() ; ++i)
+    for (size_t j = 0 ; j < obs_set[i].size() ; ++j)
     {
-      std::cout <<  "Error: The iteration encountered a singular" 
-                    " point where the function or its derivative"
-                    " evaluated to Inf or NaN.\n" ;
-    } else if (status == GSL_EZERODIV)
+      if (obs_set[i][j] == 0) continue ;
+
+      double a = obs_set[i][j] / (work[0]*sig_set[i][j] + work[i+1]*width_set[i][j]) ;
+      pos[0]   += sig_set[i][j]*a ;
+      pos[i+1] += width_set[i][j]*a ;
+    }
+
+  std::vector<double> h_mb, h_bb ;
+  double h_mm ;
+  Score(work, grad, h_mm, h_mb, h_bb) ;
+  for (const size_t a : free_idx)
+    if (grad[a] > 1e-6*pos[a])
+      return false ;
+
+  return true ;
+}
+
+//--------------------------------------------------------------
+bool LikeLi_Eq::Profile(std::vector<double>& par, const size_t& fixed)
+{
+  std::vector<double> grad, h_mb, h_bb ;
+  double h_mm ;
+
+  // A bin without counts has no background
+  for (size_t i = 0 ; i < obs_set.size() ; ++i)
+    if (i + 1 != fixed && n_bin[i] == 0)
+      par[i+1] = 0 ;
+
+  // At mu = 0 the backgrounds are the mean counts (per unit of
+  //  the relative width), and that's
+  //  the minimum if -2LogL increases with mu
+  std::vector<double> lim = par ;
+  lim[0] = 0 ;
+  for (size_t i = 0 ; i < obs_set.size() ; ++i)
+    if (i + 1 != fixed)
+      lim[i+1] = n_bin[i] / w_bin[i] ;
+
+  bool lim_ok = fixed != 0 && Score(lim, grad, h_mm, h_mb, h_bb) ;
+  if (lim_ok && grad[0] <= 0)
+  {
+    par = lim ;
+    return true ;
+  }
+
+  // The cold start: the Newton step from mu = 0 (profiled over
+  //  the bg's), and the mean counts
+  std::vector<double> cold = lim ;
+  if (fixed != 0)
+  {
+    double h = h_mm ;
+    for (size_t i = 0 ; lim_ok && i < obs_set.size() ; ++i)
+      if (h_bb[i] < 0 && i + 1 != fixed)
+        h -= h_mb[i]*h_mb[i] / h_bb[i] ;
+    cold[0] = (lim_ok && h < 0) ? -grad[0] / h : 1 ;
+  }
+  else
+    cold[0] = par[0] ;
+
+  free_idx.clear() ;
+  if (fixed != 0)
+    free_idx.push_back(0) ;
+  for (size_t i = 0 ; i < obs_set.size() ; ++i)
+    if (i + 1 != fixed && n_bin[i] > 0)
+      free_idx.push_back(i+1) ;
+
+  // From 'par' (the parameters near a limit start cold, as
+  //  their logs would be far from the root), and then cold
+  for (size_t attempt = 0 ; attempt < 2 ; ++attempt)
+  {
+    work = par ;
+    for (const size_t a : free_idx)
+      if (attempt == 1 || !(work[a] > 1e-6*cold[a]))
+        work[a] = cold[a] ;
+
+    // A non-zero count without a rate (at a fixed limit)
+    if (!Score(work, grad, h_mm, h_mb, h_bb))
+      return false ;
+
+    if (Solve())
     {
-      std::cout <<  "Error: The derivative of the function vanished"
-                    " at the iteration point, preventing the algorithm"
-                    " from continuing without a division by zero.\n" ;
+      par = work ;
+      return true ;
     }
-    // ................................................
+  }
 
-    PrintState(iter, s);
+  return false ;
+}
 
-    if (status)
-      break;
+//--------------------------------------------------------------
+bool LikeLi_Eq::Minimize()
+{
+  valid    = false ;
+  n_iter   = 0 ;
+  residual = 0 ;
+  min_par.assign(obs_set.size() + 1, 0) ;
 
-    status = gsl_multiroot_test_residual (s->f, 1e-7);
+  if (obs_set.empty() || obs_set.size() != sig_set.size() || n_tot <= 0)
+    return false ;
+  for (size_t i = 0 ; i < obs_set.size() ; ++i)
+    if (sig_set[i].size() < obs_set[i].size() || width_set[i].size() < obs_set[i].size())
+      return false ;
 
-  } 
-  while ( status == GSL_CONTINUE && iter < max_iter );
-  
+  if (!Profile(min_par, NO_PAR))
+    return false ;
 
+  min_val = (*this)(min_par) ;
+  valid   = std::isfinite(min_val) ;
 
-  gsl_multiroot_fdfsolver_free(s) ;
-  gsl_vector_free(r_guess) ;
+  return valid ;
+}
 
-  return status ;
+//--------------------------------------------------------------
+// The roots of the profile around the minimum: the crossing is
+//  bracketed from the quadratic estimate of its distance, and
+//  d(-2LogL)/dx_i at the profiled point is the profile's slope
+MinosResult LikeLi_Eq::Minos(const size_t& i)
+{
+  if (!valid || i >= min_par.size())
+    return MinosResult() ;
+
+  const size_t iter_0 = n_iter ;
+  const double x0 = min_par[i] ;
+
+  std::vector<double> grad, h_mb, h_bb ;
+  double h_mm ;
+  Score(min_par, grad, h_mm, h_mb, h_bb) ;
+
+  // The diagonal of the inverse of -H (arrow-shaped: the Schur
+  //  complement of the bg block)
+  double schur = -h_mm ;
+  for (size_t k = 0 ; k < h_bb.size() ; ++k)
+    if (h_bb[k] < 0)
+      schur += h_mb[k]*h_mb[k] / h_bb[k] ;
+
+  double var = 0 ;
+  if (i == 0)
+    var = 1 / schur ;
+  else if (h_bb[i-1] < 0)
+    var = -1/h_bb[i-1] + std::pow(h_mb[i-1]/h_bb[i-1], 2) / schur ;
+
+  double step = (var > 0 && std::isfinite(var)) ? std::sqrt(theErrorDef*var)
+                                                : std::max(1.0, x0) ;
+
+  // The rise of the profile above the minimum
+  bool failed = false ;
+  std::vector<double> par = min_par ;
+  auto delta = [&](double x, double& df)
+  {
+    par[i] = x ;
+    std::vector<double> g, m_b, b_b ;
+    double m_m ;
+    if (!Profile(par, i) || !Score(par, g, m_m, m_b, b_b))
+    {
+      failed = true ;
+      df = 0 ;
+      return std::numeric_limits<double>::infinity() ;
+    }
+    df = -2*g[i] ;
+    return (*this)(par) - min_val - theErrorDef ;
+  } ;
+
+  // Upper crossing
+  double tmp ;
+  double lo = x0, hi = x0 + step ;
+  size_t it = 0 ;
+  for ( ; it < 100 && delta(hi, tmp) < 0 ; ++it)
+  {
+    lo    = hi ;
+    step *= 2 ;
+    hi    = x0 + step ;
+  }
+  double upper = PoissonFitter::Solve(delta, lo, hi, hi) - x0 ;
+  bool ok = !failed && it < 100 ;
+
+  // Lower crossing (at the limit, if the profile doesn't rise
+  //  enough before it, or has no rate there)
+  double lower = -x0 ;
+  par = min_par ;
+  if (x0 > 0)
+  {
+    double d_0 = delta(0, tmp) ;
+    failed = false ;
+    if (d_0 > 0)
+    {
+      auto neg = [&](double x, double& df) { double v = -delta(x, df) ; df = -df ; return v ; } ;
+      lower = PoissonFitter::Solve(neg, 0, x0, std::max(0.5*x0, x0 - 0.5*step)) - x0 ;
+      ok = ok && !failed ;
+    }
+  }
+
+  return MinosResult(x0, lower, upper, ok, n_iter - iter_0) ;
 }
-// --------------------------------------------------------------
-// void LikeLi_Eq::SetParams(const Params& in_pars)
-// {
-//   pars = in_pars ;
-// }
 
 //==============================================================
@@ -1,4 +1,8 @@
 #include <cassert>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
 
 // Root
 #include <TF1.h>
@@ -52,10 +56,23 @@ void ROOT::Minuit2::LogLikeli::AddObsSet
   fix_bg = in_obs_set[0].val ;
 }
 
+//--------------------------------------------------------------
+void ROOT::Minuit2::LogLikeli::SetObsSet
+(const std::vector<Zaki::Math::Quantity>& in_obs_set) 
+{
+  if (obs_set.empty())
+    obs_set.push_back(in_obs_set) ;
+  else
+    obs_set[0] = in_obs_set ;
+  fix_bg = in_obs_set[0].val ;
+}
+
 //--------------------------------------------------------------
 void ROOT::Minuit2::LogLikeli::AddSigShape(const TH1F& sig_shape) 
 {
-  sig_shape_hist.push_back(sig_shape) ;
+  sig_shape_hist.emplace_back(std::make_unique<TH1F>(sig_shape)) ;
+  sig_shape_hist.back()->SetDirectory(nullptr) ;
+  bg_shape.push_back(Bin::RelWidths(sig_shape)) ;
 }
 
 //--------------------------------------------------------------
@@ -76,7 +93,7 @@ double ROOT::Minuit2::LogLikeli::Q(double sig_str, const std::vector<double>& bg
     for (size_t j = 0; j < obs_set[i].size(); j++)
   {
 
-    sig_bg_rate = sig_str*sig_shape_hist[i][ j+1 ] + bg_val[i] ;
+    sig_bg_rate = sig_str*(*sig_shape_hist[i])[ j+1 ] + bg_val[i]*bg_shape[i][j] ;
 
     // sigbg_hybrid_pdf.SetPars({sig_bg_rate, obs_set[i][j].val, obs_set[i][j].err}) ;
     // bg_hybrid_pdf.SetPars({bg_val[i], obs_set[i][j].val, obs_set[i][j].err}) ;
@@ -106,13 +123,184 @@ double ROOT::Minuit2::LogLikeli::Q(double sig_str, const std::vector<double>& bg
   return -2*val ;
 }
 
+//--------------------------------------------------------------
+double ROOT::Minuit2::LogLikeli::ChiSqQuantile(const double& cl, const int& ndf)
+{
+  static std::mutex mtx ;
+  static std::map<std::pair<double, int>, double> cache ;
+
+  std::lock_guard<std::mutex> lock(mtx) ;
+  auto it = cache.find({cl, ndf}) ;
+  if (it != cache.end())
+    return it->second ;
+
+  return cache[{cl, ndf}] = ROOT::MathMore::chisquared_quantile(cl, ndf) ;
+}
+
+//--------------------------------------------------------------
+// The rates are linear in bg, so -2LogL is convex in it, and
+//  its derivative  sum_j n_j w_j / (mu s_j + bg w_j) - W  is
+//  decreasing, with the root between  N/W - mu*max(s/w)  and  N/W.
+double ROOT::Minuit2::LogLikeli::ProfileBg(const size_t& i, const double& mu, 
+                                           const double& bg) const
+{
+  const std::vector<Zaki::Math::Quantity>& obs = obs_set[i] ;
+  const TH1F& sig = *sig_shape_hist[i] ;
+  const std::vector<double>& w = bg_shape[i] ;
+
+  double n_tot = 0, w_tot = 0, s_max = 0 ;
+  for (size_t j = 0; j < obs.size(); j++)
+  {
+    n_tot += obs[j].val ;
+    w_tot += w[j] ;
+    s_max  = std::max(s_max, mu*sig[j+1] / w[j]) ;
+  }
+
+  double hi = n_tot / w_tot ;
+  double lo = std::max(0.0, hi - s_max) ;
+  if (hi <= 0) return 0 ;
+
+  double b = (bg > lo && bg < hi) ? bg : 0.5*(lo + hi) ;
+  for (size_t it = 0; it < 100; it++)
+  {
+    double g = -w_tot, dg = 0 ;
+    for (size_t j = 0; j < obs.size(); j++)
+    {
+      double r = std::max(mu*sig[j+1] + b*w[j], 1e-300) ;
+      g  += obs[j].val*w[j] / r ;
+      dg -= obs[j].val*w[j]*w[j] / (r*r) ;
+    }
+
+    if (g > 0) lo = b ; else hi = b ;
+    if (std::abs(g) <= 1e-12*w_tot || hi - lo <= 1e-14*hi) break ;
+
+    double next = dg < 0 ? b - g/dg : 0.5*(lo + hi) ;
+    b = (next > lo && next < hi) ? next : 0.5*(lo + hi) ;
+  }
+
+  return b ;
+}
+
+//--------------------------------------------------------------
+// With r = mu*s + bg*w:  dQ/dmu = -2 sum (n s / r - s), and the 
+//  second derivative of the profile is  Q_mm - Q_mb^2 / Q_bb
+double ROOT::Minuit2::LogLikeli::Profile(const double& mu, std::vector<double>& bg, 
+                                         double& d1, double& d2) const
+{
+  double val = 0 ;
+  d1 = 0 ; d2 = 0 ;
+
+  for(size_t i=0 ; i<obs_set.size() ; ++i)
+  {
+    bg[i] = ProfileBg(i, mu, bg[i]) ;
+
+    double q_mm = 0, q_mb = 0, q_bb = 0 ;
+    for (size_t j = 0; j < obs_set[i].size(); j++)
+    {
+      double s = (*sig_shape_hist[i])[ j+1 ] ;
+      double w = bg_shape[i][j] ;
+      double n = obs_set[i][j].val ;
+      double r = std::max(mu*s + bg[i]*w, 1e-300) ;
+
+      val  += n*ROOT::Math::Util::EvalLog(r) - r ;
+      d1   += n*s/r - s ;
+      q_mm += n*s*s/(r*r) ;
+      q_mb += n*s*w/(r*r) ;
+      q_bb += n*w*w/(r*r) ;
+    }
+
+    // A background at its boundary (0) isn't profiled
+    d2 += (bg[i] > 0 && q_bb > 0) ? q_mm - q_mb*q_mb/q_bb : q_mm ;
+  }
+
+  d1 *= -2 ;
+  d2 *=  2 ;
+  return -2*val ;
+}
+
+//--------------------------------------------------------------
+// The profile is convex in mu, so both the minimum and the
+//  limit are the roots of increasing functions: each Newton
+//  step stays inside the bracket, or it's replaced by bisection.
+double ROOT::Minuit2::LogLikeli::UpperLimit(const double& q) const
+{
+  if (obs_set.empty())
+  {
+    DMSS_LOG_ERROR("No observed counts to find the limit from!") ;
+    return 0 ;
+  }
+
+  std::vector<double> bg(obs_set.size(), -1) ;
+  double d1, d2 ;
+
+  auto Solve = [](const std::function<double(double, double&)>& f, 
+                  double lo, double hi, double x)
+  {
+    for (size_t it = 0; it < 100; it++)
+    {
+      double df ;
+      double fx = f(x, df) ;
+      if (fx < 0) lo = x ; else hi = x ;
+      if (std::abs(fx) < 1e-10 || hi - lo <= 1e-12*hi) break ;
+
+      double next = df > 0 ? x - fx/df : 0.5*(lo + hi) ;
+      x = (next > lo && next < hi) ? next : 0.5*(lo + hi) ;
+    }
+    return x ;
+  } ;
+
+  // ............ Minimum (mu >= 0) ............
+  double mu_hat = 0 ;
+  double q_min  = Profile(0, bg, d1, d2) ;
+  if (d1 < 0)
+  {
+    auto slope = [&](double mu, double& df) 
+    { 
+      double d_1 ;
+      Profile(mu, bg, d_1, df) ;
+      return d_1 ;
+    } ;
+
+    double hi = d2 > 0 ? -2*d1/d2 : 1 ;
+    double tmp ;
+    for (size_t it = 0; it < 200 && slope(hi, tmp) < 0; it++)
+      hi *= 2 ;
+
+    mu_hat = Solve(slope, 0, hi, 0.5*hi) ;
+    q_min  = Profile(mu_hat, bg, d1, d2) ;
+  }
+  // ...........................................
+
+  // ............ Limit (above the minimum) ............
+  auto delta = [&](double mu, double& df) 
+  { 
+    double d_2 ;
+    return Profile(mu, bg, df, d_2) - q_min - q ;
+  } ;
+
+  // Quadratic estimate of the distance, doubled until it's passed
+  double lo   = mu_hat ;
+  double step = d2 > 0 ? sqrt(2*q/d2) : 1 ;
+  double hi   = mu_hat + step ;
+  double tmp ;
+  for (size_t it = 0; it < 200 && delta(hi, tmp) < 0; it++)
+  {
+    lo    = hi ;
+    step *= 2 ;
+    hi    = mu_hat + step ;
+  }
+
+  return Solve(delta, lo, hi, hi) ;
+  // ...................................................
+}
+
 //--------------------------------------------------------------
 /// -2LogL = 5.99146 Equation
 double ROOT::Minuit2::LogLikeli::MuEquation(double x)
 {
   return this->operator()({x, var_bg}) 
           - this->operator()({1e-7, fix_bg}) 
-          - ROOT::MathMore::chisquared_quantile(0.95, 2) ;
+          - ChiSqQuantile(0.95, 2) ;
 }
 
 //--------------------------------------------------------------
@@ -126,11 +314,11 @@ double ROOT::Minuit2::LogLikeli::MuEquationDer(double x)
     for (size_t j = 0; j < obs_set[i].size(); j++)
   {
 
-    tmp = sig_shape_hist[i][ j+1 ] / (x * sig_shape_hist[i][ j+1 ] + var_bg) ;
-    // tmp = sig_shape_hist[i][ j+1 ] / (x * sig_shape_hist[i][ j+1 ] + bg_val[i]) ;
+    tmp = (*sig_shape_hist[i])[ j+1 ] / (x * (*sig_shape_hist[i])[ j+1 ] + var_bg) ;
+    // tmp = (*sig_shape_hist[i])[ j+1 ] / (x * (*sig_shape_hist[i])[ j+1 ] + bg_val[i]) ;
 
     /// safe evaluation of log(x) with a protections against negative or zero argument 
-    val += obs_set[i][j].val * tmp -  sig_shape_hist[i][ j+1 ] ;
+    val += obs_set[i][j].val * tmp -  (*sig_shape_hist[i])[ j+1 ] ;
   }
 
   return -2*val ;
@@ -141,7 +329,7 @@ void ROOT::Minuit2::LogLikeli::MuEquationFdf(double x, double* in_f, double* in_
 {
   *in_f   = this->operator()({x, var_bg}) 
           - this->operator()({1e-7, fix_bg}) 
-          - ROOT::MathMore::chisquared_quantile(0.95, 2) ;
+          - ChiSqQuantile(0.95, 2) ;
 
 
   
@@ -152,11 +340,11 @@ void ROOT::Minuit2::LogLikeli::MuEquationFdf(double x, double* in_f, double* in_
     for (size_t j = 0; j < obs_set[i].size(); j++)
   {
 
-    tmp = sig_shape_hist[i][ j+1 ] / (x * sig_shape_hist[i][ j+1 ] + var_bg) ;
-    // tmp = sig_shape_hist[i][ j+1 ] / (x * sig_shape_hist[i][ j+1 ] + bg_val[i]) ;
+    tmp = (*sig_shape_hist[i])[ j+1 ] / (x * (*sig_shape_hist[i])[ j+1 ] + var_bg) ;
+    // tmp = (*sig_shape_hist[i])[ j+1 ] / (x * (*sig_shape_hist[i])[ j+1 ] + bg_val[i]) ;
 
     /// safe evaluation of log(x) with a protections against negative or zero argument 
-    val += obs_set[i][j].val * tmp -  sig_shape_hist[i][ j+1 ] ;
+    val += obs_set[i][j].val * tmp -  (*sig_shape_hist[i])[ j+1 ] ;
   }        
 
   *in_df  = -2*val ;
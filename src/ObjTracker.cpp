@@ -0,0 +1,187 @@
+/*
+  ObjTracker class
+
+*/
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <Zaki/Util/Logger.hpp>
+
+// Local headers
+#include "DMSS/ObjTracker.hpp"
+
+//==============================================================
+namespace
+{
+  struct Shard
+  {
+    std::mutex mtx ;
+    std::unordered_map<const void*, unsigned> live ;
+  };
+
+  // Intentionally leaked, so they outlive static destructors
+  Shard* shards = new Shard[ObjTracker::NumShards] ;
+
+  std::shared_mutex* names_mtx = new std::shared_mutex ;
+  std::vector<std::string>* names = new std::vector<std::string> ;
+  std::unordered_map<std::string, unsigned>* name_ids
+    = new std::unordered_map<std::string, unsigned> ;
+
+  std::atomic<size_t> unmatched_dtr = 0 ;
+  std::string*        report_file   = new std::string ;
+  std::once_flag      report_at_exit ;
+
+  //............................................
+  Shard& ShardOf(const void* p)
+  {
+    // Dropping the alignment bits before hashing
+    size_t h = reinterpret_cast<size_t>(p) >> 4 ;
+    h ^= h >> 7 ;
+    return shards[h & (ObjTracker::NumShards - 1)] ;
+  }
+}
+
+//==============================================================
+unsigned ObjTracker::NameId(const std::string& in_name)
+{
+  // Most threads create the same few classes over and over
+  thread_local const std::string* last_name = nullptr ;
+  thread_local unsigned last_id = 0 ;
+  if (last_name && *last_name == in_name)
+    return last_id ;
+
+  {
+    std::shared_lock<std::shared_mutex> lock(*names_mtx) ;
+    auto it = name_ids->find(in_name) ;
+    if (it != name_ids->end())
+    {
+      last_name = &it->first ;
+      last_id   = it->second ;
+      return last_id ;
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock(*names_mtx) ;
+  auto res = name_ids->emplace(in_name, static_cast<unsigned>(names->size())) ;
+  if (res.second)
+    names->push_back(in_name) ;
+
+  last_name = &res.first->first ;
+  last_id   = res.first->second ;
+  return last_id ;
+}
+
+//--------------------------------------------------------------
+void ObjTracker::Construct(const void* obj, const std::string& in_name)
+{
+  std::call_once(report_at_exit, [](){ std::atexit(ObjTracker::Report) ; }) ;
+
+  unsigned id = NameId(in_name) ;
+
+  Shard& s = ShardOf(obj) ;
+  std::lock_guard<std::mutex> lock(s.mtx) ;
+  s.live[obj] = id ;
+}
+
+//--------------------------------------------------------------
+void ObjTracker::Destruct(const void* obj)
+{
+  Shard& s = ShardOf(obj) ;
+  std::lock_guard<std::mutex> lock(s.mtx) ;
+  if (s.live.erase(obj) == 0)
+    ++unmatched_dtr ;
+}
+
+//--------------------------------------------------------------
+void ObjTracker::SetFile(const Zaki::String::Directory& f_name)
+{
+  std::unique_lock<std::shared_mutex> lock(*names_mtx) ;
+  *report_file = f_name.Str() ;
+}
+
+//--------------------------------------------------------------
+size_t ObjTracker::LiveCount()
+{
+  size_t n = 0 ;
+  for (size_t i = 0 ; i < NumShards ; ++i)
+  {
+    std::lock_guard<std::mutex> lock(shards[i].mtx) ;
+    n += shards[i].live.size() ;
+  }
+  return n ;
+}
+
+//--------------------------------------------------------------
+void ObjTracker::Report()
+{
+  std::vector<size_t> per_name ;
+  for (size_t i = 0 ; i < NumShards ; ++i)
+  {
+    std::lock_guard<std::mutex> lock(shards[i].mtx) ;
+    for (auto&& e : shards[i].live)
+    {
+      if (e.second >= per_name.size())
+        per_name.resize(e.second + 1, 0) ;
+      ++per_name[e.second] ;
+    }
+  }
+
+  // Sorting by name for a stable report
+  std::map<std::string, size_t> sorted ;
+  {
+    std::shared_lock<std::shared_mutex> lock(*names_mtx) ;
+    for (size_t id = 0 ; id < per_name.size() ; ++id)
+      if (per_name[id])
+        sorted[(*names)[id]] = per_name[id] ;
+  }
+
+  std::vector<std::string> lines ;
+  for (auto&& e : sorted)
+  {
+    char tmp[200] ;
+    sprintf(tmp, "Object tracker: %zu live '%s' object(s).",
+            e.second, e.first.c_str()) ;
+    lines.emplace_back(tmp) ;
+  }
+
+  if (unmatched_dtr)
+  {
+    char tmp[150] ;
+    sprintf(tmp, "Object tracker: %zu destruction(s) without a matching construction.",
+            unmatched_dtr.load()) ;
+    lines.emplace_back(tmp) ;
+  }
+
+  if (lines.empty())
+    Z_LOG_INFO("Object tracker: no live objects.") ;
+  for (auto&& l : lines)
+    Z_LOG_WARNING(l) ;
+
+  // Also writing the report to file
+  std::string f_name ;
+  {
+    std::shared_lock<std::shared_mutex> lock(*names_mtx) ;
+    f_name = *report_file ;
+  }
+  if (f_name.empty()) return ;
+
+  std::FILE* out_file = fopen(f_name.c_str(), "w") ;
+  if (!out_file)
+  {
+    Z_LOG_ERROR(("File: '" + f_name + "' didn't open!").c_str()) ;
+    return ;
+  }
+  fprintf(out_file, "Live tracked objects: %zu\n", LiveCount()) ;
+  for (auto&& l : lines)
+    fprintf(out_file, "%s\n", l.c_str()) ;
+  fclose(out_file) ;
+}
+//--------------------------------------------------------------
+
+//==============================================================
@@ -0,0 +1,193 @@
+/*
+  PlotQueue class
+
+*/
+
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <thread>
+
+#include <TROOT.h>
+
+// Local headers
+#include "DMSS/PlotQueue.hpp"
+#include "DMSS/Prog.hpp"
+
+//==============================================================
+namespace
+{
+  //............................................
+  /// Owns the queue and the rendering thread
+  struct Backend
+  {
+    std::mutex mtx ;    // guards everything below
+    std::condition_variable cv ;
+    std::deque<std::function<void()>> plots ;
+    PlotQueue::Mode mode = PlotQueue::Mode::Immediate ;
+    std::thread renderer ;
+    bool busy = false ;
+    bool stop = false ;
+
+    // Serializes the rendering
+    std::mutex gfx_mtx ;
+
+    Backend()
+    {
+      const char* env = std::getenv("DMSS_PLOT_MODE") ;
+      if (!env) return ;
+
+      if      (strcmp(env, "deferred") == 0)   mode = PlotQueue::Mode::Deferred ;
+      else if (strcmp(env, "background") == 0) mode = PlotQueue::Mode::Background ;
+      else if (strcmp(env, "headless") == 0)   mode = PlotQueue::Mode::Headless ;
+      else if (strcmp(env, "immediate") != 0)
+        Z_LOG_ERROR("Unknown 'DMSS_PLOT_MODE' (options: immediate, "
+                    "deferred, background, headless).") ;
+
+      if (mode == PlotQueue::Mode::Background)
+        Start() ;
+    }
+
+    void Render(std::function<void()>& plot)
+    {
+      std::lock_guard<std::mutex> lock(gfx_mtx) ;
+      plot() ;
+    }
+
+    /// Renders the queued plots on the calling thread
+    void Drain(std::unique_lock<std::mutex>& lock)
+    {
+      while (!plots.empty())
+      {
+        std::function<void()> plot = std::move(plots.front()) ;
+        plots.pop_front() ;
+        busy = true ;
+
+        lock.unlock() ;
+        Render(plot) ;
+        lock.lock() ;
+
+        busy = false ;
+      }
+      cv.notify_all() ;
+    }
+
+    void Run()
+    {
+      std::unique_lock<std::mutex> lock(mtx) ;
+      while (!stop)
+      {
+        cv.wait(lock, [this] { return stop || !plots.empty() ; }) ;
+        Drain(lock) ;
+      }
+    }
+
+    void Start()
+    {
+      // The canvases are never shown
+      gROOT->SetBatch(kTRUE) ;
+      stop = false ;
+      renderer = std::thread([this] { Run() ; }) ;
+    }
+
+    /// Renders everything queued, and stops the renderer
+    void Finish(std::unique_lock<std::mutex>& lock)
+    {
+      if (renderer.joinable())
+      {
+        stop = true ;
+        cv.notify_all() ;
+        lock.unlock() ;
+        renderer.join() ;
+        lock.lock() ;
+      }
+      Drain(lock) ;
+    }
+  };
+
+  //............................................
+  Backend& GetBackend()
+  {
+    // Intentionally leaked; nothing is rendered at exit, since
+    //  ROOT may be torn down by then ('Flush' before that)
+    static Backend* b = new Backend ;
+    return *b ;
+  }
+}
+
+//==============================================================
+void PlotQueue::SetMode(const Mode& in_mode)
+{
+  Backend& b = GetBackend() ;
+  std::unique_lock<std::mutex> lock(b.mtx) ;
+
+  if (in_mode == b.mode) return ;
+
+  b.Finish(lock) ;
+  b.mode = in_mode ;
+
+  if (b.mode == Mode::Background)
+    b.Start() ;
+}
+
+//--------------------------------------------------------------
+PlotQueue::Mode PlotQueue::GetMode()
+{
+  Backend& b = GetBackend() ;
+  std::lock_guard<std::mutex> lock(b.mtx) ;
+  return b.mode ;
+}
+
+//--------------------------------------------------------------
+bool PlotQueue::Headless()
+{
+  return GetMode() == Mode::Headless ;
+}
+
+//--------------------------------------------------------------
+void PlotQueue::Push(std::function<void()>&& render)
+{
+  Backend& b = GetBackend() ;
+  std::unique_lock<std::mutex> lock(b.mtx) ;
+
+  switch (b.mode)
+  {
+    case Mode::Immediate:
+      lock.unlock() ;
+      b.Render(render) ;
+      break;
+
+    case Mode::Deferred:
+      b.plots.emplace_back(std::move(render)) ;
+      break;
+
+    case Mode::Background:
+      b.plots.emplace_back(std::move(render)) ;
+      b.cv.notify_all() ;
+      break;
+
+    default:
+      break;
+  }
+}
+
+//--------------------------------------------------------------
+void PlotQueue::Flush()
+{
+  Backend& b = GetBackend() ;
+  std::unique_lock<std::mutex> lock(b.mtx) ;
+
+  if (b.mode == Mode::Background)
+    b.cv.wait(lock, [&b] { return b.plots.empty() && !b.busy ; }) ;
+  else
+    b.Drain(lock) ;
+}
+
+//--------------------------------------------------------------
+std::unique_lock<std::mutex> PlotQueue::Lock()
+{
+  return std::unique_lock<std::mutex>(GetBackend().gfx_mtx) ;
+}
+
+//==============================================================
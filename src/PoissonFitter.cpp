@@ -0,0 +1,359 @@
+/*
+  PoissonFitter class
+
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Local headers
+#include "DMSS/PoissonFitter.hpp"
+
+//==============================================================
+// Constructor
+PoissonFitter::PoissonFitter(const std::vector<double>& in_counts,
+                             const std::vector<double>& in_sig,
+                             const std::vector<double>& in_width)
+  : counts(in_counts), sig(in_sig), width(in_width)
+{
+  if (width.size() != counts.size())
+    width.assign(counts.size(), 1) ;
+
+  for (size_t j = 0 ; j < std::min(counts.size(), sig.size()) ; ++j)
+  {
+    n_tot += counts[j] ;
+    s_tot += sig[j] ;
+    w_tot += width[j] ;
+    s_max  = std::max(s_max, sig[j] / width[j]) ;
+  }
+}
+
+//--------------------------------------------------------------
+// With r = mu*s + bg*w:  d(-2LogL) = -2 sum (n/r - 1) (s, w),
+//  and the Hessian is  2 sum n/r^2 (s^2, s*w, w^2)
+bool PoissonFitter::Eval(const double& mu, const double& bg, double& val,
+                         std::array<double, 2>& grad, std::array<double, 3>& hess) const
+{
+  val  = 0 ;
+  grad = {0, 0} ;
+  hess = {0, 0, 0} ;
+
+  for (size_t j = 0 ; j < counts.size() ; ++j)
+  {
+    double n = counts[j], s = sig[j], w = width[j] ;
+    double r = mu*s + bg*w ;
+
+    if (r < 0 || (r == 0 && n > 0)) return false ;
+
+    double a = r > 0 ? n/r : 0 ;
+    val     += -2*((n > 0 ? n*std::log(r) : 0) - r) ;
+    grad[0] += -2*s*(a - 1) ;
+    grad[1] += -2*w*(a - 1) ;
+
+    if (r > 0)
+    {
+      double c = 2*a/r ;
+      hess[0] += c*s*s ;
+      hess[1] += c*s*w ;
+      hess[2] += c*w*w ;
+    }
+  }
+
+  return true ;
+}
+
+//--------------------------------------------------------------
+double PoissonFitter::Solve(const std::function<double(double, double&)>& f,
+                            double lo, double hi, double x)
+{
+  for (size_t it = 0 ; it < 200 ; ++it)
+  {
+    double df = 0 ;
+    double fx = f(x, df) ;
+    if (fx == 0) return x ;
+    if (fx < 0) lo = x ; else hi = x ;
+
+    double next = (df > 0 && std::isfinite(fx)) ? x - fx/df : 0.5*(lo + hi) ;
+    if (!(next > lo && next < hi)) next = 0.5*(lo + hi) ;
+
+    if (std::abs(next - x) <= 1e-13*std::abs(x) || hi - lo <= 1e-13*std::abs(hi))
+      return next ;
+    x = next ;
+  }
+
+  return x ;
+}
+
+//--------------------------------------------------------------
+// The root of  sum n*w/(mu*s + bg*w) = sum w  lies in
+//  [N/W - mu*max(s/w), N/W]
+double PoissonFitter::ProfileBg(const double& mu, unsigned int& calls) const
+{
+  double hi = n_tot / w_tot ;
+  double lo = std::max(0.0, hi - mu*s_max) ;
+  if (hi <= 0) return 0 ;
+
+  auto slope = [&](double b, double& df)
+  {
+    calls++ ;
+    double g = w_tot ;
+    df = 0 ;
+    for (size_t j = 0 ; j < counts.size() ; ++j)
+    {
+      double w = width[j] ;
+      double r = mu*sig[j] + b*w ;
+      if (counts[j] == 0) continue ;
+      if (r <= 0) { df = 0 ; return -std::numeric_limits<double>::infinity() ; }
+
+      g  -= counts[j]*w / r ;
+      df += counts[j]*w*w / (r*r) ;
+    }
+    return g ;
+  } ;
+
+  return Solve(slope, lo, hi, 0.5*(lo + hi)) ;
+}
+
+//--------------------------------------------------------------
+// The root of  sum n*s/(mu*s + bg) = sum s  is below N / sum s
+double PoissonFitter::ProfileMu(const double& bg, unsigned int& calls) const
+{
+  auto slope = [&](double m, double& df)
+  {
+    calls++ ;
+    double g = s_tot ;
+    df = 0 ;
+    for (size_t j = 0 ; j < counts.size() ; ++j)
+    {
+      double s = sig[j] ;
+      if (counts[j] == 0 || s == 0) continue ;
+
+      double r = m*s + bg*width[j] ;
+      if (r <= 0) { df = 0 ; return -std::numeric_limits<double>::infinity() ; }
+
+      g  -= counts[j]*s / r ;
+      df += counts[j]*s*s / (r*r) ;
+    }
+    return g ;
+  } ;
+
+  // The minimum is at the limit
+  double tmp ;
+  if (bg > 0 && slope(0, tmp) >= 0)
+    return 0 ;
+
+  double hi = n_tot / s_tot ;
+  return Solve(slope, 0, hi, 0.5*hi) ;
+}
+
+//--------------------------------------------------------------
+PoissonFitter::Result PoissonFitter::Minimum() const
+{
+  Result out ;
+  if (counts.empty() || counts.size() != sig.size() || n_tot <= 0 || s_tot <= 0)
+    return out ;
+
+  unsigned int calls = 0 ;
+  double val ;
+  std::array<double, 2> grad ;
+  std::array<double, 3> hess ;
+
+  // ............ Minimum: projected Newton ............
+  // From the background-only fit
+  double mu = 0, bg = ProfileBg(0, calls) ;
+  if (!Eval(mu, bg, val, grad, hess)) return out ;
+  calls++ ;
+
+  bool converged = false ;
+  for (size_t it = 0 ; it < 100 && !converged ; ++it)
+  {
+    double det = hess[0]*hess[2] - hess[1]*hess[1] ;
+
+    // A flat signal: mu & bg can't be told apart
+    if (!(det > 1e-12*hess[0]*hess[2]))
+      return out ;
+
+    double d_mu = -( hess[2]*grad[0] - hess[1]*grad[1]) / det ;
+    double d_bg = -(-hess[1]*grad[0] + hess[0]*grad[1]) / det ;
+
+    // A parameter at its limit, with the step pushing it out,
+    //  stays there, and only the other one moves
+    bool mu_fixed = (mu <= 0 && d_mu <= 0) ;
+    bool bg_fixed = (bg <= 0 && d_bg <= 0) ;
+    if (mu_fixed && bg_fixed)
+    {
+      mu_fixed = grad[0] >= 0 ;
+      bg_fixed = grad[1] >= 0 ;
+    }
+
+    if (mu_fixed && bg_fixed)
+      d_mu = d_bg = 0 ;
+    else if (mu_fixed)
+    {
+      d_mu = 0 ;
+      d_bg = -grad[1]/hess[2] ;
+    }
+    else if (bg_fixed)
+    {
+      d_mu = -grad[0]/hess[0] ;
+      d_bg = 0 ;
+    }
+
+    // The Newton decrement (the expected drop, doubled), down to
+    //  the rounding of -2LogL
+    double decrement = -(grad[0]*d_mu + grad[1]*d_bg) ;
+    if (decrement <= std::max(1e-12, 1e-14*std::abs(val)))
+    {
+      converged = true ;
+      break ;
+    }
+
+    // The step (projected onto mu, bg >= 0) is halved until
+    //  -2LogL decreases
+    double t = 1 ;
+    bool moved = false ;
+    for (size_t ls = 0 ; ls < 60 && !moved ; ++ls, t *= 0.5)
+    {
+      double mu_t = std::max(0.0, mu + t*d_mu) ;
+      double bg_t = std::max(0.0, bg + t*d_bg) ;
+      double val_t ;
+      std::array<double, 2> grad_t ;
+      std::array<double, 3> hess_t ;
+
+      calls++ ;
+      if (Eval(mu_t, bg_t, val_t, grad_t, hess_t) && val_t <= val)
+      {
+        mu = mu_t ; bg = bg_t ;
+        val = val_t ; grad = grad_t ; hess = hess_t ;
+        moved = true ;
+      }
+    }
+
+    // No decrease: at the minimum, up to the rounding
+    if (!moved)
+      converged = decrement <= 1e-6 ;
+    if (!moved && !converged)
+      return out ;
+  }
+  if (!converged) return out ;
+  // ...................................................
+
+  double det = hess[0]*hess[2] - hess[1]*hess[1] ;
+
+  out.mu      = mu ;
+  out.bg      = bg ;
+  out.min_val = val ;
+  out.cov     = {2*hess[2]/det, -2*hess[1]/det, 2*hess[0]/det} ;
+  out.n_calls = calls ;
+  out.valid   = true ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+double PoissonFitter::Profile(const double& mu, double* bg) const
+{
+  unsigned int calls = 0 ;
+  double val ;
+  std::array<double, 2> grad ;
+  std::array<double, 3> hess ;
+
+  double b = ProfileBg(mu, calls) ;
+  if (bg) *bg = b ;
+
+  if (!Eval(mu, b, val, grad, hess))
+    return std::numeric_limits<double>::infinity() ;
+
+  return val ;
+}
+
+//--------------------------------------------------------------
+PoissonFitter::Result PoissonFitter::Fit(const double& q) const
+{
+  Result out = Minimum() ;
+  if (!out.valid) return out ;
+  out.valid = false ;
+
+  unsigned int calls = out.n_calls ;
+  const double mu = out.mu, bg = out.bg, val = out.min_val ;
+
+  double tmp ;
+  std::array<double, 2> grad ;
+  std::array<double, 3> hess ;
+  Eval(mu, bg, tmp, grad, hess) ;
+  calls++ ;
+
+  // ............ Intervals: roots of the profiles ............
+  // Rise of the profile above the minimum, and its slope
+  auto mu_delta = [&](double m, double& df)
+  {
+    double b = ProfileBg(m, calls) ;
+    double v ;
+    std::array<double, 2> g ;
+    std::array<double, 3> h ;
+    calls++ ;
+    if (!Eval(m, b, v, g, h)) { df = 0 ; return std::numeric_limits<double>::infinity() ; }
+    df = g[0] ;
+    return v - val - q ;
+  } ;
+
+  auto bg_delta = [&](double b, double& df)
+  {
+    double m = ProfileMu(b, calls) ;
+    double v ;
+    std::array<double, 2> g ;
+    std::array<double, 3> h ;
+    calls++ ;
+    if (!Eval(m, b, v, g, h)) { df = 0 ; return std::numeric_limits<double>::infinity() ; }
+    df = g[1] ;
+    return v - val - q ;
+  } ;
+
+  // The crossings around the minimum 'x0' (limited at 0): the
+  //  quadratic estimate of the distance is doubled until passed
+  auto Crossings = [&](const std::function<double(double, double&)>& delta,
+                       const double& x0, double step, double& lower, double& upper)
+  {
+    double tmp ;
+    double lo = x0, hi = x0 + step ;
+    size_t it = 0 ;
+    for ( ; it < 200 && delta(hi, tmp) < 0 ; ++it)
+    {
+      lo    = hi ;
+      step *= 2 ;
+      hi    = x0 + step ;
+    }
+    upper = Solve(delta, lo, hi, hi) - x0 ;
+
+    // At the limit, if the profile doesn't rise enough before it
+    if (x0 <= 0 || delta(0, tmp) <= 0)
+      lower = -x0 ;
+    else
+    {
+      auto neg = [&](double x, double& df) { double v = -delta(x, df) ; df = -df ; return v ; } ;
+      lower = Solve(neg, 0, x0, std::max(0.5*x0, x0 - 0.5*step)) - x0 ;
+    }
+
+    return it < 200 ;
+  } ;
+
+  // The curvatures of the profiles
+  double d2_mu = (bg > 0) ? hess[0] - hess[1]*hess[1]/hess[2] : hess[0] ;
+  double d2_bg = (mu > 0) ? hess[2] - hess[1]*hess[1]/hess[0] : hess[2] ;
+
+  double lower, upper ;
+  bool ok = Crossings(mu_delta, mu, d2_mu > 0 ? std::sqrt(2*q/d2_mu) : 1, lower, upper) ;
+  out.mu_err = MinosResult(mu, lower, upper, ok, calls) ;
+
+  ok = Crossings(bg_delta, bg, d2_bg > 0 ? std::sqrt(2*q/d2_bg) : 1, lower, upper) ;
+  out.bg_err = MinosResult(bg, lower, upper, ok, calls) ;
+  // ...........................................................
+
+  out.n_calls = calls ;
+  out.valid   = true ;
+
+  return out ;
+}
+
+//==============================================================
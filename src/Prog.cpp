@@ -8,9 +8,11 @@
 
 #include <Zaki/String/Banner.hpp>
 #include <Zaki/Util/MemoryManager.hpp>
-#include <Zaki/Util/ObjObserver.hpp>
 
 #include "DMSS/Prog.hpp"
+#include "DMSS/ProgPool.hpp"
+#include "DMSS/ObjTracker.hpp"
+#include "DMSS/AsyncLog.hpp"
 
 //==============================================================
 //std::atomic<size_t> Prog::counter = 0 ;
@@ -61,7 +63,7 @@ Prog::Prog(const std::string& in_name, const bool& tracking)
 #if DMSS_PROG_DEBUG_MODE
     track_objs_flag = tracking ;
   if(track_objs_flag)
-    Z_OBJ_CTR(this, name) ;
+    ObjTracker::Construct(this, name) ;
 #endif
 
   if(counter==0)
@@ -76,7 +78,7 @@ Prog::~Prog()
 
 #if DMSS_PROG_DEBUG_MODE
   if(track_objs_flag)
-    Z_OBJ_DTR(this, name) ;
+    ObjTracker::Destruct(this) ;
 #endif
 
 }
@@ -183,21 +185,29 @@ void* Prog::operator new(size_t sz)
 {
   // if > 10 KBytes send a note to the user
   if(sz > 10000)
-    Z_LOG_NOTE(("Large size of memory requested: "
-                + std::to_string(sz) + " bytes.").c_str()) ;
+    DMSS_LOG_NOTE("Large size of memory requested: "
+                  + std::to_string(sz) + " bytes.") ;
 
+#if DMSS_PROG_POOL
+  return ProgPool::Allocate(sz) ;
+#else
   void* m = malloc(sz);
   
   Z_NEW(m, sz) ;
 
   return m;
+#endif
 }
 
 //--------------------------------------------------------------
 // Overloading CLass specific delete operator
 void Prog::operator delete(void* m)
 {
+#if DMSS_PROG_POOL
+  ProgPool::Deallocate(m) ;
+#else
   Z_DELETE(m) ;
+#endif
 }
 
 //--------------------------------------------------------------
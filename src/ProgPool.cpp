@@ -0,0 +1,302 @@
+/*
+  ProgPool class
+
+*/
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+#include <Zaki/Util/Logger.hpp>
+
+// Local headers
+#include "DMSS/ProgPool.hpp"
+
+//==============================================================
+namespace
+{
+  /// Blocks carved from malloc at once when a class runs dry
+  constexpr size_t SlabBlocks   = 64 ;
+
+  /// Thread cache length above which blocks go back to central
+  constexpr size_t CacheLimit   = 256 ;
+
+  /// Number of blocks moved per central refill
+  constexpr size_t RefillBatch  = 32 ;
+
+  //............................................
+  struct CentralList
+  {
+    std::mutex mtx ;
+    void*  head  = nullptr ;
+    size_t count = 0 ;
+  };
+
+  CentralList& Central(size_t c)
+  {
+    // Intentionally leaked, so it outlives static destructors
+    static CentralList* lists = new CentralList[ProgPool::NumClasses] ;
+    return lists[c] ;
+  }
+
+  //............................................
+  /// Thread-local cache; trivially destructible so that it
+  ///  stays usable while other thread_locals are torn down.
+  struct ThreadCache
+  {
+    void*    head[ProgPool::NumClasses]  ;
+    uint32_t count[ProgPool::NumClasses] ;
+    uint32_t sample_tick ;
+    uint8_t  state ;    // see 'CacheState'
+  };
+
+  enum CacheState : uint8_t { Fresh = 0, Active, Flushed } ;
+
+  thread_local ThreadCache t_cache = {} ;
+
+  //............................................
+  std::atomic<uint32_t> sample_rate = DMSS_PROG_POOL_SAMPLE_RATE ;
+  std::atomic<size_t>   slab_bytes  = 0 ;
+  std::atomic<size_t>   large_count = 0 ;
+
+  std::mutex& SampleMutex()
+  {
+    static std::mutex* m = new std::mutex ;
+    return *m ;
+  }
+
+  std::unordered_map<void*, size_t>& SampleMap()
+  {
+    static auto* m = new std::unordered_map<void*, size_t> ;
+    return *m ;
+  }
+}
+
+//==============================================================
+/// Flushes the thread cache back to the central lists on thread exit
+struct ProgPoolThreadGuard
+{
+  ProgPoolThreadGuard()  { t_cache.state = Active ; }
+  ~ProgPoolThreadGuard()
+  {
+    for (size_t c = 0 ; c < ProgPool::NumClasses ; ++c)
+      ProgPool::Drain(c, 0) ;
+    t_cache.state = Flushed ;
+  }
+};
+
+static thread_local ProgPoolThreadGuard t_guard ;
+
+//==============================================================
+size_t ProgPool::ClassOf(size_t total)
+{
+  return (total + Granularity - 1) / Granularity - 1 ;
+}
+
+//--------------------------------------------------------------
+void ProgPool::Drain(size_t c, size_t keep)
+{
+  if (t_cache.count[c] <= keep) return ;
+
+  // Detaching the surplus as a chain
+  FreeNode* first = static_cast<FreeNode*>(t_cache.head[c]) ;
+  FreeNode* last  = first ;
+  size_t n = t_cache.count[c] - keep ;
+  for (size_t i = 1 ; i < n ; ++i)
+    last = last->next ;
+
+  t_cache.head[c]  = last->next ;
+  t_cache.count[c] = static_cast<uint32_t>(keep) ;
+
+  CentralList& cl = Central(c) ;
+  std::lock_guard<std::mutex> lock(cl.mtx) ;
+  last->next = static_cast<FreeNode*>(cl.head) ;
+  cl.head    = first ;
+  cl.count  += n ;
+}
+
+//--------------------------------------------------------------
+ProgPool::FreeNode* ProgPool::Refill(size_t c)
+{
+  // 1) From the central list
+  {
+    CentralList& cl = Central(c) ;
+    std::lock_guard<std::mutex> lock(cl.mtx) ;
+    if (cl.head)
+    {
+      FreeNode* first = static_cast<FreeNode*>(cl.head) ;
+      FreeNode* last  = first ;
+      size_t n = 1 ;
+      while (n < RefillBatch && last->next)
+      {
+        last = last->next ;
+        ++n ;
+      }
+      cl.head   = last->next ;
+      cl.count -= n ;
+
+      last->next = nullptr ;
+      t_cache.head[c]  = first ;
+      t_cache.count[c] = static_cast<uint32_t>(n) ;
+      return first ;
+    }
+  }
+
+  // 2) Carving a new slab
+  size_t blk  = (c + 1) * Granularity ;
+  char*  slab = static_cast<char*>(std::malloc(blk * SlabBlocks)) ;
+  if (!slab) return nullptr ;
+  slab_bytes += blk * SlabBlocks ;
+
+  for (size_t i = 0 ; i < SlabBlocks - 1 ; ++i)
+    reinterpret_cast<FreeNode*>(slab + i*blk)->next
+      = reinterpret_cast<FreeNode*>(slab + (i+1)*blk) ;
+  reinterpret_cast<FreeNode*>(slab + (SlabBlocks-1)*blk)->next = nullptr ;
+
+  t_cache.head[c]  = slab ;
+  t_cache.count[c] = SlabBlocks ;
+  return reinterpret_cast<FreeNode*>(slab) ;
+}
+
+//--------------------------------------------------------------
+void* ProgPool::Allocate(size_t sz)
+{
+  size_t total = sz + sizeof(Header) ;
+  Header* h    = nullptr ;
+
+  // Touching the guard registers the thread-exit flush
+  if (t_cache.state == Fresh)
+    (void)&t_guard ;
+
+  // Once the thread cache is flushed, pooling is bypassed
+  if (total <= MaxPooled && t_cache.state != Flushed)
+  {
+    size_t c = ClassOf(total) ;
+    FreeNode* node = static_cast<FreeNode*>(t_cache.head[c]) ;
+    if (!node)
+      node = Refill(c) ;
+    if (!node)
+      throw std::bad_alloc() ;
+
+    t_cache.head[c] = node->next ;
+    --t_cache.count[c] ;
+
+    h = reinterpret_cast<Header*>(node) ;
+    h->cls = static_cast<uint32_t>(c) ;
+  }
+  else
+  {
+    h = static_cast<Header*>(std::malloc(total)) ;
+    if (!h)
+      throw std::bad_alloc() ;
+    h->cls = NumClasses ;
+    ++large_count ;
+  }
+
+  h->size    = sz ;
+  h->sampled = 0 ;
+
+  void* m = h + 1 ;
+
+  // Sampled tracking
+  uint32_t rate = sample_rate.load(std::memory_order_relaxed) ;
+  if (rate && ++t_cache.sample_tick >= rate)
+  {
+    t_cache.sample_tick = 0 ;
+    h->sampled = 1 ;
+    SampleNew(m, sz) ;
+  }
+
+  return m ;
+}
+
+//--------------------------------------------------------------
+void ProgPool::Deallocate(void* m)
+{
+  if (!m) return ;
+
+  Header* h = static_cast<Header*>(m) - 1 ;
+
+  if (h->sampled)
+    SampleDelete(m) ;
+
+  if (h->cls == NumClasses)
+  {
+    std::free(h) ;
+    return ;
+  }
+
+  size_t c = h->cls ;
+  FreeNode* node = reinterpret_cast<FreeNode*>(h) ;
+
+  // Once the thread cache is flushed, go straight to central
+  if (t_cache.state == Flushed)
+  {
+    CentralList& cl = Central(c) ;
+    std::lock_guard<std::mutex> lock(cl.mtx) ;
+    node->next = static_cast<FreeNode*>(cl.head) ;
+    cl.head = node ;
+    ++cl.count ;
+    return ;
+  }
+
+  if (t_cache.state == Fresh)
+    (void)&t_guard ;
+
+  node->next = static_cast<FreeNode*>(t_cache.head[c]) ;
+  t_cache.head[c] = node ;
+
+  if (++t_cache.count[c] > CacheLimit)
+    Drain(c, CacheLimit / 2) ;
+}
+
+//--------------------------------------------------------------
+void ProgPool::SetSampleRate(uint32_t rate)
+{
+  sample_rate = rate ;
+}
+
+//--------------------------------------------------------------
+void ProgPool::SampleNew(void* m, size_t sz)
+{
+  std::lock_guard<std::mutex> lock(SampleMutex()) ;
+  SampleMap()[m] = sz ;
+}
+
+//--------------------------------------------------------------
+void ProgPool::SampleDelete(void* m)
+{
+  std::lock_guard<std::mutex> lock(SampleMutex()) ;
+  SampleMap().erase(m) ;
+}
+
+//--------------------------------------------------------------
+void ProgPool::Report()
+{
+  size_t sampled_n = 0, sampled_bytes = 0 ;
+  {
+    std::lock_guard<std::mutex> lock(SampleMutex()) ;
+    sampled_n = SampleMap().size() ;
+    for (auto&& e : SampleMap())
+      sampled_bytes += e.second ;
+  }
+
+  char tmp[300] ;
+  sprintf(tmp, "Prog pool: %zu bytes in slabs, %zu large allocations.",
+          slab_bytes.load(), large_count.load()) ;
+  Z_LOG_INFO(tmp) ;
+
+  uint32_t rate = sample_rate.load() ;
+  if (rate)
+  {
+    sprintf(tmp, "Prog pool: %zu sampled live allocations (%zu bytes),"
+            " ~%zu live objects estimated (1/%u sampling).",
+            sampled_n, sampled_bytes, sampled_n*rate, rate) ;
+    Z_LOG_INFO(tmp) ;
+  }
+}
+//--------------------------------------------------------------
+
+//==============================================================
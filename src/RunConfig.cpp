@@ -0,0 +1,253 @@
+/*
+  RunConfig class
+
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+// Local headers
+#include "DMSS/RunConfig.hpp"
+
+//==============================================================
+namespace
+{
+  /// Removes the leading & trailing white spaces
+  std::string Trim(const std::string& in)
+  {
+    size_t first = in.find_first_not_of(" \t\r") ;
+    if (first == std::string::npos) return "" ;
+
+    size_t last = in.find_last_not_of(" \t\r") ;
+    return in.substr(first, last - first + 1) ;
+  }
+}
+
+//==============================================================
+//                      RunConfig::Section
+//==============================================================
+bool RunConfig::Section::Has(const std::string& key) const
+{
+  for (auto&& k : keys)
+    if (k.first == key) return true ;
+
+  return false ;
+}
+
+//--------------------------------------------------------------
+std::string RunConfig::Section::Get(const std::string& key) const
+{
+  for (auto&& k : keys)
+    if (k.first == key) return k.second ;
+
+  char tmp[200] ;
+  sprintf(tmp, "Key '%s' is missing in section [%s %s] (line %zu).",
+          key.c_str(), type.c_str(), label.c_str(), line) ;
+  Z_LOG_ERROR(tmp) ;
+  exit(EXIT_FAILURE) ;
+}
+
+//--------------------------------------------------------------
+std::string RunConfig::Section::Get(const std::string& key,
+                                    const std::string& def) const
+{
+  return Has(key) ? Get(key) : def ;
+}
+
+//--------------------------------------------------------------
+double RunConfig::Section::GetDouble(const std::string& key) const
+{
+  std::vector<double> vals = GetDoubles(key) ;
+  if (vals.size() != 1)
+  {
+    Z_LOG_ERROR("Key '" + key + "' in section [" + type + " " + label
+                + "] should be a single number.") ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  return vals[0] ;
+}
+
+//--------------------------------------------------------------
+double RunConfig::Section::GetDouble(const std::string& key,
+                                     const double def) const
+{
+  return Has(key) ? GetDouble(key) : def ;
+}
+
+//--------------------------------------------------------------
+std::vector<double> RunConfig::Section::GetDoubles(const std::string& key) const
+{
+  std::vector<double> out ;
+  for (auto&& w : GetWords(key))
+  {
+    char* end = nullptr ;
+    double val = std::strtod(w.c_str(), &end) ;
+
+    if (end == w.c_str() || *end != '\0')
+    {
+      Z_LOG_ERROR("Key '" + key + "' in section [" + type + " " + label
+                  + "]: '" + w + "' is not a number.") ;
+      exit(EXIT_FAILURE) ;
+    }
+    out.push_back(val) ;
+  }
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+std::vector<int> RunConfig::Section::GetInts(const std::string& key) const
+{
+  std::vector<int> out ;
+  for (double val : GetDoubles(key))
+    out.push_back(static_cast<int>(val)) ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+std::vector<std::string> RunConfig::Section::GetWords(const std::string& key) const
+{
+  std::string val = Get(key) ;
+  std::replace(val.begin(), val.end(), ',', ' ') ;
+
+  std::vector<std::string> out ;
+  std::istringstream ss(val) ;
+  for (std::string w ; ss >> w ; )
+    out.push_back(w) ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+std::string RunConfig::Section::Signature() const
+{
+  std::string out = "[" + type + " " + label + "]" ;
+  for (auto&& k : keys)
+    out += " " + k.first + "=" + k.second + ";" ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+std::string RunConfig::Section::Signature(const std::vector<std::string>& only) const
+{
+  std::string out = "[" + type + " " + label + "]" ;
+  for (auto&& k : keys)
+    if (std::find(only.begin(), only.end(), k.first) != only.end())
+      out += " " + k.first + "=" + k.second + ";" ;
+
+  return out ;
+}
+
+//==============================================================
+//                          RunConfig
+//==============================================================
+// Constructor
+RunConfig::RunConfig()
+  : Prog("RunConfig", true)
+{ }
+
+//--------------------------------------------------------------
+// Destructor
+RunConfig::~RunConfig() { }
+
+//--------------------------------------------------------------
+void RunConfig::Parse(const Zaki::String::Directory& f_name)
+{
+  file = f_name ;
+  sections.clear() ;
+
+  std::ifstream in(f_name.Str()) ;
+
+  // Error opening the file
+  if (in.fail())
+  {
+    Z_LOG_ERROR("File '" + f_name.Str() + "' cannot be opened!") ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  char tmp[300] ;
+  std::string line ;
+  for (size_t l_num = 1 ; std::getline(in, line) ; ++l_num)
+  {
+    // Comments
+    line = Trim(line.substr(0, line.find('#'))) ;
+    if (line.empty()) continue ;
+
+    // ............ Section header ............
+    if (line.front() == '[')
+    {
+      if (line.back() != ']')
+      {
+        sprintf(tmp, "%s:%zu: Section header is missing ']'.",
+                f_name.Str().c_str(), l_num) ;
+        Z_LOG_ERROR(tmp) ;
+        exit(EXIT_FAILURE) ;
+      }
+
+      std::istringstream ss(line.substr(1, line.size() - 2)) ;
+      Section sec ;
+      sec.line = l_num ;
+      ss >> sec.type ;
+      std::getline(ss, sec.label) ;
+      sec.label = Trim(sec.label) ;
+
+      sections.push_back(sec) ;
+      continue ;
+    }
+    // ........................................
+
+    // ............ key = value ............
+    size_t eq = line.find('=') ;
+    if (eq == std::string::npos || sections.empty())
+    {
+      sprintf(tmp, "%s:%zu: Expected 'key = value' inside a section.",
+              f_name.Str().c_str(), l_num) ;
+      Z_LOG_ERROR(tmp) ;
+      exit(EXIT_FAILURE) ;
+    }
+
+    sections.back().keys.emplace_back(Trim(line.substr(0, eq)),
+                                      Trim(line.substr(eq + 1))) ;
+    // ........................................
+  }
+
+  Z_LOG_INFO("Run configuration parsed from '" + f_name.Str() + "'.") ;
+}
+
+//--------------------------------------------------------------
+const std::vector<RunConfig::Section>& RunConfig::GetSections() const
+{
+  return sections ;
+}
+
+//--------------------------------------------------------------
+std::vector<const RunConfig::Section*>
+RunConfig::GetSections(const std::string& type) const
+{
+  std::vector<const Section*> out ;
+  for (auto&& sec : sections)
+    if (sec.type == type) out.push_back(&sec) ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+const RunConfig::Section& RunConfig::GetSection(const std::string& type) const
+{
+  std::vector<const Section*> out = GetSections(type) ;
+  if (out.size() != 1)
+  {
+    Z_LOG_ERROR("Configuration '" + file.Str() + "' should have exactly one ["
+                + type + "] section.") ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  return *out[0] ;
+}
+
+//==============================================================
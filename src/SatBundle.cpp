@@ -12,12 +12,24 @@ SatBundle& SatBundle::operator=(const SatBundle& other)
   if(this == &other) return *this ;
   
   m_BinPeriods = other.m_BinPeriods ;
+  m_BinEdges   = other.m_BinEdges ;
   if(other.m_SatPtr)
     m_SatPtr = other.m_SatPtr->Clone() ;
   
   return *this ;
 }
 //--------------------------------------------------------------
+SatBundle& SatBundle::operator=(SatBundle&& other) noexcept
+{
+  if(this == &other) return *this ;
+  
+  m_BinPeriods = std::move(other.m_BinPeriods) ;
+  m_BinEdges   = std::move(other.m_BinEdges) ;
+  m_SatPtr     = std::move(other.m_SatPtr) ;
+  
+  return *this ;
+}
+//--------------------------------------------------------------
 void SatBundle::SetBinPeriod(const std::vector<int>& per)
 {
   if(!m_SatPtr)
@@ -34,12 +46,30 @@ void SatBundle::SetBinPeriod(const std::vector<int>& per)
   m_BinPeriods = per ;
 }
 
+//--------------------------------------------------------------
+void SatBundle::SetBinEdges(const std::vector<std::vector<double>>& edges)
+{
+  if(!m_SatPtr)
+  {
+    Z_LOG_ERROR("Add a satellite first!") ;
+    return ;
+  }
+
+  m_BinEdges = edges ;
+}
+
 //--------------------------------------------------------------
 std::vector<int> SatBundle::GetBinPeriod() const
 {
   return m_BinPeriods ;
 }
 
+//--------------------------------------------------------------
+std::vector<std::vector<double>> SatBundle::GetBinEdges() const
+{
+  return m_BinEdges ;
+}
+
 //--------------------------------------------------------------
 /// Returns the satellite pointer
 std::shared_ptr<Satellite> SatBundle::GetSatellite()
@@ -50,7 +80,16 @@ std::shared_ptr<Satellite> SatBundle::GetSatellite()
 //--------------------------------------------------------------
 Bin SatBundle::GetTimeBin(const size_t& b_idx, const size_t& t_idx)
 {
-  Bin b = m_SatPtr->GetData().GetBins()[b_idx];
+  // Only the requested bin is copied, since it gets divided
+  Bin b = m_SatPtr->GetData()[b_idx];
+
+  if (t_idx < m_BinEdges.size() && !m_BinEdges[t_idx].empty())
+  {
+    m_SatPtr->TimeBin(m_BinEdges[t_idx]);
+    b.divide(m_BinEdges[t_idx]);
+
+    return b ;
+  }
 
   m_SatPtr->TimeBin(m_BinPeriods[t_idx]);
 
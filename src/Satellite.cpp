@@ -7,7 +7,10 @@
 
 // Creating directory
 #include <sys/stat.h>
+#include <algorithm>
 #include <array>
+#include <cstdio>
+#include <limits>
 
 // Root
 #include <TDatime.h>
@@ -17,6 +20,7 @@
 #include <TCanvas.h>
 #include <TStyle.h>
 #include <TLine.h>
+#include <TGraph.h>
 #include <TGraph2D.h>
 #include <TMultiGraph.h>
 
@@ -28,6 +32,9 @@
 
 // Local headers
 #include "DMSS/Satellite.hpp"
+#include "DMSS/AsyncLog.hpp"
+#include "DMSS/TaskPool.hpp"
+#include "DMSS/PlotQueue.hpp"
 
 using namespace Zaki::Physics ;
 //==============================================================
@@ -88,7 +95,7 @@ Zaki::Physics::GEICoord Satellite::GetSunPos(double in_date) const
   Zaki::Physics::Date tmp_2050 = {2050, 1, 1};
   if (in_date < tmp_1950.UnixTDay() || in_date > tmp_2050.UnixTDay())
   {
-    Z_LOG_ERROR("Year must be in [1950, 2050] range, otherwise the answer is not accurate!") ;
+    DMSS_LOG_WARNING("Year must be in [1950, 2050] range, otherwise the answer is not accurate!") ;
   } 
 
   // mean longitude (deg)
@@ -161,7 +168,7 @@ double Satellite::GetSunEclipticLong(double in_Jdate) const
   Zaki::Physics::Date tmp_2050 = {2050, 1, 1};
   if (in_Jdate < tmp_1950.UnixTDay() || in_Jdate > tmp_2050.UnixTDay())
   {
-    Z_LOG_ERROR("Year must be in [1950, 2050] range, otherwise the answer is not accurate!") ;
+    DMSS_LOG_WARNING("Year must be in [1950, 2050] range, otherwise the answer is not accurate!") ;
   } 
 
   // mean longitude (deg)
@@ -181,10 +188,10 @@ Zaki::Physics::GEICoord Satellite::GetSatPos(double in_Jdate) const
 {
   Zaki::Physics::GEICoord tmp_pos = {{1, 0, 0}} ;
 
-  if (in_Jdate < GetTimeDuration().start.UnixTDay() ||
-      GetTimeDuration().end.UnixTDay() < in_Jdate)
+  const Zaki::Physics::DateInterval t_dur = GetTimeDuration() ;
+  if (in_Jdate < t_dur.start.UnixTDay() || t_dur.end.UnixTDay() < in_Jdate)
   {
-    Z_LOG_WARNING("The date is not within the satellite time range.") ;
+    DMSS_LOG_WARNING("The date is not within the satellite time range.") ;
   }
 
   // double tmp_time_dur = in_Jdate - GetTimeDuration().start.UnixTDay() ;
@@ -203,10 +210,10 @@ Zaki::Physics::GEICoord Satellite::GetSatTan(double in_Jdate) const
 {
   Zaki::Physics::GEICoord tmp_pos = {{0, 1, 0}} ;
 
-  if (in_Jdate < GetTimeDuration().start.UnixTDay() ||
-      GetTimeDuration().end.UnixTDay() < in_Jdate)
+  const Zaki::Physics::DateInterval t_dur = GetTimeDuration() ;
+  if (in_Jdate < t_dur.start.UnixTDay() || t_dur.end.UnixTDay() < in_Jdate)
   {
-    Z_LOG_WARNING("The date is not within the satellite time range.") ;
+    DMSS_LOG_WARNING("The date is not within the satellite time range.") ;
   }
 
   // double tmp_time_dur = in_Jdate - GetTimeDuration().start.UnixTDay() ;
@@ -373,6 +380,7 @@ void Satellite::ImportExposure(const Zaki::String::Directory& f_name)
   }
 
   exp_hist = tmp_exp_hist;
+  SumExposure() ;
 
   Z_LOG_INFO("Exposure data imported from: "+ (wrk_dir+f_name).Str()+".") ;
   set_exposure_eval_flag = true ;
@@ -598,7 +606,7 @@ void Satellite::ImportData(const std::string& in_name, const Zaki::String::Direc
 }
 
 //--------------------------------------------------------------
-Data Satellite::GetData() const
+const Data& Satellite::GetData() const
 {
   return results;
 }
@@ -632,6 +640,206 @@ void Satellite::TimeBin(int bin_period)
   sig_shape_hist.Scale(scale_factor) ;
 }
 
+//--------------------------------------------------------------
+void Satellite::SumExposure()
+{
+  exp_sum.assign(exp_hist.GetNbinsX() + 1, 0) ;
+  for (int d = 1 ; d <= exp_hist.GetNbinsX() ; ++d)
+    exp_sum[d] = exp_sum[d-1] + exp_hist.GetBinContent(d) ;
+}
+
+//--------------------------------------------------------------
+double Satellite::Exposure(const double& t_0, const double& t_1) const
+{
+  if (exp_sum.empty()) return 0 ;
+
+  const double n_days = exp_sum.size() - 1 ;
+  auto cumulative = [&](double t)
+  {
+    t = std::min(std::max(t, 0.0), n_days) ;
+    size_t d = std::min(static_cast<size_t>(t), exp_sum.size() - 2) ;
+    return exp_sum[d] + (t - d)*(exp_sum[d+1] - exp_sum[d]) ;
+  } ;
+
+  return cumulative(t_1) - cumulative(t_0) ;
+}
+
+//--------------------------------------------------------------
+void Satellite::TimeBin(const std::vector<double>& edges)
+{
+  if(!set_exposure_eval_flag)
+  {
+    Z_LOG_ERROR(" TimeBin() failed because exposure hasn't been evaluated!");
+    exit(EXIT_FAILURE) ;
+    return ;
+  }
+
+  if (edges.size() < 2)
+  {
+    Z_LOG_ERROR("At least two edges are needed for the time bins!") ;
+    return ;
+  }
+
+  TH1F h(("sig_shape_"+GetName()).c_str(), ("Exposure_"+GetName()).c_str(),
+         edges.size() - 1, edges.data()) ;
+  h.SetDirectory(nullptr) ;
+
+  for (size_t k = 0 ; k + 1 < edges.size() ; ++k)
+    h.SetBinContent(k+1, Exposure(edges[k], edges[k+1])) ;
+
+  double scale_factor = 1.0 / h.Integral();
+  h.Scale(scale_factor) ;
+
+  sig_shape_hist = h ;
+}
+
+//--------------------------------------------------------------
+// The day where the cumulative exposure is closest to each
+//  k/n of the total (at least a day after the previous edge)
+std::vector<double> Satellite::ExposureEdges(const size_t& in_n_bins) const
+{
+  const size_t n_days = exp_sum.empty() ? 0 : exp_sum.size() - 1 ;
+  if (in_n_bins == 0 || n_days == 0) return {} ;
+
+  // At most a bin per day
+  const size_t n_bins = std::min(in_n_bins, n_days) ;
+  if (n_bins < in_n_bins)
+  {
+    char tmp_char[150] ;
+    sprintf(tmp_char, "There are only %zu days for %zu time bins, using %zu bins.",
+            n_days, in_n_bins, n_bins) ;
+    Z_LOG_ERROR(tmp_char) ;
+  }
+
+  std::vector<double> edges = {0} ;
+  size_t d = 0 ;
+  for (size_t k = 1 ; k < n_bins ; ++k)
+  {
+    const double target = exp_sum.back() * k / n_bins ;
+
+    // The days left must fit the bins left
+    const size_t d_max = n_days - (n_bins - k) ;
+    size_t next = std::lower_bound(exp_sum.begin() + d + 1, exp_sum.begin() + d_max + 1,
+                                   target) - exp_sum.begin() ;
+    next = std::min(next, d_max) ;
+    if (next > d + 1 && target - exp_sum[next-1] < exp_sum[next] - target)
+      next-- ;
+
+    d = next ;
+    edges.push_back(d) ;
+  }
+  edges.push_back(n_days) ;
+
+  return edges ;
+}
+
+//--------------------------------------------------------------
+// The (Fisher) information on the signal strength, with a flat
+//  background in each bin of width W_k & exposure E_k, is
+//  proportional to  sum_k E_k^2 / W_k - E^2 / T , i.e. the 
+//  variance of the binned exposure. The blocks maximizing
+//  sum_k (E_k^2 / W_k - lambda) are found by dynamic programming
+//  (as Bayesian blocks), and lambda (the price of a bin) is
+//  bisected so that the loss stays within 'max_loss'.
+// The edges are on weeks (and the last day), and since a split
+//  never loses information, a start that can't beat the end of
+//  its block is dropped for good (PELT), which keeps each of the
+//  bisection's steps far below the (n_days)^2 of the plain DP.
+std::vector<double> Satellite::InfoEdges(const double& max_loss) const
+{
+  const size_t n_days = exp_sum.empty() ? 0 : exp_sum.size() - 1 ;
+  if (n_days == 0) return {} ;
+
+  const double e_tot = exp_sum.back() ;
+  auto block = [&](const size_t& l, const size_t& r)
+  {
+    double e = exp_sum[r] - exp_sum[l] ;
+    return e*e / (r - l) ;
+  } ;
+
+  double info_daily = -e_tot*e_tot / n_days ;
+  for (size_t d = 0 ; d < n_days ; ++d)
+    info_daily += block(d, d+1) ;
+
+  // The candidate edges
+  const size_t week = 7 ;
+  std::vector<size_t> cand ;
+  cand.reserve(n_days / week + 2) ;
+  for (size_t d = 0 ; d < n_days ; d += week)
+    cand.push_back(d) ;
+  cand.push_back(n_days) ;
+
+  // The best blocks for the price 'lambda', and their information
+  std::vector<double> best(cand.size()) ;
+  std::vector<size_t> last(cand.size()) ;
+  std::vector<size_t> alive, kept ;
+  alive.reserve(cand.size()) ;
+  kept.reserve(cand.size()) ;
+  auto blocks = [&](const double& lambda, double& info)
+  {
+    best[0] = 0 ;
+    alive   = {0} ;
+    for (size_t r = 1 ; r < cand.size() ; ++r)
+    {
+      best[r] = -std::numeric_limits<double>::infinity() ;
+      for (auto&& l : alive)
+      {
+        double v = best[l] + block(cand[l], cand[r]) - lambda ;
+        if (v > best[r]) { best[r] = v ; last[r] = l ; }
+      }
+
+      // block(l, s) <= block(l, r) + block(r, s), so 'l' can't
+      //  beat 'r' for any later end
+      kept.clear() ;
+      for (auto&& l : alive)
+        if (best[l] + block(cand[l], cand[r]) > best[r])
+          kept.push_back(l) ;
+      kept.push_back(r) ;
+      std::swap(alive, kept) ;
+    }
+
+    std::vector<double> edges = {static_cast<double>(n_days)} ;
+    info = -e_tot*e_tot / n_days ;
+    for (size_t r = cand.size() - 1 ; r > 0 ; r = last[r])
+    {
+      info += block(cand[last[r]], cand[r]) ;
+      edges.push_back(cand[last[r]]) ;
+    }
+    std::reverse(edges.begin(), edges.end()) ;
+
+    return edges ;
+  } ;
+
+  // A single bin has no information
+  std::vector<double> daily(n_days + 1) ;
+  for (size_t d = 0 ; d <= n_days ; ++d)
+    daily[d] = d ;
+  if (info_daily <= 0 || max_loss <= 0)
+    return daily ;
+
+  // ............ Bisecting lambda (in its log) ............
+  // No split gains more than the daily bins' information, so
+  //  above it there is a single bin
+  double info ;
+  double lo = 1e-12*info_daily, hi = 2*info_daily ;
+  std::vector<double> out = daily, edges ;
+  for (size_t it = 0 ; it < 40 && hi > 1.01*lo ; ++it)
+  {
+    double lambda = std::sqrt(lo*hi) ;
+    edges = blocks(lambda, info) ;
+    if (1 - info / info_daily <= max_loss)
+    {
+      lo  = lambda ;
+      out = edges ;
+    }
+    else
+      hi = lambda ;
+  }
+  // .......................................................
+
+  return out ;
+}
+
 //--------------------------------------------------------------
 TH1F Satellite::GetSigShape(double energy) const
 {
@@ -1377,16 +1585,19 @@ const Zaki::Physics::Date& t_2, const Zaki::String::Directory& f_name)
   my_saver.Export1D(sunshine_vec) ;
   // ............................................
 
-  TCanvas c_sunshine("c_sunshine", "Sunshine Projection", 2500, 1200) ;
-  c_sunshine.SetGrid();
-  gPad->SetGrid() ;
-  gStyle->SetOptStat(0);
-  gStyle->SetTitleFontSize(0.035);
-  gStyle->SetTitleAlign(23) ;
-  c_sunshine.Update() ;
-
-  // TF1("f",fptr,&MyFunction::Evaluate,0,1,npar,"MyFunction","Evaluate"); 
-  TF1 SunshinePlot("Sunshine", this, &Satellite::SunshineFuncWrapper, t_1.RootT95(), t_2.RootT95(), 0);
+  // ............................................
+  // The curve is sampled here (in parallel), and drawn 
+  //  later by the plot queue
+  if (PlotQueue::Headless()) return ;
+
+  const int n_pts = 35000 ;
+  std::vector<double> t_pts(n_pts), proj_pts(n_pts) ;
+  double t_step = (t_2.RootT95() - t_1.RootT95()) / (n_pts - 1) ;
+  TaskPool::Get().ParallelFor(n_pts, [&](size_t i)
+  {
+    t_pts[i]    = t_1.RootT95() + i*t_step ;
+    proj_pts[i] = SunshineFuncWrapper(&t_pts[i], nullptr) ;
+  }) ;
 
   std::string date_range_str ;
   date_range_str = GetTimeDuration().start.StrForm("#Y-#M-#D")
@@ -1395,36 +1606,51 @@ const Zaki::Physics::Date& t_2, const Zaki::String::Directory& f_name)
   char tmp[150] ;
   sprintf(tmp, "#splitline{Sunshine on the Satellite vs. Time}{%s}; t (day); #hat{r}_{Sun} #bullet #hat{n}",
           date_range_str.c_str()) ;
+  std::string title(tmp) ;
 
-  SunshinePlot.SetTitle(tmp) ;
-
-  SunshinePlot.SetNpx(35000);
-  SunshinePlot.SetMaximum(1);
-  SunshinePlot.SetMinimum(-1);
-  SunshinePlot.SetLineColor(kOrange) ;
-  SunshinePlot.SetLineWidth(1) ;
-  // SunshinePlot.SetLineStyle(7);
-  // SunshinePlot.SetLineColorAlpha(0, 1) ;
-
-  SunshinePlot.GetXaxis()->SetTimeDisplay(1) ;
-  TDatime da(JAN1st1995.yr,JAN1st1995.mo,JAN1st1995.day,
-             JAN1st1995.cl.h,JAN1st1995.cl.min,JAN1st1995.cl.sec);
-  SunshinePlot.GetXaxis()->SetTimeOffset(da.Convert()) ;
-  SunshinePlot.GetXaxis()->SetTimeFormat("#splitline{%Y}{%b/%d}") ;
-  SunshinePlot.GetXaxis()->SetLabelSize(0.03) ;
-  SunshinePlot.GetXaxis()->SetLabelOffset(0.015) ;
-
-  SunshinePlot.GetXaxis()->SetTitleOffset(1.5) ;
+  double cos_fov  = cos(GetConeFOV()*DEG_2_RAD) ;
+  std::string out_file = (wrk_dir + f_name + ".pdf").Str() ;
 
-  SunshinePlot.Draw() ;
-
-  TLine line(t_1.RootT95(), -cos(GetConeFOV()*DEG_2_RAD),
-             t_2.RootT95(), -cos(GetConeFOV()*DEG_2_RAD)) ;
-  line.SetLineColor(kPink) ;
-  line.SetLineStyle(2) ;
-  line.Draw("SAME") ;
-
-  c_sunshine.SaveAs((wrk_dir + f_name + ".pdf").Str().c_str()) ;
+  PlotQueue::Push([t_pts, proj_pts, title, cos_fov, out_file]()
+  {
+    TCanvas c_sunshine("c_sunshine", "Sunshine Projection", 2500, 1200) ;
+    c_sunshine.SetGrid();
+    gPad->SetGrid() ;
+    gStyle->SetOptStat(0);
+    gStyle->SetTitleFontSize(0.035);
+    gStyle->SetTitleAlign(23) ;
+    c_sunshine.Update() ;
+
+    TGraph SunshinePlot(t_pts.size(), &t_pts[0], &proj_pts[0]) ;
+    SunshinePlot.SetTitle(title.c_str()) ;
+
+    SunshinePlot.SetMaximum(1);
+    SunshinePlot.SetMinimum(-1);
+    SunshinePlot.SetLineColor(kOrange) ;
+    SunshinePlot.SetLineWidth(1) ;
+    // SunshinePlot.SetLineStyle(7);
+    // SunshinePlot.SetLineColorAlpha(0, 1) ;
+
+    SunshinePlot.GetXaxis()->SetLimits(t_pts.front(), t_pts.back()) ;
+    SunshinePlot.GetXaxis()->SetTimeDisplay(1) ;
+    TDatime da(JAN1st1995.yr,JAN1st1995.mo,JAN1st1995.day,
+               JAN1st1995.cl.h,JAN1st1995.cl.min,JAN1st1995.cl.sec);
+    SunshinePlot.GetXaxis()->SetTimeOffset(da.Convert()) ;
+    SunshinePlot.GetXaxis()->SetTimeFormat("#splitline{%Y}{%b/%d}") ;
+    SunshinePlot.GetXaxis()->SetLabelSize(0.03) ;
+    SunshinePlot.GetXaxis()->SetLabelOffset(0.015) ;
+
+    SunshinePlot.GetXaxis()->SetTitleOffset(1.5) ;
+
+    SunshinePlot.Draw("AL") ;
+
+    TLine line(t_pts.front(), -cos_fov, t_pts.back(), -cos_fov) ;
+    line.SetLineColor(kPink) ;
+    line.SetLineStyle(2) ;
+    line.Draw("SAME") ;
+
+    c_sunshine.SaveAs(out_file.c_str()) ;
+  }) ;
 
   Z_LOG_INFO("Solar projection on the satellite saved into: '"+f_name.Str()+"'.") ;
 }
@@ -1475,9 +1701,142 @@ void Satellite::EvaluateExposure(const Zaki::Physics::Date& t_1, const Zaki::Phy
   sprintf(tmp_char, "Evaluating the exposure for %.1f days ...", t_2.UnixTDay()-t_1.UnixTDay()) ;
   Z_LOG_INFO(tmp_char) ;
 
-  gsl_integration_workspace *w = gsl_integration_workspace_alloc(500*(size_t)(t_2.UnixTDay()-t_1.UnixTDay()+1));
-  double err;
+  timer.Start();
+
+  const size_t n_days = static_cast<size_t>(std::ceil(t_2.UnixTDay()-t_1.UnixTDay())) ;
+  double s1 = FillExposure(DailyExposure(t_1.UnixTDay(), 0, n_days), 
+                           t_2.UnixTDay()-t_1.UnixTDay()) ;
+
+  timer.Stop();
+  
+  double scale_exp = 24*3600*ExpTimeFrac(1.2e3);
+  scale_exp       *= Acceptance(1.2e3) / GetConeFOV("sr");
+  
+  sprintf(tmp_char, "--> Integration took %f seconds.", timer.RealTime() ) ;
+  Z_LOG_INFO(tmp_char) ;
+  sprintf(tmp_char, "--> Integral result =  %f. \t Total Exposure (1.2 TeV): %.5e.", s1, s1*scale_exp ) ;
+  Z_LOG_INFO(tmp_char) ;
+}
+
+//--------------------------------------------------------------
+// The store holds the daily exposure from its start day, for 
+//  the orbit it was evaluated for
+void Satellite::ExtendExposure(const Zaki::Physics::Date& t_1, const Zaki::Physics::Date& t_2,
+                               const Zaki::String::Directory& store) 
+{
+  TStopwatch timer;
+  timer.Start();
+
+  const std::string orbit = OrbitSignature() ;
+  const double t_0 = t_1.UnixTDay() ;
+  const size_t n_days = static_cast<size_t>(std::ceil(t_2.UnixTDay()-t_1.UnixTDay())) ;
+
+  // ............ Reading the store ............
+  std::vector<double> days ;
+  double store_start = t_0 ;
+  bool usable = false ;
+
+  std::ifstream in((wrk_dir + "/" + store).Str()) ;
+  std::string line ;
+  while (std::getline(in, line))
+  {
+    if (line.rfind("# orbit ", 0) == 0)
+      usable = line.substr(8) == orbit ;
+    else if (line.rfind("# start ", 0) == 0)
+      store_start = std::stod(line.substr(8)) ;
+    else if (!line.empty() && line[0] != '#')
+      days.push_back(std::stod(line)) ;
+  }
+
+  // The stored days are reused if they are whole days apart from t_1
+  double offset = std::round(t_0 - store_start) ;
+  if (!usable || std::abs(t_0 - store_start - offset) > 1e-9)
+  {
+    if (!days.empty())
+      Z_LOG_NOTE("Exposure store '" + (wrk_dir + "/" + store).Str() 
+                 + "' belongs to another orbit or start, it will be replaced.") ;
+    days.clear() ;
+    store_start = t_0 ;
+    offset = 0 ;
+  }
+  // ...........................................
+
+  char tmp_char[200] ;
+  bool changed = false ;
+
+  // ............ Prepending the earlier days ............
+  if (offset < 0)
+  {
+    const size_t n_pre = static_cast<size_t>(-offset) ;
+    sprintf(tmp_char, "Evaluating the exposure for %zu earlier days (%zu stored) ...", 
+            n_pre, days.size()) ;
+    Z_LOG_INFO(tmp_char) ;
+
+    std::vector<double> pre_days = DailyExposure(t_0, 0, n_pre) ;
+    days.insert(days.begin(), pre_days.begin(), pre_days.end()) ;
+    store_start = t_0 ;
+    offset = 0 ;
+    changed = true ;
+  }
+  const size_t first = static_cast<size_t>(offset) ;
+  // .....................................................
+
+  // ............ Appending the new days ............
+  const size_t n_stored = days.size() ;
+  if (n_stored < first + n_days)
+  {
+    sprintf(tmp_char, "Evaluating the exposure for %zu new days (%zu stored) ...", 
+            first + n_days - n_stored, n_stored) ;
+    Z_LOG_INFO(tmp_char) ;
+
+    std::vector<double> new_days = DailyExposure(store_start, n_stored, first + n_days) ;
+    days.insert(days.end(), new_days.begin(), new_days.end()) ;
+    changed = true ;
+  }
+  else if (!changed)
+  {
+    sprintf(tmp_char, "All the %zu days of exposure are stored.", n_days) ;
+    Z_LOG_INFO(tmp_char) ;
+  }
+
+  // The store is replaced only once it's complete
+  if (changed)
+  {
+    std::string tmp_file = (wrk_dir + "/" + store).Str() + ".tmp" ;
+    FILE* out = fopen(tmp_file.c_str(), "w") ;
+    bool ok = out != nullptr ;
+    if (ok)
+    {
+      fprintf(out, "# orbit %s\n# start %.17g\n", orbit.c_str(), store_start) ;
+      for (const double one_day : days)
+        fprintf(out, "%.17g\n", one_day) ;
+      ok = (fclose(out) == 0) ;
+    }
+
+    if (!ok || std::rename(tmp_file.c_str(), (wrk_dir + "/" + store).Str().c_str()) != 0)
+      Z_LOG_ERROR("Exposure store '" + (wrk_dir + "/" + store).Str() + "' cannot be written!") ;
+  }
+  // ................................................
+
+  std::vector<double> tmp_exp_set(days.begin() + first, days.begin() + first + n_days) ;
+  double s1 = FillExposure(tmp_exp_set, t_2.UnixTDay()-t_1.UnixTDay()) ;
 
+  timer.Stop();
+  
+  double scale_exp = 24*3600*ExpTimeFrac(1.2e3);
+  scale_exp       *= Acceptance(1.2e3) / GetConeFOV("sr");
+  
+  sprintf(tmp_char, "--> Extending took %f seconds.", timer.RealTime() ) ;
+  Z_LOG_INFO(tmp_char) ;
+  sprintf(tmp_char, "--> Integral result =  %f. \t Total Exposure (1.2 TeV): %.5e.", s1, s1*scale_exp ) ;
+  Z_LOG_INFO(tmp_char) ;
+}
+
+//--------------------------------------------------------------
+// Integrating the exposure of the days [first, last) after t_0
+std::vector<double> Satellite::DailyExposure(const double& t_0, const size_t& first, 
+                                             const size_t& last) 
+{
   Zaki::Math::GSLFuncWrapper<Satellite, double (Satellite::*)(double)> 
     Fp(this, &Satellite::ExposureIntegrand);     
 
@@ -1486,33 +1845,52 @@ void Satellite::EvaluateExposure(const Zaki::Physics::Date& t_1, const Zaki::Phy
 
   gsl_function F = static_cast<gsl_function> (Fp) ; 
 
-  timer.Start();
-
   // ROOT::Math::Integrator ig(f);
-  double s1 = 0, one_day = 0;
-  std::vector<double> tmp_exp_set ;
-  tmp_exp_set.reserve(static_cast<size_t>(t_2.UnixTDay()-t_1.UnixTDay())) ;
+  const size_t n_days = last > first ? last - first : 0 ;
+  std::vector<double> tmp_exp_set(n_days, 0) ;
 
   // Finding the daily exposure and saving it in 'tmp_exp_set'
-  for(size_t i = 0 ; i < t_2.UnixTDay()-t_1.UnixTDay() ; ++i)
+  //  The days are independent, so chunks of days are integrated 
+  //  in parallel, each with its own workspace.
+  const size_t chunk = std::max<size_t>(1, n_days / (4*TaskPool::Get().Size())) ;
+  TaskPool::Get().ParallelFor((n_days + chunk - 1) / chunk, [&](size_t c)
   {
-    gsl_integration_qag(&F, t_1.UnixTDay() + i, t_1.UnixTDay() + i + 1, 1e-3, 1e-3, 500, 1, w, &one_day, &err);
-    // one_day = ig.Integral(t_1.UnixTDay() + i, t_1.UnixTDay() + i + 1) ;
+    gsl_integration_workspace *w = gsl_integration_workspace_alloc(500);
+    double one_day = 0, err ;
+
+    for(size_t i = c*chunk ; i < std::min(n_days, (c+1)*chunk) ; ++i)
+    {
+      const double day = t_0 + (first + i) ;
+      gsl_integration_qag(&F, day, day + 1, 1e-3, 1e-3, 500, 1, w, &one_day, &err);
+      // one_day = ig.Integral(day, day + 1) ;
+
+      // weighing the events by ( 1 AU / R_sun_2_sat)^2 
+      // Note that there should be a (1/AU)^2 in P_dec from the model
+      // such that after cancellation we have included a time-dependent
+      //  (1 / R_sun_2_sat )^2 factor.
+      one_day *= AU_2_KM*AU_2_KM / pow(GetRSun2Sat(day).r(), 2) ; 
 
-    // weighing the events by ( 1 AU / R_sun_2_sat)^2 
-    // Note that there should be a (1/AU)^2 in P_dec from the model
-    // such that after cancellation we have included a time-dependent
-    //  (1 / R_sun_2_sat )^2 factor.
-    one_day *= AU_2_KM*AU_2_KM / pow(GetRSun2Sat(t_1.UnixTDay()+i).r(), 2) ; 
+      tmp_exp_set[i] = one_day ;
+    }
+
+    gsl_integration_workspace_free(w);
+  }) ;
 
+  return tmp_exp_set ;
+}
+
+//--------------------------------------------------------------
+// Fills the exposure histogram, and returns the total exposure
+double Satellite::FillExposure(const std::vector<double>& tmp_exp_set, const double& span)
+{
+  // Summing in the day order
+  double s1 = 0 ;
+  for(const double one_day : tmp_exp_set)
     s1 += one_day ;
-    tmp_exp_set.push_back(one_day) ;
-  }
-  
-  gsl_integration_workspace_free(w);
 
-  Zaki::Math::Range<double> t_range  = { 0 , t_2.UnixTDay()-t_1.UnixTDay()} ;
-  int bin_num   = static_cast<int> (t_2.UnixTDay()-t_1.UnixTDay()) ;
+  // Whole days, as many as evaluated (a partial last day counts)
+  int bin_num   = static_cast<int> (std::ceil(span)) ;
+  Zaki::Math::Range<double> t_range  = { 0 , static_cast<double>(bin_num)} ;
 
   TH1F tmp_exp_hist(("exp_"+GetName()).c_str(), 
                     ("Exposure_"+GetName()).c_str(), 
@@ -1525,18 +1903,25 @@ void Satellite::EvaluateExposure(const Zaki::Physics::Date& t_1, const Zaki::Phy
   }
 
   exp_hist = tmp_exp_hist;
-
-  timer.Stop();
-  
-  double scale_exp = 24*3600*ExpTimeFrac(1.2e3);
-  scale_exp       *= Acceptance(1.2e3) / GetConeFOV("sr");
-  
-  sprintf(tmp_char, "--> Integration took %f seconds.", timer.RealTime() ) ;
-  Z_LOG_INFO(tmp_char) ;
-  sprintf(tmp_char, "--> Integral result =  %f. \t Total Exposure (1.2 TeV): %.5e.", s1, s1*scale_exp ) ;
-  Z_LOG_INFO(tmp_char) ;
+  SumExposure() ;
 
   set_exposure_eval_flag = true ;
+
+  return s1 ;
+}
+
+//--------------------------------------------------------------
+// The daily exposure depends on the orbit & the field of view
+std::string Satellite::OrbitSignature() const
+{
+  char tmp[500] ;
+  sprintf(tmp, "fov=%.17g inc=%.17g ecc=%.17g h=%.17g T=%.17g prec=%.17g"
+               " raan=%.17g nu=%.17g ypr=%.17g,%.17g,%.17g", 
+          ConeFOV, orbit_inclination, eccentricity, orbit_height, orbit_period,
+          precession_rate, init_right_asc_node, init_true_anomaly,
+          ypr.Yaw, ypr.Pitch, ypr.Roll) ;
+
+  return tmp ;
 }
 
 //--------------------------------------------------------------
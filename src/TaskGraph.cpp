@@ -0,0 +1,253 @@
+/*
+  TaskGraph class
+
+*/
+
+// Creating directory
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <TROOT.h>
+
+// Local headers
+#include "DMSS/TaskGraph.hpp"
+#include "DMSS/TaskPool.hpp"
+
+//==============================================================
+namespace
+{
+  /// Modification time of a file (-1 if it doesn't exist)
+  double MTime(const Zaki::String::Directory& f_name)
+  {
+    struct stat st ;
+    if (stat(f_name.Str().c_str(), &st) != 0) return -1 ;
+
+    return st.st_mtim.tv_sec + 1e-9*st.st_mtim.tv_nsec ;
+  }
+}
+
+//==============================================================
+// Constructor
+TaskGraph::TaskGraph()
+  : Prog("TaskGraph", true)
+{ }
+
+//--------------------------------------------------------------
+// Destructor
+TaskGraph::~TaskGraph() { }
+
+//--------------------------------------------------------------
+void TaskGraph::Add(Node&& in_node)
+{
+  for (auto&& n : nodes)
+    if (n.name == in_node.name)
+    {
+      Z_LOG_ERROR("Step '" + in_node.name + "' is already in the graph.") ;
+      exit(EXIT_FAILURE) ;
+    }
+
+  nodes.emplace_back(std::move(in_node)) ;
+}
+
+//--------------------------------------------------------------
+Zaki::String::Directory TaskGraph::StampFile(const Node& n) const
+{
+  std::string f_name = n.name ;
+  for (char& c : f_name)
+    if (c == ':' || c == '/' || c == ' ') c = '_' ;
+
+  return wrk_dir + "/.stamps/" + f_name + stamp_suffix + ".stamp" ;
+}
+
+//--------------------------------------------------------------
+void TaskGraph::SetStampSuffix(const std::string& suffix)
+{
+  stamp_suffix = suffix ;
+}
+
+//--------------------------------------------------------------
+// A step is up to date if it ran before with the same signature,
+//  its outputs exist, and it ran after its input files were
+//  changed and after the (non-transient) steps it depends on ran.
+bool TaskGraph::UpToDate(const size_t& i,
+                         const std::vector<std::vector<size_t>>& deps) const
+{
+  const Node& n = nodes[i] ;
+  if (n.transient) return false ;
+
+  std::ifstream stamp(StampFile(n).Str()) ;
+  if (stamp.fail()) return false ;
+
+  std::stringstream ss ;
+  ss << stamp.rdbuf() ;
+  if (ss.str() != n.signature) return false ;
+
+  for (auto&& f : n.outputs)
+    if (MTime(f) < 0) return false ;
+
+  double stamp_time = MTime(StampFile(n)) ;
+  for (auto&& f : n.inputs)
+    if (MTime(f) > stamp_time) return false ;
+
+  // The stamps of the steps it depends on, and the inputs of 
+  //  the transient steps in between
+  std::vector<size_t> upstream = deps[i] ;
+  while (!upstream.empty())
+  {
+    size_t d = upstream.back() ;
+    upstream.pop_back() ;
+
+    if (nodes[d].transient)
+    {
+      for (auto&& f : nodes[d].inputs)
+        if (MTime(f) > stamp_time) return false ;
+
+      upstream.insert(upstream.end(), deps[d].begin(), deps[d].end()) ;
+    }
+    else if (MTime(StampFile(nodes[d])) > stamp_time)
+      return false ;
+  }
+
+  return true ;
+}
+
+//--------------------------------------------------------------
+std::vector<size_t> TaskGraph::Sort(std::vector<std::vector<size_t>>& deps) const
+{
+  std::map<std::string, size_t> idx ;
+  for (size_t i = 0 ; i < nodes.size() ; ++i)
+    idx[nodes[i].name] = i ;
+
+  deps.assign(nodes.size(), {}) ;
+  std::vector<std::vector<size_t>> users(nodes.size()) ;
+  std::vector<size_t> n_deps(nodes.size(), 0) ;
+
+  for (size_t i = 0 ; i < nodes.size() ; ++i)
+    for (auto&& d : nodes[i].deps)
+    {
+      if (idx.find(d) == idx.end())
+      {
+        Z_LOG_ERROR("Step '" + nodes[i].name + "' depends on '"
+                    + d + "', which isn't in the graph.") ;
+        exit(EXIT_FAILURE) ;
+      }
+      deps[i].push_back(idx[d]) ;
+      users[idx[d]].push_back(i) ;
+      n_deps[i]++ ;
+    }
+
+  // Kahn's algorithm (keeps the insertion order among the ready steps)
+  std::vector<size_t> order ;
+  order.reserve(nodes.size()) ;
+  for (size_t i = 0 ; i < nodes.size() ; ++i)
+    if (n_deps[i] == 0) order.push_back(i) ;
+
+  for (size_t k = 0 ; k < order.size() ; ++k)
+    for (size_t u : users[order[k]])
+      if (--n_deps[u] == 0) order.push_back(u) ;
+
+  if (order.size() != nodes.size())
+  {
+    Z_LOG_ERROR("The steps have a circular dependency!") ;
+    exit(EXIT_FAILURE) ;
+  }
+
+  return order ;
+}
+
+//--------------------------------------------------------------
+void TaskGraph::Run()
+{
+  std::vector<std::vector<size_t>> deps ;
+  std::vector<size_t> order = Sort(deps) ;
+
+  // ............ Which steps should run ............
+  // A step with outputs runs if it's out of date, or anything it
+  //  depends on changed. A transient step runs if a step that
+  //  depends on it runs (or if nothing depends on it).
+  std::vector<bool> changed(nodes.size(), false) ;
+  std::vector<bool> run(nodes.size(), false) ;
+  std::vector<bool> has_users(nodes.size(), false) ;
+
+  for (size_t i : order)
+  {
+    for (size_t d : deps[i])
+    {
+      has_users[d] = true ;
+      if (changed[d]) changed[i] = true ;
+    }
+
+    if (!nodes[i].transient)
+    {
+      if (!changed[i]) changed[i] = !UpToDate(i, deps) ;
+      run[i] = changed[i] ;
+    }
+  }
+
+  for (auto it = order.rbegin() ; it != order.rend() ; ++it)
+  {
+    if (nodes[*it].transient && !has_users[*it])
+      run[*it] = true ;
+
+    if (!run[*it]) continue ;
+
+    for (size_t d : deps[*it])
+      if (nodes[d].transient) run[d] = true ;
+  }
+
+  for (size_t i : order)
+    if (!run[i])
+      Z_LOG_INFO("Step '" + nodes[i].name + "' is up to date, skipped.") ;
+  // ................................................
+
+  // ............ Creating a directory ............
+  if (mkdir((wrk_dir + "/.stamps").Str().c_str(), ACCESSPERMS) == -1)
+  {
+    Z_LOG_NOTE("Directory '"+wrk_dir.Str()+"/.stamps' wasn't created, because: "+strerror(errno)+".") ;
+  }
+  // .................................................
+
+  // Allowing concurrent histogram creation in ROOT
+  ROOT::EnableThreadSafety() ;
+
+  // ............ Running in waves ............
+  // Each wave has the steps whose dependencies are all done
+  std::vector<bool> done(nodes.size(), false) ;
+  for (size_t i = 0 ; i < nodes.size() ; ++i)
+    if (!run[i]) done[i] = true ;
+
+  while (true)
+  {
+    std::vector<size_t> wave ;
+    for (size_t i : order)
+      if (!done[i] && std::all_of(deps[i].begin(), deps[i].end(),
+                                  [&](size_t d) { return done[d] ; }))
+        wave.push_back(i) ;
+
+    if (wave.empty()) break ;
+
+    TaskPool::Get().ParallelFor(wave.size(), [&](size_t k)
+    {
+      const Node& n = nodes[wave[k]] ;
+      Z_LOG_INFO("Running step '" + n.name + "'...") ;
+      if (n.action) n.action() ;
+    }) ;
+
+    for (size_t i : wave)
+    {
+      done[i] = true ;
+      if (nodes[i].transient) continue ;
+
+      std::ofstream stamp(StampFile(nodes[i]).Str()) ;
+      stamp << nodes[i].signature ;
+    }
+  }
+  // ................................................
+}
+
+//==============================================================
@@ -0,0 +1,212 @@
+/*
+  TaskPool class
+
+*/
+
+#include <cstdlib>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+// Local headers
+#include "DMSS/TaskPool.hpp"
+
+//==============================================================
+namespace
+{
+  /// The pool & deque of the current worker thread
+  thread_local const TaskPool* t_pool = nullptr ;
+  thread_local size_t          t_idx  = 0 ;
+}
+
+//==============================================================
+TaskPool& TaskPool::Get()
+{
+  static TaskPool pool(CoreCount() - 1) ;
+  return pool ;
+}
+
+//--------------------------------------------------------------
+size_t TaskPool::CoreCount()
+{
+  if (const char* env = std::getenv("DMSS_NUM_THREADS"))
+  {
+    long n = std::strtol(env, nullptr, 10) ;
+    if (n > 0) return n ;
+  }
+
+#ifdef __linux__
+  cpu_set_t set ;
+  CPU_ZERO(&set) ;
+  if (sched_getaffinity(0, sizeof(set), &set) == 0 && CPU_COUNT(&set) > 0)
+    return CPU_COUNT(&set) ;
+#endif
+
+  unsigned n = std::thread::hardware_concurrency() ;
+  return n > 0 ? n : 1 ;
+}
+
+//--------------------------------------------------------------
+TaskPool::TaskPool(size_t n_workers)
+{
+  queues.reserve(n_workers + 1) ;
+  for (size_t i = 0 ; i < n_workers + 1 ; ++i)
+    queues.emplace_back(std::make_unique<Queue>()) ;
+
+  workers.reserve(n_workers) ;
+  for (size_t i = 0 ; i < n_workers ; ++i)
+    workers.emplace_back([this, i]() { WorkerLoop(i) ; }) ;
+}
+
+//--------------------------------------------------------------
+TaskPool::~TaskPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleep_mtx) ;
+    stop = true ;
+  }
+  cv.notify_all() ;
+  for (auto&& w : workers)
+    w.join() ;
+}
+
+//--------------------------------------------------------------
+void TaskPool::WorkerLoop(size_t idx)
+{
+  t_pool = this ;
+  t_idx  = idx ;
+
+  Task task ;
+  while (true)
+  {
+    if (TryPop(idx, task))
+    {
+      task() ;
+      task = nullptr ;
+      continue ;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mtx) ;
+    cv.wait(lock, [this](){ return stop || pending.load() > 0 ; }) ;
+    if (stop && pending.load() == 0) return ;
+  }
+}
+
+//--------------------------------------------------------------
+size_t TaskPool::Size() const
+{
+  return workers.size() + 1 ;
+}
+
+//--------------------------------------------------------------
+size_t TaskPool::QueueIdx() const
+{
+  return t_pool == this ? t_idx : workers.size() ;
+}
+
+//--------------------------------------------------------------
+void TaskPool::Push(Task&& task)
+{
+  {
+    Queue& q = *queues[QueueIdx()] ;
+    std::lock_guard<std::mutex> lock(q.mtx) ;
+    q.tasks.push_back(std::move(task)) ;
+  }
+  pending.fetch_add(1) ;
+
+  // Taking the lock, so a worker that is about to sleep sees it
+  { std::lock_guard<std::mutex> lock(sleep_mtx) ; }
+  cv.notify_one() ;
+}
+
+//--------------------------------------------------------------
+bool TaskPool::TryPop(size_t self, Task& task)
+{
+  if (pending.load() == 0) return false ;
+
+  // The own deque, newest first (keeps nested work local)
+  if (self < workers.size())
+  {
+    Queue& q = *queues[self] ;
+    std::lock_guard<std::mutex> lock(q.mtx) ;
+    if (!q.tasks.empty())
+    {
+      task = std::move(q.tasks.back()) ;
+      q.tasks.pop_back() ;
+      pending.fetch_sub(1) ;
+      return true ;
+    }
+  }
+
+  // Stealing the oldest task from the others (& the shared deque)
+  for (size_t k = 1 ; k <= queues.size() ; ++k)
+  {
+    Queue& q = *queues[(self + k) % queues.size()] ;
+    std::lock_guard<std::mutex> lock(q.mtx) ;
+    if (!q.tasks.empty())
+    {
+      task = std::move(q.tasks.front()) ;
+      q.tasks.pop_front() ;
+      pending.fetch_sub(1) ;
+      return true ;
+    }
+  }
+
+  return false ;
+}
+
+//--------------------------------------------------------------
+bool TaskPool::RunOne()
+{
+  Task task ;
+  if (!TryPop(QueueIdx(), task)) return false ;
+
+  task() ;
+  return true ;
+}
+
+//--------------------------------------------------------------
+void TaskPool::ParallelFor(size_t n, const std::function<void(size_t)>& f)
+{
+  if (n == 0) return ;
+  if (n == 1 || workers.empty())
+  {
+    for (size_t i = 0 ; i < n ; ++i)
+      f(i) ;
+    return ;
+  }
+
+  // Iterations are handed out one at a time from a shared counter
+  struct Loop
+  {
+    std::atomic<size_t> next = 0 ;
+    std::atomic<size_t> done = 0 ;
+  };
+  auto loop = std::make_shared<Loop>() ;
+
+  auto body = [loop, n, &f]()
+  {
+    size_t i ;
+    while ((i = loop->next.fetch_add(1)) < n)
+    {
+      f(i) ;
+      loop->done.fetch_add(1, std::memory_order_release) ;
+    }
+  };
+
+  // Helpers go on the caller's deque, idle workers steal them
+  size_t helpers = std::min(workers.size(), n - 1) ;
+  for (size_t i = 0 ; i < helpers ; ++i)
+    Push(body) ;
+
+  body() ;
+
+  // Helping with other queued work while the last iterations finish
+  while (loop->done.load(std::memory_order_acquire) < n)
+    if (!RunOne())
+      std::this_thread::yield() ;
+}
+//--------------------------------------------------------------
+
+//==============================================================
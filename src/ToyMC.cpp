@@ -0,0 +1,263 @@
+/*
+  ToyMC class
+
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+// Local headers
+#include "DMSS/ToyMC.hpp"
+#include "DMSS/TaskPool.hpp"
+
+//==============================================================
+namespace
+{
+  const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL ;
+
+  /// The 'splitmix64' finalizer (a bijective 64-bit mix)
+  uint64_t Mix(uint64_t z)
+  {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL ;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL ;
+    return z ^ (z >> 31) ;
+  }
+
+  /// Quantile of sorted values (linear interpolation)
+  double Quantile(const std::vector<double>& sorted, const double& p)
+  {
+    if (sorted.empty()) return std::numeric_limits<double>::quiet_NaN() ;
+
+    double pos = p*(sorted.size() - 1) ;
+    size_t i = static_cast<size_t>(pos) ;
+    if (i + 1 >= sorted.size()) return sorted.back() ;
+
+    return sorted[i] + (pos - i)*(sorted[i+1] - sorted[i]) ;
+  }
+}
+
+//==============================================================
+ToyRNG::ToyRNG(const uint64_t& in_seed, const uint64_t& stream)
+  : key(Mix(Mix(in_seed + GOLDEN_GAMMA) ^ (stream*GOLDEN_GAMMA)))
+{ }
+
+//--------------------------------------------------------------
+ToyRNG::result_type ToyRNG::operator()()
+{
+  return Mix(key + (++counter)*GOLDEN_GAMMA) ;
+}
+
+//--------------------------------------------------------------
+double ToyRNG::Uniform()
+{
+  // The top 53 bits, shifted away from 0
+  return ((*this)() >> 11) * 0x1.0p-53 + 0x1.0p-54 ;
+}
+
+//--------------------------------------------------------------
+// Multiplication method for small means, and the transformed
+//  rejection (PTRS) of W. Hormann (1993) for the large ones
+uint64_t ToyRNG::Poisson(const double& mean)
+{
+  if (mean <= 0) return 0 ;
+
+  if (mean < 10)
+  {
+    const double limit = std::exp(-mean) ;
+    double prod = Uniform() ;
+    uint64_t k = 0 ;
+    while (prod > limit)
+    {
+      prod *= Uniform() ;
+      ++k ;
+    }
+    return k ;
+  }
+
+  const double slam      = std::sqrt(mean) ;
+  const double loglam    = std::log(mean) ;
+  const double b         = 0.931 + 2.53*slam ;
+  const double a         = -0.059 + 0.02483*b ;
+  const double inv_alpha = 1.1239 + 1.1328/(b - 3.4) ;
+  const double vr        = 0.9277 - 3.6224/(b - 2) ;
+
+  while (true)
+  {
+    double u  = Uniform() - 0.5 ;
+    double v  = Uniform() ;
+    double us = 0.5 - std::abs(u) ;
+    double k  = std::floor((2*a/us + b)*u + mean + 0.43) ;
+
+    if (us >= 0.07 && v <= vr)
+      return static_cast<uint64_t>(k) ;
+
+    if (k < 0 || (us < 0.013 && v > us))
+      continue ;
+
+    if (std::log(v) + std::log(inv_alpha) - std::log(a/(us*us) + b)
+        <= -mean + k*loglam - std::lgamma(k + 1))
+      return static_cast<uint64_t>(k) ;
+  }
+}
+
+//==============================================================
+// Constructor
+ToyMC::ToyMC(const uint64_t& in_seed, const std::vector<std::string>& in_stat_names)
+  : Prog("ToyMC", true), seed(in_seed), stat_names(in_stat_names)
+{ }
+
+//--------------------------------------------------------------
+// Destructor
+ToyMC::~ToyMC() { }
+
+//--------------------------------------------------------------
+void ToyMC::Run(const size_t& n_toys, const std::function<Toy()>& make_toy,
+                const size_t& first)
+{
+  const size_t n_stats = stat_names.size() ;
+  const size_t offset  = toy_ids.size() ;
+
+  vals.resize((offset + n_toys)*n_stats, std::numeric_limits<double>::quiet_NaN()) ;
+  for (size_t t = 0 ; t < n_toys ; ++t)
+    toy_ids.push_back(first + t) ;
+
+  char tmp[200] ;
+  sprintf(tmp, "Running %zu toys (seed: %llu) ...", n_toys, (unsigned long long)seed) ;
+  Z_LOG_INFO(tmp) ;
+
+  // The workspace of a toy is reused by the toys of its chunk
+  const size_t chunk = std::max<size_t>(1, n_toys / (4*TaskPool::Get().Size())) ;
+  TaskPool::Get().ParallelFor((n_toys + chunk - 1) / chunk, [&](size_t c)
+  {
+    Toy toy = make_toy() ;
+    std::vector<double> stats ;
+
+    for (size_t t = c*chunk ; t < std::min(n_toys, (c+1)*chunk) ; ++t)
+    {
+      ToyRNG rng(seed, first + t) ;
+      stats.assign(n_stats, std::numeric_limits<double>::quiet_NaN()) ;
+
+      toy(rng, stats) ;
+
+      std::copy_n(stats.begin(), n_stats, vals.begin() + (offset + t)*n_stats) ;
+    }
+  }) ;
+}
+
+//--------------------------------------------------------------
+size_t ToyMC::Size() const
+{
+  return toy_ids.size() ;
+}
+
+//--------------------------------------------------------------
+std::vector<double> ToyMC::GetValues(const size_t& stat_idx) const
+{
+  std::vector<double> out ;
+  out.reserve(toy_ids.size()) ;
+
+  for (size_t t = 0 ; t < toy_ids.size() ; ++t)
+    out.push_back(vals[t*stat_names.size() + stat_idx]) ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+ToyStat ToyMC::GetStat(const size_t& stat_idx) const
+{
+  ToyStat out ;
+
+  std::vector<double> sorted ;
+  sorted.reserve(toy_ids.size()) ;
+  for (const double v : GetValues(stat_idx))
+  {
+    if (std::isnan(v))
+      out.n_failed++ ;
+    else
+      sorted.push_back(v) ;
+  }
+
+  out.n = sorted.size() ;
+  if (sorted.empty())
+  {
+    out.mean = out.std_dev = out.min = out.max = std::numeric_limits<double>::quiet_NaN() ;
+    out.band.fill(out.mean) ;
+    return out ;
+  }
+
+  // Welford's update, in the toy order
+  double m2 = 0 ;
+  for (size_t i = 0 ; i < sorted.size() ; ++i)
+  {
+    double delta = sorted[i] - out.mean ;
+    out.mean += delta / (i + 1) ;
+    m2       += delta * (sorted[i] - out.mean) ;
+  }
+  out.std_dev = sorted.size() > 1 ? std::sqrt(m2 / (sorted.size() - 1)) : 0 ;
+
+  std::sort(sorted.begin(), sorted.end()) ;
+  out.min = sorted.front() ;
+  out.max = sorted.back() ;
+
+  // Gaussian probabilities of -2, -1, 0, +1, +2 sigma
+  const std::array<double, 5> probs = {0.02275013, 0.15865525, 0.5,
+                                       0.84134475, 0.97724987} ;
+  for (size_t i = 0 ; i < probs.size() ; ++i)
+    out.band[i] = Quantile(sorted, probs[i]) ;
+
+  return out ;
+}
+
+//--------------------------------------------------------------
+void ToyMC::ExportSummary(const Zaki::String::Directory& f_name) const
+{
+  FILE* out = fopen(f_name.Str().c_str(), "w") ;
+  if (!out)
+  {
+    Z_LOG_ERROR("Toy summary file '" + f_name.Str() + "' cannot be opened!") ;
+    return ;
+  }
+
+  fprintf(out, "# stat\tn\tfailed\tmean\tstd_dev\tmin\t-2sig\t-1sig\tmedian\t+1sig\t+2sig\tmax\n") ;
+  for (size_t s = 0 ; s < stat_names.size() ; ++s)
+  {
+    ToyStat st = GetStat(s) ;
+    fprintf(out, "%s\t%zu\t%zu\t%.9g\t%.9g\t%.9g\t%.9g\t%.9g\t%.9g\t%.9g\t%.9g\t%.9g\n",
+            stat_names[s].c_str(), st.n, st.n_failed, st.mean, st.std_dev, st.min,
+            st.band[0], st.band[1], st.band[2], st.band[3], st.band[4], st.max) ;
+  }
+  fclose(out) ;
+
+  Z_LOG_INFO("Toy summary exported to '" + f_name.Str() + "'.") ;
+}
+
+//--------------------------------------------------------------
+void ToyMC::ExportToys(const Zaki::String::Directory& f_name) const
+{
+  FILE* out = fopen(f_name.Str().c_str(), "w") ;
+  if (!out)
+  {
+    Z_LOG_ERROR("Toy file '" + f_name.Str() + "' cannot be opened!") ;
+    return ;
+  }
+
+  fprintf(out, "# toy") ;
+  for (const std::string& name : stat_names)
+    fprintf(out, "\t%s", name.c_str()) ;
+  fprintf(out, "\n") ;
+
+  for (size_t t = 0 ; t < toy_ids.size() ; ++t)
+  {
+    fprintf(out, "%zu", toy_ids[t]) ;
+    for (size_t s = 0 ; s < stat_names.size() ; ++s)
+      fprintf(out, "\t%.9g", vals[t*stat_names.size() + s]) ;
+    fprintf(out, "\n") ;
+  }
+  fclose(out) ;
+
+  Z_LOG_INFO("Toys exported to '" + f_name.Str() + "'.") ;
+}
+
+//==============================================================